@@ -0,0 +1,376 @@
+// bench_main.cpp - Microbenchmarks for the rules engine hot paths
+// Anksilae@gmail.com
+//
+// Usage: ./build/bench [filter] [--min-time <ms>] [--csv <file>]
+//
+// Every benchmark reports ns/op, heap allocations/op and ops/s. The game's console
+// logging is redirected to a null stream while measuring, so the numbers include the
+// formatting work but not the terminal.
+
+#define ALLOC_COUNTER_IMPLEMENT
+#include "AllocCounter.hpp"
+#include "BatchSim.hpp"
+#include "Game.hpp"
+#include "GameArena.hpp"
+#include "Player.hpp"
+#include "Bot.hpp"
+#include "Governor.hpp"
+#include "Spy.hpp"
+#include "Judge.hpp"
+#include "Baron.hpp"
+#include "General.hpp"
+#include "Merchant.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace coup;
+using Clock = std::chrono::steady_clock;
+
+/// Smallest ns/op reported: an operation cheaper than the clock overhead it is measured with
+/// comes out at (or below) zero once that overhead is subtracted, and is shown at this floor.
+constexpr double MIN_NS_PER_OP = 0.1;
+
+/**
+ * @brief Keeps a value alive so the optimizer cannot drop the code computing it.
+ */
+template <typename T>
+void keep(const T &value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/**
+ * @brief Stream buffer that discards everything written to it.
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+};
+
+// ======================
+// Harness
+// ======================
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations = 0;
+    double ns_per_op = 0;
+    double allocs_per_op = 0;
+    double ops_per_sec = 0;
+};
+
+/**
+ * @brief Minimal benchmark runner.
+ *
+ * Each iteration runs an untimed setup step and then the timed operation, so actions
+ * that change the game (coup, sanction, ...) can be measured from the same state every time.
+ * The cost of reading the clock is measured once and subtracted, down to MIN_NS_PER_OP.
+ */
+class Bench {
+public:
+    Bench(std::string filter, double min_time_ms)
+        : filter(std::move(filter)), min_time(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(min_time_ms))) {
+        timer_overhead_ns = measure([] {}, [] {}, 100000).ns_per_op;
+    }
+
+    template <typename Setup, typename Op>
+    void run(const std::string &name, Setup setup, Op op) {
+        if (!filter.empty() && name.find(filter) == std::string::npos)
+            return;
+
+        measure(setup, op, 10); // warm-up
+        BenchResult r = measure(setup, op, 0);
+        r.name = name;
+        r.ns_per_op = std::max(MIN_NS_PER_OP, r.ns_per_op - timer_overhead_ns);
+        r.ops_per_sec = 1e9 / r.ns_per_op;
+        results.push_back(r);
+        print(r);
+    }
+
+    template <typename Op>
+    void run(const std::string &name, Op op) {
+        run(name, [] {}, op);
+    }
+
+    const std::vector<BenchResult> &all() const { return results; }
+
+private:
+    std::string filter;
+    Clock::duration min_time;
+    double timer_overhead_ns = 0;
+    std::vector<BenchResult> results;
+
+    /**
+     * @brief Runs `count` iterations, or until the minimum time has passed if count is 0.
+     */
+    template <typename Setup, typename Op>
+    BenchResult measure(Setup setup, Op op, uint64_t count) {
+        Clock::duration timed{0};
+        uint64_t allocs = 0;
+        uint64_t n = 0;
+        const auto start = Clock::now();
+
+        while (count ? n < count : (Clock::now() - start < min_time || n < 10)) {
+            setup();
+            const uint64_t a0 = alloc_counter::allocations();
+            const auto t0 = Clock::now();
+            op();
+            const auto t1 = Clock::now();
+            allocs += alloc_counter::allocations() - a0;
+            timed += t1 - t0;
+            ++n;
+        }
+
+        BenchResult r;
+        r.iterations = n;
+        r.ns_per_op = std::chrono::duration<double, std::nano>(timed).count() / n;
+        r.allocs_per_op = static_cast<double>(allocs) / n;
+        return r;
+    }
+
+    static void print(const BenchResult &r) {
+        std::fprintf(stdout, "%-36s %12llu %12.1f %12.2f %14.0f\n", r.name.c_str(),
+                     static_cast<unsigned long long>(r.iterations), r.ns_per_op, r.allocs_per_op, r.ops_per_sec);
+    }
+};
+
+// ======================
+// Fixtures
+// ======================
+
+const char *const ROLES[] = {"Governor", "Spy", "Judge", "Baron", "General", "Merchant"};
+
+/**
+ * @brief Adds one player of each role: Player0 (Governor) ... Player5 (Merchant).
+ */
+std::vector<Player *> seat_players(Game &game) {
+    std::vector<Player *> players;
+    players.reserve(6);
+    for (int i = 0; i < 6; ++i)
+        players.push_back(game.add_player("Player" + std::to_string(i), ROLES[i]));
+    return players;
+}
+
+/**
+ * @brief Plays one game of six random bots to the end; returns the number of turns.
+ */
+int random_playout(Game &game, unsigned seed) {
+    seat_players(game);
+    std::vector<Bot> bots;
+    for (int i = 0; i < 6; ++i)
+        bots.emplace_back(BotStrength::Random, seed * 6 + i);
+
+    int turns = 0;
+    while (!game.is_game_over() && turns < 5000) {
+        int index = game.get_current_turn_index();
+        bots[index].play_turn(game, game.turn());
+        ++turns;
+    }
+    return turns;
+}
+
+// ======================
+// Benchmarks
+// ======================
+
+void bench_game(Bench &bench) {
+    Game game;
+    auto players = seat_players(game);
+
+    bench.run("Game::next_turn", [&] { game.next_turn(); });
+    bench.run("Game::perform_action", [&] { game.perform_action("gather", "Player0"); });
+    bench.run("Game::perform_action (target)", [&] { game.perform_action("arrest", "Player0", "Player1"); });
+    bench.run("Game::get_player_by_name", [&] { keep(game.get_player_by_name("Player5")); });
+    bench.run("Game::players", [&] { keep(game.players()); });
+    bench.run("Game::turn", [&] { keep(game.turn()); });
+    bench.run("Game::can_still_undo", [&] { keep(game.can_still_undo(game.turn_id())); });
+    bench.run("Game::used_this_round", [&] { keep(game.used_this_round(Game::RoundAbility::UndoTax)); });
+}
+
+void bench_actions(Bench &bench) {
+    Game game;
+    auto p = seat_players(game);
+    auto at_turn = [&](int index, int coins) {
+        game.set_current_turn_index(index);
+        p[index]->set_coins(coins);
+    };
+
+    bench.run("Player::gather", [&] { at_turn(1, 0); }, [&] { p[1]->gather(); });
+    bench.run("Player::tax", [&] { at_turn(1, 0); }, [&] { p[1]->tax(); });
+    bench.run("Governor::tax", [&] { at_turn(0, 0); }, [&] { p[0]->tax(); });
+    bench.run("Player::bribe", [&] { at_turn(1, 4); }, [&] { p[1]->bribe(); });
+    bench.run("Player::arrest",
+              [&] {
+                  at_turn(1, 0);
+                  p[2]->set_coins(1);
+                  game.set_last_arrest_target("");
+              },
+              [&] { p[1]->arrest(*p[2]); });
+    bench.run("Player::sanction",
+              [&] {
+                  at_turn(1, 3);
+                  p[3]->unsanction();
+              },
+              [&] { p[1]->sanction(*p[3]); });
+    bench.run("Player::coup",
+              [&] {
+                  if (game.is_coup_pending_on("Player5"))
+                      game.cancel_coup("Player5");
+                  at_turn(1, 7);
+              },
+              [&] { p[1]->coup(*p[5]); });
+    if (game.is_coup_pending_on("Player5"))
+        game.cancel_coup("Player5");
+}
+
+void bench_abilities(Bench &bench) {
+    Game game;
+    auto p = seat_players(game);
+    auto &governor = static_cast<Governor &>(*p[0]);
+    auto &spy = static_cast<Spy &>(*p[1]);
+    auto &judge = static_cast<Judge &>(*p[2]);
+    auto &baron = static_cast<Baron &>(*p[3]);
+    auto &general = static_cast<General &>(*p[4]);
+    auto &merchant = static_cast<Merchant &>(*p[5]);
+
+    bench.run("Governor::undo_tax",
+              [&] {
+                  game.perform_action("tax", "Player1");
+                  p[1]->set_coins(2);
+                  game.clear_used(Game::RoundAbility::UndoTax);
+              },
+              [&] { governor.undo_tax(*p[1]); });
+    bench.run("Spy::peek_and_disable",
+              [&] {
+                  game.set_current_turn_index(1);
+                  p[3]->enable_arrest();
+                  game.clear_used(Game::RoundAbility::PeekDisable);
+              },
+              [&] { spy.peek_and_disable(*p[3]); });
+    bench.run("Judge::undo_bribe",
+              [&] {
+                  game.set_current_turn_index(2);
+                  game.perform_action("bribe", "Player1");
+                  game.clear_used(Game::RoundAbility::UndoBribe);
+              },
+              [&] { judge.undo_bribe(*p[1]); });
+    bench.run("Baron::invest",
+              [&] {
+                  game.set_current_turn_index(3);
+                  baron.set_coins(3);
+              },
+              [&] { baron.invest(); });
+    bench.run("General::undo_coup",
+              [&] {
+                  game.remove_player("Player5");
+                  game.add_to_coup("Player1", "Player5");
+                  general.set_coins(5);
+                  game.clear_used(Game::RoundAbility::UndoCoup);
+              },
+              [&] { general.undo_coup(*p[5]); });
+    bench.run("Merchant::on_turn_start", [&] { merchant.set_coins(3); }, [&] { merchant.on_turn_start(); });
+}
+
+void bench_lifecycle(Bench &bench) {
+    GameArena &arena = GameArena::this_thread();
+
+    bench.run("Game construction (6 players)", [] {
+        Game game;
+        seat_players(game);
+    });
+    bench.run("Game construction (arena)", [&] {
+        Game game(arena);
+        seat_players(game);
+    });
+
+    {
+        Game game;
+        bench.run("Game::reset (6 players)", [&] { seat_players(game); }, [&] { game.reset(); });
+    }
+    {
+        Game game(arena);
+        bench.run("Game::reset (arena)", [&] { seat_players(game); }, [&] { game.reset(); });
+    }
+
+    unsigned seed = 0;
+    uint64_t turns = 0;
+    uint64_t games = 0;
+    bench.run("Playout (6 random bots)", [&] {
+        Game game;
+        turns += random_playout(game, ++seed);
+        ++games;
+    });
+    if (games > 0)
+        std::fprintf(stdout, "%-36s %12.1f turns/game\n", "", static_cast<double>(turns) / games);
+    bench.run("Playout (arena)", [&] {
+        Game game(arena);
+        random_playout(game, ++seed);
+    });
+}
+
+void bench_batch(Bench &bench) {
+    const std::vector<std::string> roles(ROLES, ROLES + 6);
+    const size_t games = 4096;
+    BatchSim sim(roles);
+
+    uint32_t seed = 0;
+    bench.run("BatchSim::play_scalar (1 game)", [&] { keep(sim.play_scalar(++seed)); });
+    const size_t before = bench.all().size();
+    bench.run("BatchSim::run (4096 games)", [&] {
+        keep(sim.run(seed, games));
+        seed += games;
+    });
+    if (bench.all().size() > before)
+        std::fprintf(stdout, "%-36s %12.1f ns/game\n", "", bench.all().back().ns_per_op / games);
+}
+
+void write_csv(const std::string &path, const std::vector<BenchResult> &results) {
+    std::ofstream out(path);
+    out << "name,iterations,ns_per_op,allocs_per_op,ops_per_sec\n";
+    for (const auto &r : results)
+        out << '"' << r.name << "\"," << r.iterations << ',' << r.ns_per_op << ',' << r.allocs_per_op << ','
+            << r.ops_per_sec << '\n';
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::string filter;
+    std::string csv_path;
+    double min_time_ms = 200;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--csv" && i + 1 < argc)
+            csv_path = argv[++i];
+        else if (arg == "--min-time" && i + 1 < argc)
+            min_time_ms = std::atof(argv[++i]);
+        else
+            filter = arg;
+    }
+
+    NullBuffer null_buffer;
+    std::streambuf *console = std::cout.rdbuf(&null_buffer);
+
+    std::fprintf(stdout, "%-36s %12s %12s %12s %14s\n", "benchmark", "iterations", "ns/op", "allocs/op", "ops/s");
+    Bench bench(filter, min_time_ms);
+    bench_game(bench);
+    bench_actions(bench);
+    bench_abilities(bench);
+    bench_lifecycle(bench);
+    bench_batch(bench);
+
+    std::cout.rdbuf(console);
+    if (!csv_path.empty())
+        write_csv(csv_path, bench.all());
+    return 0;
+}
@@ -0,0 +1,121 @@
+// fuzz_actions.cpp - libFuzzer / AFL entry point for ActionFuzzer
+// Anksilae@gmail.com
+//
+// libFuzzer:  make fuzz-libfuzzer && ./build/fuzz_actions_libfuzzer corpus/
+// AFL++:      make build/fuzz_actions CXX=afl-clang-fast++ TOOL_MODE=profile
+//             afl-fuzz -i seeds -o findings -- ./build/fuzz_actions
+// Standalone: ./build/fuzz_actions file ...        replays inputs (e.g. a crash found above)
+//             ./build/fuzz_actions --random <n>    plays n random inputs and reports execs/s
+//
+// A broken invariant is printed with the input's bytes and aborts, which both fuzzers
+// report as a crash. Built with AFL's compiler, the standalone mode runs AFL's persistent
+// loop on stdin.
+
+#include "ActionFuzzer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace coup;
+
+ActionFuzzer &fuzzer() {
+    static ActionFuzzer *instance = new ActionFuzzer();
+    return *instance;
+}
+
+FuzzStats play(const uint8_t *data, size_t size) {
+    std::string broken;
+    FuzzStats stats = fuzzer().run(data, size, broken);
+    if (!broken.empty()) {
+        std::fprintf(stderr, "fuzz_actions: invariant broken after step %zu: %s\ninput:", stats.steps, broken.c_str());
+        for (size_t i = 0; i < size; ++i)
+            std::fprintf(stderr, " %02x", data[i]);
+        std::fprintf(stderr, "\n");
+        std::abort();
+    }
+    return stats;
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    play(data, size);
+    return 0;
+}
+
+#ifndef COUP_LIBFUZZER
+
+namespace {
+
+std::vector<uint8_t> read_all(std::istream &in) {
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief Plays `count` random inputs of 1 to 512 bytes and reports the rate.
+ */
+int run_random(size_t count) {
+    std::mt19937 rng(1);
+    std::vector<uint8_t> input;
+    size_t steps = 0, rejected = 0, finished = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        input.resize(1 + rng() % 512);
+        for (uint8_t &byte : input)
+            byte = static_cast<uint8_t>(rng());
+        FuzzStats stats = play(input.data(), input.size());
+        steps += stats.steps;
+        rejected += stats.rejected;
+        finished += stats.finished;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(stderr,
+                 "fuzz_actions: %zu inputs, %zu steps (%zu rejected), %zu games finished in %.2fs "
+                 "(%.0f execs/s, %.0f steps/s)\n",
+                 count, steps, rejected, finished, seconds, count / seconds, steps / seconds);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc == 3 && std::string(argv[1]) == "--random")
+        return run_random(std::strtoul(argv[2], nullptr, 10));
+
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            std::ifstream in(argv[i], std::ios::binary);
+            if (!in) {
+                std::fprintf(stderr, "fuzz_actions: cannot read %s\n", argv[i]);
+                return 2;
+            }
+            std::vector<uint8_t> input = read_all(in);
+            FuzzStats stats = play(input.data(), input.size());
+            std::fprintf(stderr, "%s: %zu steps, %zu rejected%s\n", argv[i], stats.steps, stats.rejected,
+                         stats.finished ? ", game over" : "");
+        }
+        return 0;
+    }
+
+#ifdef __AFL_HAVE_MANUAL_CONTROL
+    while (__AFL_LOOP(100000)) {
+        std::vector<uint8_t> input = read_all(std::cin);
+        std::cin.clear();
+        play(input.data(), input.size());
+    }
+#else
+    std::vector<uint8_t> input = read_all(std::cin);
+    play(input.data(), input.size());
+#endif
+    return 0;
+}
+
+#endif // COUP_LIBFUZZER
@@ -0,0 +1,81 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Game.hpp"
+#include "GameArena.hpp"
+
+namespace coup {
+
+/**
+ * @brief Checks the invariants every reachable game state must keep.
+ *
+ * - no player has negative coins;
+ * - while the game runs, exactly one player is in turn and that player is alive;
+ * - the game is over if and only if exactly one player is alive;
+ * - every pending coup targets an eliminated player.
+ *
+ * @return A description of the first broken invariant, or "" if they all hold.
+ */
+std::string check_invariants(const Game &game);
+
+/**
+ * @brief Counts of one ActionFuzzer::run.
+ */
+struct FuzzStats {
+    size_t steps = 0;    ///< Actions and reactions attempted
+    size_t rejected = 0; ///< Attempts Player::check refused (played or not)
+    bool finished = false;
+};
+
+/**
+ * @brief Plays byte streams as games for libFuzzer / AFL, checking the invariants after every step.
+ *
+ * The first byte picks 2 to 6 players, the next ones their roles. Every following pair of
+ * bytes is one step:
+ *
+ *     op  = bits 0-3: gather, tax, bribe, invest, arrest, sanction, coup, skip,
+ *                     undo_tax, undo_bribe, undo_coup, peek, then tax, coup, gather, arrest again
+ *           bit 4:    turn actions come from the seat in bits 5-7 instead of the player in turn
+ *           bits 5-7: seat of the reacting player (reactions always use it)
+ *     arg = the target's seat
+ *
+ * Seats are taken modulo the player count, so every stream decodes to a game. Each step is
+ * first checked with Player::check, the game's own non-throwing validation, and played
+ * through the regular Player and role API when it passes; an accepted step that throws
+ * anyway is a broken invariant. Refused steps are not played (throwing costs about as much
+ * as an action), except when bits 5-7 of `arg` are all set: then the action must throw the
+ * exception class check() named. Any exception other than a CoupException escapes.
+ *
+ * One arena-backed, quiet Game (GameLog::Quiet) is reset for every
+ * input, so a step costs little more than the action itself.
+ */
+class ActionFuzzer {
+public:
+    static constexpr size_t MAX_SEATS = MAX_PLAYERS < 6 ? MAX_PLAYERS : 6;
+
+    ActionFuzzer();
+
+    ActionFuzzer(const ActionFuzzer &) = delete;
+    ActionFuzzer &operator=(const ActionFuzzer &) = delete;
+
+    /**
+     * @brief Plays one input.
+     * @return The counts of the run, and in `broken` the first broken invariant ("" if none).
+     */
+    FuzzStats run(const uint8_t *data, size_t size, std::string &broken);
+
+    const Game &game() const { return current; }
+
+private:
+    bool step(uint8_t op, uint8_t arg, std::string &broken); ///< Plays one step; false if refused
+    void perform(uint8_t kind, Player &actor, Player &target);
+
+    GameArena arena;
+    Game current;
+};
+
+} // namespace coup
@@ -0,0 +1,104 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <cstdint>
+
+namespace coup {
+
+/**
+ * @brief Heap allocation counters for tests and benchmarks.
+ *
+ * The counting global operator new/delete are defined by the one source file of a
+ * binary that includes this header with ALLOC_COUNTER_IMPLEMENT defined (like doctest's
+ * DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN). Counts are kept per thread.
+ */
+namespace alloc_counter {
+
+uint64_t allocations();   ///< Allocations made by the calling thread so far
+uint64_t deallocations(); ///< Deallocations made by the calling thread so far
+
+} // namespace alloc_counter
+
+/**
+ * @brief Counts the calling thread's heap allocations from its construction on.
+ */
+class AllocScope {
+public:
+    AllocScope() : start_new(alloc_counter::allocations()), start_delete(alloc_counter::deallocations()) {}
+
+    uint64_t allocations() const { return alloc_counter::allocations() - start_new; }
+    uint64_t deallocations() const { return alloc_counter::deallocations() - start_delete; }
+
+private:
+    uint64_t start_new;
+    uint64_t start_delete;
+};
+
+/**
+ * @brief Runs `fn` and returns how many heap allocations it made on this thread.
+ */
+template <typename Fn>
+uint64_t count_allocations(Fn &&fn) {
+    AllocScope scope;
+    fn();
+    return scope.allocations();
+}
+
+} // namespace coup
+
+#ifdef ALLOC_COUNTER_IMPLEMENT
+
+#include <cstdlib>
+#include <new>
+
+namespace coup {
+namespace alloc_counter {
+
+namespace {
+thread_local uint64_t new_count = 0;
+thread_local uint64_t delete_count = 0;
+} // namespace
+
+uint64_t allocations() { return new_count; }
+uint64_t deallocations() { return delete_count; }
+
+} // namespace alloc_counter
+} // namespace coup
+
+void *operator new(std::size_t size) {
+    ++coup::alloc_counter::new_count;
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    if (p)
+        ++coup::alloc_counter::delete_count;
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+// Aligned forms (std::pmr::new_delete_resource allocates through these)
+void *operator new(std::size_t size, std::align_val_t align) {
+    ++coup::alloc_counter::new_count;
+    std::size_t alignment = static_cast<std::size_t>(align);
+    std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+    if (void *p = std::aligned_alloc(alignment, rounded ? rounded : alignment))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p, std::align_val_t) noexcept {
+    operator delete(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+    operator delete(p);
+}
+
+#endif // ALLOC_COUNTER_IMPLEMENT
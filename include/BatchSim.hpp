@@ -0,0 +1,105 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "NameTable.hpp"
+#include "RulesConfig.hpp"
+
+namespace coup {
+
+/**
+ * @brief The fixed policy every seat follows in a batched simulation.
+ *
+ * Each turn the player draws one 32-bit number from its game's random stream and:
+ * coups a random opponent if it holds `coup_at` coins or more (always from the forced
+ * coup threshold on); otherwise invests if it is a Baron who can pay for it and the invest
+ * roll hits; otherwise taxes if the tax roll hits; otherwise gathers. Rolls are out of 16.
+ */
+struct BatchPolicy {
+    int coup_at = 7;       ///< Coins from which a player coups (clamped to coup_cost..forced_coup_at)
+    int tax_weight = 8;    ///< Chance out of 16 to tax instead of gather
+    int invest_weight = 6; ///< Chance out of 16 for a Baron with 3+ coins to invest
+    int max_turns = 1000;  ///< Turns after which a game is stopped undecided
+};
+
+/**
+ * @brief Result of one simulated game.
+ */
+struct BatchOutcome {
+    int winner = -1;                      ///< Seat of the winner, or -1 if stopped at max_turns
+    int turns = 0;                        ///< Turns played (actions taken)
+    std::array<int, MAX_PLAYERS> coins{}; ///< Final coins by seat
+
+    bool operator==(const BatchOutcome &other) const {
+        return winner == other.winner && turns == other.turns && coins == other.coins;
+    }
+    bool operator!=(const BatchOutcome &other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Plays many games of a BatchPolicy side by side, for balance sweeps.
+ *
+ * Games are kept in struct-of-arrays form (coins by seat, alive mask, turn, random state),
+ * LANE_WIDTH games to a block, and every block advances one turn per step: picking the
+ * move, paying gather / tax / Governor tax / Baron invest, the forced coup threshold,
+ * moving the turn and the Merchant's turn-start bonus are branch-free operations on whole
+ * lanes. Coups and game ends are rare and handled lane by lane; a lane whose game ends
+ * starts the next pending game at once, so blocks stay full.
+ *
+ * The outcome of each game is identical to playing the same seed through the rules
+ * engine with play_scalar(). The lane arithmetic uses GCC vector extensions sized to one
+ * register: 8 x 32-bit lanes when built with AVX2 (ARCH_FLAGS=-mavx2 in the Makefile),
+ * 4 lanes of SSE2 / NEON otherwise.
+ */
+class BatchSim {
+public:
+#ifdef __AVX2__
+    static constexpr size_t LANE_WIDTH = 8; ///< Games per block: 32-bit lanes of one AVX2 register
+#else
+    static constexpr size_t LANE_WIDTH = 4; ///< Games per block: 32-bit lanes of one SSE / NEON register
+#endif
+    static constexpr size_t MAX_SEATS = MAX_PLAYERS < 32 ? MAX_PLAYERS : 32; ///< Alive masks are 32-bit per lane
+
+    /**
+     * @brief Prepares a simulation of games seated with `roles` (seat order).
+     * @param roles Role names as accepted by Game::add_player, 2 to MAX_SEATS of them.
+     * @param policy Policy followed by every seat.
+     * @param games_in_flight Games played side by side (rounded up to whole blocks).
+     * @param rules Costs and thresholds of the games.
+     * @throws InvalidActionException for an unknown role, a bad seat count or invalid rules.
+     */
+    BatchSim(std::vector<std::string> roles, BatchPolicy policy = {}, size_t games_in_flight = 256,
+             const RulesConfig &rules = RulesConfig());
+
+    /**
+     * @brief Plays `count` games; game i uses seed `first_seed + i` and is returned at index i.
+     */
+    std::vector<BatchOutcome> run(uint32_t first_seed, size_t count) const;
+
+    /**
+     * @brief Plays one game through Game and the Player API, making the same choices as run().
+     *
+     * This is the reference run() must match; it is much slower (and logs every action).
+     */
+    BatchOutcome play_scalar(uint32_t seed) const;
+
+    const std::vector<std::string> &roles() const { return seat_roles; }
+    const BatchPolicy &policy() const { return seat_policy; }
+    const RulesConfig &rules() const { return game_rules; }
+
+private:
+    std::vector<std::string> seat_roles;
+    BatchPolicy seat_policy;
+    RulesConfig game_rules;
+    size_t blocks;          ///< Blocks of LANE_WIDTH games in flight
+    uint32_t governors = 0; ///< Seats whose tax pays 3, as a bit mask
+    uint32_t barons = 0;    ///< Seats that may invest
+    uint32_t merchants = 0; ///< Seats that get the turn-start bonus
+};
+
+} // namespace coup
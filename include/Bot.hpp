@@ -0,0 +1,108 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace coup {
+
+class Game;
+class Player;
+
+/**
+ * @brief How a Bot picks its moves.
+ */
+enum class BotStrength {
+    Random,  // Uniformly random among the moves that look legal
+    Greedy,  // Best immediate coin/elimination gain
+    Search   // Monte Carlo rollouts on a simplified model, within a time budget
+};
+
+/**
+ * @brief Returns the display name of a strength ("Random", "Greedy", "Search").
+ */
+std::string to_string(BotStrength strength);
+
+/**
+ * @brief A turn-ending action a bot can take.
+ *
+ * Bribe is never chosen: it only spends coins for an extra action.
+ */
+struct BotMove {
+    enum class Type { Gather, Tax, Invest, Arrest, Sanction, Coup, Skip };
+
+    Type type = Type::Skip;
+    std::string target;  ///< Target name for Arrest / Sanction / Coup
+
+    /**
+     * @brief Returns a short description such as "coup bob".
+     */
+    std::string describe() const;
+};
+
+/**
+ * @brief Computer-controlled player policy.
+ *
+ * A Bot does not own a Player; it chooses and performs moves for a named player of a Game.
+ * It keeps its own random generator, so a seeded bot replays the same decisions
+ * (except Search, whose amount of work depends on the time budget).
+ */
+class Bot {
+public:
+    /**
+     * @brief Creates a bot.
+     * @param strength Decision policy.
+     * @param seed Seed of the bot's random generator.
+     * @param think_budget_ms Time budget per move for BotStrength::Search.
+     */
+    Bot(BotStrength strength, unsigned seed, int think_budget_ms = 200);
+
+    BotStrength strength() const { return level; }
+
+    /**
+     * @brief Lists the turn-ending moves that pass the rules' cheap pre-checks.
+     *
+     * A forced coup (RulesConfig::forced_coup_at coins) leaves only coups. Checks that depend on hidden
+     * details are left to the action itself, so a listed move may still be rejected.
+     */
+    static std::vector<BotMove> candidates(const Game &game, const Player &self);
+
+    /**
+     * @brief Chooses a move for the player in turn.
+     *
+     * The same move is not chosen more than max_repeats times in a row when another
+     * candidate exists, so two bots cannot trade arrests forever.
+     */
+    BotMove choose(const Game &game, const Player &self);
+
+    /**
+     * @brief Performs one move through the regular Player API.
+     * @throws Whatever the action throws if the move is illegal.
+     */
+    static void apply(Game &game, Player &self, const BotMove &move);
+
+    /**
+     * @brief Plays the named player's turn: chooses a move and performs it,
+     * falling back to the remaining candidates if the game rejects it.
+     *
+     * @throws NotYourTurnException if it is not this player's turn.
+     * @throws The last rejection if no candidate move was accepted.
+     */
+    void play_turn(Game &game, const std::string &name);
+
+private:
+    static constexpr int max_repeats = 3;
+
+    BotStrength level;
+    int budget_ms;
+    std::mt19937 rng;
+    BotMove last_move;
+    int repeats = 0;
+
+    BotMove choose_greedy(const Game &game, const Player &self, const std::vector<BotMove> &moves);
+    BotMove choose_search(const Game &game, const Player &self, const std::vector<BotMove> &moves);
+};
+
+} // namespace coup
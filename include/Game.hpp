@@ -2,58 +2,240 @@
 
 #pragma once
 
+#include <array>
+#include <climits>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
-#include <unordered_set>
+#include <memory_resource>
 #include <unordered_map>
 #include <optional>
+#include <variant>
 #include "Player.hpp"
+#include "Governor.hpp"
+#include "Spy.hpp"
+#include "Judge.hpp"
+#include "Baron.hpp"
+#include "General.hpp"
+#include "Merchant.hpp"
+#include "GameArena.hpp"
+#include "NameTable.hpp"
+#include "RulesConfig.hpp"
+#include "SeatFlags.hpp"
 
 namespace coup {
 
+/**
+ * @brief Storage for one player created by role: the role object itself, held by value.
+ */
+using RoleSlot = std::variant<Governor, Spy, Judge, Baron, General, Merchant>;
+
+/**
+ * @brief Action name ("tax", "coup", ...) stored inline, so recording an action never allocates.
+ */
+class ActionName {
+public:
+    static constexpr size_t CAPACITY = 31; ///< Longest name that can be recorded
+
+    /**
+     * @brief Replaces the stored name.
+     * @throws InvalidActionException if `text` is longer than CAPACITY.
+     */
+    void assign(std::string_view text);
+
+    void clear() { length = 0; }
+    std::string_view view() const { return std::string_view(text, length); }
+
+private:
+    char text[CAPACITY];
+    unsigned char length = 0;
+};
+
+/**
+ * @brief Whether a game prints its log to std::cout, chosen when it is built.
+ */
+enum class GameLog {
+    Printed, ///< Every event is printed as it happens (the default)
+    Quiet    ///< Nothing is printed; the last-action text is still recorded
+};
+
 /**
  * @brief Core game logic for managing players, turns, actions, coup system, and undo logic.
  * 
  * This class is responsible for tracking game state, validating actions,
  * managing turn order, and logging activity for UI integration and role effects.
+ *
+ * Players created by role are owned by the game and stored by value, side by side in
+ * seat order; the game hands out non-owning Player pointers, which stay valid until
+ * reset() or destruction.
+ *
+ * The players' status flags are kept here as one bit mask per flag (SeatFlags), so
+ * counting alive players or finding the next one is a single bit operation.
+ *
+ * Each player's name is interned once, when the player joins, and all internal bookkeeping
+ * lives in fixed arrays of MAX_PLAYERS entries indexed by the resulting PlayerId. The name-based
+ * functions look their arguments up at the edge (a name that is not a player is rejected, never
+ * interned); players and roles call the PlayerId overloads directly.
+ *
+ * The costs and thresholds of the rules come from the RulesConfig the game is built with.
+ *
+ * A Game can be built in a GameArena: players and all bookkeeping are then allocated
+ * from the arena and released together on reset() or destruction.
  */
 class Game {
     friend class TestGame;
+    friend class Player; // players keep their status flags in seat_flags
 
 private:
+    // ===== Memory =====
+    GameArena *arena = nullptr;         ///< Arena holding the game state (nullptr: regular heap)
+    std::pmr::memory_resource *memory;  ///< Where players and bookkeeping are allocated
+
+    // ===== Rules =====
+    RulesConfig rules_config;           ///< Costs and thresholds (fixed for the game's lifetime)
+    bool standard_rules;                ///< rules_config is STANDARD_RULES (with_rules uses StandardRules)
+
+    // ===== Players =====
+    std::pmr::vector<RoleSlot> roster;                          ///< Role objects; MAX_PLAYERS reserved, so never moved
+    std::pmr::vector<std::shared_ptr<Player>> external_players; ///< Players added as objects (tests), kept alive
+    std::pmr::vector<Player *> players_list;                    ///< All players in the game, in seat order
+
+    // ===== Names =====
+    NameTable names;                                  ///< Interned names of the players who joined
+    std::array<Player *, MAX_PLAYERS> id_players{};  ///< PlayerId → player (nullptr for names that are not players)
+
     // ===== Game State =====
-    std::vector<std::shared_ptr<Player>> players_list; ///< All players in the game
+    SeatFlags seat_flags;                              ///< Alive / sanctioned / arrest-blocked bits, by seat
     size_t current_turn_index = 0;                     ///< Current player's index
     bool game_over = false;                            ///< Game over flag
+    bool log_enabled = true;                           ///< Whether the game log is printed to std::cout
     int global_turn_counter = 0;                       ///< Number of turns passed
 
     // ===== State Logs =====
-    std::string last_action;                                   ///< Description of last action
-    std::unordered_map<std::string, std::string> last_actions; ///< Player → last action performed
-    std::unordered_map<std::string, int> action_turn;          ///< Player → turn number of last action
+    static constexpr int NO_TURN = INT_MIN; ///< action_turn entry of a player who has not acted
+
+    std::pmr::string last_action;                     ///< Description of last action
+    std::array<ActionName, MAX_PLAYERS> last_actions; ///< Player → last action performed
+    std::array<int, MAX_PLAYERS> action_turn;         ///< Player → turn number of last action (NO_TURN: none)
+    std::array<int, MAX_PLAYERS> turn_began;          ///< Player → turn number its latest turn began at (NO_TURN: none)
+
+    // ===== Rounds =====
+    static constexpr size_t ROUND_ABILITIES = 4;
+
+    uint32_t round_epoch = 1;                                ///< Current round; goes up when the turn wraps around the seats
+    std::array<uint32_t, ROUND_ABILITIES> ability_epoch{};   ///< RoundAbility → round it was last used in (0: never)
 
     // ===== Arrest and Coup Logic =====
-    std::string last_arrested;                                          ///< Last arrested target name
-    std::vector<std::pair<std::string, std::string>> coup_pending_list; ///< List of pending coups (attacker → target)
-    std::unordered_set<std::string> arrest_blocked_players;             ///< Players blocked from using arrest
+    PlayerId last_arrested = NO_PLAYER;                ///< Last arrested target
+    std::array<PlayerId, MAX_PLAYERS> coup_attackers;  ///< Target → attacker of its pending coup (NO_PLAYER: none)
+
+    Game(GameArena *arena, const RulesConfig &rules, GameLog log);
 
     // ===== Internal Validation =====
     void assert_game_active() const; ///< Throws if game is over
+    Player *player_or_null(PlayerId id) const; ///< Player behind `id`, or nullptr
+    Player &player_at(PlayerId id) const;      ///< Player behind `id`; throws PlayerNotFoundException
+    PlayerId player_id(const std::string &name) const; ///< Id of the player `name`; throws PlayerNotFoundException
+    PlayerId claim_seat(const std::string &name); ///< Validates a joining player's name and interns it
+    void seat(Player &player, PlayerId id);       ///< Appends a player to the seats under `id`
+
+    /**
+     * @brief Records `actor`'s action (and its turn) and writes the log line, without printing it.
+     */
+    void record_action(std::string_view action_name, const Player &actor, const Player *target);
+    void clear_state();              ///< Drops all players and bookkeeping, including their memory
+    void count_pending_eliminations(); ///< Counts the victims of pending coups, final at game over
+
+    void clear_bookkeeping();        ///< Empties the per-player arrays
+
+    /**
+     * @brief Constructs a `Role` in the roster and returns it.
+     */
+    template <typename Role>
+    Player &emplace_role(const std::string &name);
+
+    /**
+     * @brief Replaces the last-action text with the concatenation of `parts`.
+     *
+     * The text's buffer is reused, so logging does not allocate once it is large enough.
+     */
+    template <typename... Parts>
+    void log_parts(const Parts &...parts) {
+        last_action.clear();
+        (last_action.append(parts), ...);
+    }
 
 public:
     // ===== Constructor =====
-    Game();
+
+    /**
+     * @brief Builds a game played by `rules`, printing its log unless `log` is GameLog::Quiet.
+     * @throws InvalidActionException if the rules are invalid.
+     */
+    explicit Game(const RulesConfig &rules = RulesConfig(), GameLog log = GameLog::Printed);
+
+    /**
+     * @brief Builds the game in `arena`, which must not be used by another game.
+     * @throws InvalidActionException if the arena is already in use or the rules are invalid.
+     */
+    explicit Game(GameArena &arena, const RulesConfig &rules = RulesConfig(), GameLog log = GameLog::Printed);
+
+    /**
+     * @brief Destroys the players and releases the arena (if any).
+     */
+    ~Game();
+
+    Game(const Game &) = delete;
+    Game &operator=(const Game &) = delete;
+
+    /**
+     * @brief The rules this game is played by.
+     */
+    const RulesConfig &rules() const { return rules_config; }
+
+    /**
+     * @brief Returns true if the game is played by STANDARD_RULES.
+     */
+    bool has_standard_rules() const { return standard_rules; }
+
+    /**
+     * @brief Turns printing the game log to std::cout on or off (as built; kept by reset()).
+     *
+     * The game still records each player's last action and the last-action text; only the
+     * printing stops. Players and roles check logging() before printing their own lines.
+     */
+    void set_logging(bool enabled) { log_enabled = enabled; }
+    bool logging() const { return log_enabled; }
+
+    /**
+     * @brief Calls `fn(rules)` with the game's rules, as StandardRules when they are the
+     * standard ones and as the RulesConfig otherwise.
+     *
+     * A generic `fn` is instantiated once per rules type: the standard-rules instantiation
+     * has every cost folded in, and which one runs is decided by a flag that never changes
+     * during the game.
+     */
+    template <typename Fn>
+    decltype(auto) with_rules(Fn &&fn) const {
+        if (standard_rules)
+            return fn(StandardRules());
+        return fn(rules_config);
+    }
 
     // ===== Player Management =====
 
     /**
      * @brief Add a new player by name and role.
+     * @return The player, owned by the game.
+     * @throws InvalidActionException if the game already has MAX_PLAYERS players (or names).
      */
-    std::shared_ptr<Player> add_player(const std::string &name, const std::string &role);
+    Player *add_player(const std::string &name, const std::string &role);
 
     /**
-     * @brief Add an existing Player instance (used in testing).
+     * @brief Add an existing Player instance (used in testing, e.g. for custom Player subclasses).
+     *
+     * The game shares ownership of the player instead of storing it by value.
      */
     void add_player(const std::shared_ptr<Player> &p);
 
@@ -63,49 +245,116 @@ public:
     void remove_player(const std::string &victim);
 
     /**
-     * @brief Return list of raw Player pointers (alive and dead).
+     * @brief Remove a player from the game by id.
+     */
+    void remove_player(PlayerId victim);
+
+    /**
+     * @brief Return list of raw Player pointers (alive and dead), in seat order.
+     */
+    const std::pmr::vector<Player *> &get_all_players_raw() const;
+
+    /**
+     * @brief Status flags of all seats (bit i is the player at seat i).
+     */
+    const SeatFlags &flags() const { return seat_flags; }
+
+    /**
+     * @brief Number of alive players.
+     */
+    int alive_count() const { return SeatFlags::count(seat_flags.active); }
+
+    /**
+     * @brief Seat of the first alive player after `seat` (wrapping around), or -1 if nobody is alive.
+     */
+    int next_active_seat(size_t seat) const { return SeatFlags::next_after(seat_flags.active, seat); }
+
+    // ===== Names =====
+
+    /**
+     * @brief Returns the id of a name, or NO_PLAYER if the game has never seen it.
+     */
+    PlayerId id_of(std::string_view name) const;
+
+    /**
+     * @brief Returns the name behind an id handed out by this game.
      */
-    std::vector<std::shared_ptr<Player>> get_all_players_raw() const;
+    const std::pmr::string &name_of(PlayerId id) const;
 
     // ===== Logging and Undo =====
 
     /**
      * @brief Save a descriptive string representing the last action.
      */
-    void log_action(const std::string &text);
+    void log_action(std::string_view text);
 
     /**
      * @brief Get string description of last action.
      */
-    std::string get_last_action() const { return last_action; }
+    std::string get_last_action() const { return std::string(last_action); }
 
     /**
      * @brief Check if last action of a player matches a specific type (e.g. "tax").
      */
     bool can_undo_action(const std::string &target_name, const std::string &expected_action) const;
+    bool can_undo_action(PlayerId target, std::string_view expected_action) const;
 
     /**
-     * @brief Returns true if a player's last action can still be undone based on turn distance.
+     * @brief Returns true if a player's last action can still be undone: its next turn has not begun yet.
      */
     bool can_still_undo(const std::string &player_name) const;
+    bool can_still_undo(PlayerId player) const;
 
     /**
-     * @brief Cancels the last recorded action for a player.
+     * @brief Cancels the last recorded action for a player (its entry becomes empty).
      */
     void cancel_last_action(const std::string &player_name);
+    void cancel_last_action(PlayerId player);
+
+    // ===== Once-per-round Abilities =====
 
-    // Undo Flags (used by GUI)
-    bool undo_tax = false;
-    bool undo_bribe = false;
-    bool peek_disable = false;
-    bool undo_coup = false;
+    /**
+     * @brief Abilities the whole table may use once per round.
+     */
+    enum class RoundAbility : uint8_t { UndoTax, UndoBribe, PeekDisable, UndoCoup };
+
+    /**
+     * @brief Number of the current round, from 1; it goes up each time the turn wraps around the seats.
+     */
+    uint32_t round() const { return round_epoch; }
+
+    /**
+     * @brief Returns true if `ability` was used in the current round.
+     *
+     * Each ability keeps the round it was last used in, so a new round frees them all
+     * without touching them.
+     */
+    bool used_this_round(RoundAbility ability) const {
+        return ability_epoch[static_cast<size_t>(ability)] == round_epoch;
+    }
+
+    /**
+     * @brief Records that `ability` was used in the current round.
+     */
+    void mark_used(RoundAbility ability) { ability_epoch[static_cast<size_t>(ability)] = round_epoch; }
+
+    /**
+     * @brief Frees `ability` for the rest of the current round (used for tests).
+     */
+    void clear_used(RoundAbility ability) { ability_epoch[static_cast<size_t>(ability)] = 0; }
 
     // ===== Turn Handling =====
 
     /**
      * @brief Get the name of the player whose turn it is.
      */
-    std::string turn() const;
+    const std::string &turn() const;
+
+    /**
+     * @brief Get the id of the player whose turn it is.
+     * @throws InvalidActionException if there are no players.
+     */
+    PlayerId turn_id() const;
 
     /**
      * @brief Advance to the next active player's turn.
@@ -117,6 +366,11 @@ public:
      */
     int get_current_turn_index() const;
 
+    /**
+     * @brief Number of turns that have ended since the game started.
+     */
+    int turns_played() const { return global_turn_counter; }
+
     /**
      * @brief Set turn index manually (used for tests).
      */
@@ -125,22 +379,37 @@ public:
     /**
      * @brief Record an action performed by a player (no target).
      */
-    void perform_action(const std::string &action_name, const std::string &by);
+    void perform_action(std::string_view action_name, const std::string &by);
 
     /**
      * @brief Record an action performed by a player on a target.
      */
-    void perform_action(const std::string &action_name, const std::string &by, const std::string &target_name);
+    void perform_action(std::string_view action_name, const std::string &by, const std::string &target_name);
+
+    /**
+     * @brief Record an action performed by a player, on a target unless it is NO_PLAYER.
+     */
+    void perform_action(std::string_view action_name, PlayerId by, PlayerId target = NO_PLAYER);
+
+    /**
+     * @brief Get the map of players' last actions, by name (built on each call).
+     */
+    std::unordered_map<std::string, std::string> get_last_actions() const;
 
     /**
-     * @brief Get the full map of players' last actions.
+     * @brief Get a player's last action ("" if none).
      */
-    const std::unordered_map<std::string, std::string> &get_last_actions() const;
+    std::string_view last_action_of(PlayerId player) const;
 
     /**
      * @brief Retrieve player instance by name.
      */
-    std::shared_ptr<Player> get_player_by_name(const std::string &name) const;
+    Player *get_player_by_name(const std::string &name) const;
+
+    /**
+     * @brief Retrieve player instance by id, or nullptr if the id is not a player.
+     */
+    Player *get_player_by_id(PlayerId id) const { return player_or_null(id); }
 
     // ===== Game State Queries =====
 
@@ -178,24 +447,33 @@ public:
     // ===== Coup Logic =====
 
     /**
-     * @brief Add a pending coup entry (attacker → target).
+     * @brief Add a pending coup entry (attacker → target); a target has at most one, the latest.
+     * @throws PlayerNotFoundException if a name is not a player of this game.
      */
     void add_to_coup(const std::string &attacker, const std::string &target);
+    void add_to_coup(PlayerId attacker, PlayerId target);
+
+    /**
+     * @brief Get list of pending coup pairs (attacker → target), by name, in target id order.
+     */
+    std::vector<std::pair<std::string, std::string>> get_coup_pending_list() const;
 
     /**
-     * @brief Get list of pending coup pairs.
+     * @brief Get the attacker of each target's pending coup, indexed by target id (NO_PLAYER: none).
      */
-    const std::vector<std::pair<std::string, std::string>> &get_coup_pending_list() const;
+    const std::array<PlayerId, MAX_PLAYERS> &get_coup_attackers() const;
 
     /**
      * @brief Cancel a pending coup on a specific target.
      */
     void cancel_coup(const std::string &target);
+    void cancel_coup(PlayerId target);
 
     /**
      * @brief Check if there is a pending coup on the given target.
      */
     bool is_coup_pending_on(const std::string &target) const;
+    bool is_coup_pending_on(PlayerId target) const;
 
     // (Currently unused internal helpers)
     void mark_coup_pending(const std::string &attacker, const std::string &target);
@@ -207,21 +485,26 @@ public:
      * @brief Prevent a player from using arrest this round.
      */
     void block_arrest_for(const std::string &name);
+    void block_arrest_for(PlayerId player);
 
     /**
      * @brief Check if arrest is blocked for a player.
      */
     bool is_arrest_blocked(const std::string &name) const;
+    bool is_arrest_blocked(PlayerId player) const;
 
     /**
-     * @brief Record the name of the last arrested player.
+     * @brief Record the last arrested player ("" / NO_PLAYER clears it).
+     * @throws PlayerNotFoundException if a name is not a player of this game.
      */
     void set_last_arrest_target(const std::string &target);
+    void set_last_arrest_target(PlayerId target);
 
     /**
      * @brief Returns true if same target was arrested in last turn.
      */
     bool arrested_same_target(const std::string &target) const;
+    bool arrested_same_target(PlayerId target) const;
 };
 
 } // namespace coup
@@ -0,0 +1,56 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace coup {
+
+/**
+ * @brief Monotonic memory arena that a Game can be built in.
+ *
+ * A Game constructed with an arena allocates its players (one after another, in seat order),
+ * player list, action logs and bookkeeping maps from it. Nothing is freed one by one;
+ * Game::reset and the Game's destructor release the whole arena at once, after which the
+ * next game reuses the same initial buffer without touching the heap.
+ *
+ * An arena serves one Game at a time. Players handed out by an arena-backed game must not
+ * be kept after that game is reset or destroyed.
+ */
+class GameArena {
+public:
+    /**
+     * @brief Creates an arena with an initial buffer of `initial_bytes`.
+     *
+     * Games that need more memory spill into heap blocks, which are also released together.
+     */
+    explicit GameArena(std::size_t initial_bytes = 64 * 1024);
+
+    GameArena(const GameArena &) = delete;
+    GameArena &operator=(const GameArena &) = delete;
+
+    /**
+     * @brief Returns the arena of the calling thread (created on first use).
+     */
+    static GameArena &this_thread();
+
+    std::pmr::memory_resource *resource() { return &pool; }
+
+    /**
+     * @brief Frees everything allocated from the arena; the initial buffer is kept for reuse.
+     */
+    void release() { pool.release(); }
+
+    bool in_use() const { return used; }
+
+private:
+    friend class Game;
+
+    std::unique_ptr<std::byte[]> buffer;
+    std::pmr::monotonic_buffer_resource pool;
+    bool used = false; ///< Set while a Game is built in this arena
+};
+
+} // namespace coup
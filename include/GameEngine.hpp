@@ -0,0 +1,142 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Game.hpp"
+#include "SpscQueue.hpp"
+#include "TripleBuffer.hpp"
+
+namespace coup {
+
+/**
+ * @brief Read-only copy of one player's state inside a GameSnapshot.
+ */
+struct PlayerView {
+    std::string name;
+    std::string role;
+    int coins = 0;
+    bool active = false;
+    bool sanctioned = false;
+    bool arrest_disabled = false;
+    std::string last_action;      ///< Last undoable action recorded by the game ("" if none)
+    bool can_still_undo = false;  ///< Result of Game::can_still_undo for this player
+};
+
+/**
+ * @brief Immutable picture of the whole game, published by the engine after every command.
+ */
+struct GameSnapshot {
+    uint64_t version = 0;                                               ///< Increases with every publish
+    int turn = 0;                                                       ///< Game::turns_played()
+    std::vector<PlayerView> players;                                    ///< Seat order, alive and eliminated
+    int current = -1;                                                   ///< Seat of the player in turn (-1 if none)
+    bool game_over = false;
+    std::string winner;                                                 ///< Set when exactly one player is alive
+    std::string last_action;                                            ///< Game::get_last_action()
+    std::vector<std::pair<std::string, std::string>> coup_pending_list; ///< (attacker, target)
+    int forced_coup_at = RulesConfig().forced_coup_at;                  ///< Game::rules().forced_coup_at
+
+    /**
+     * @brief Returns the player in turn, or nullptr if there are no players.
+     */
+    const PlayerView *current_player() const;
+
+    /**
+     * @brief Returns the player with the given name, or nullptr.
+     */
+    const PlayerView *find(const std::string &name) const;
+
+    /**
+     * @brief Returns the number of active players.
+     */
+    size_t alive_count() const;
+};
+
+/**
+ * @brief Outcome of one submitted command.
+ */
+struct CommandResult {
+    uint64_t id = 0;      ///< Id returned by GameEngine::submit
+    bool ok = false;      ///< false if the command threw
+    std::string message;  ///< Exception text on failure; new last action on success ("" if none)
+};
+
+/**
+ * @brief Runs a Game on its own thread, fed by a lock-free command queue.
+ *
+ * The owning (UI) thread submits commands and reads results and snapshots without
+ * taking locks; only the engine thread ever touches the Game after construction.
+ * Each executed command is followed by a fresh GameSnapshot published through a
+ * triple buffer, so a slow command never stalls the reader.
+ */
+class GameEngine {
+public:
+    using Command = std::function<void(Game &)>;
+
+    /**
+     * @brief Publishes the initial snapshot and starts the engine thread.
+     * @param game The game to drive. It must not be used directly while the engine runs.
+     */
+    explicit GameEngine(Game &game);
+
+    /**
+     * @brief Stops the engine thread (pending commands are dropped).
+     */
+    ~GameEngine();
+
+    GameEngine(const GameEngine &) = delete;
+    GameEngine &operator=(const GameEngine &) = delete;
+
+    /**
+     * @brief Queues a command for the engine thread (waits only if the queue is full).
+     * @return The id reported back in the matching CommandResult.
+     */
+    uint64_t submit(Command command);
+
+    /**
+     * @brief Returns the next unread command result, if any.
+     */
+    bool poll_result(CommandResult &out);
+
+    /**
+     * @brief Returns the newest snapshot; stays valid until the next call.
+     */
+    const GameSnapshot &snapshot();
+
+    /**
+     * @brief Stops and joins the engine thread. Safe to call more than once.
+     */
+    void stop();
+
+    /**
+     * @brief Fills a snapshot from the current state of a game.
+     */
+    static void capture(const Game &game, GameSnapshot &out);
+
+private:
+    struct Pending {
+        uint64_t id = 0;
+        Command command;
+    };
+
+    Game &game;
+    SpscQueue<Pending, 64> commands;        ///< UI thread -> engine thread
+    SpscQueue<CommandResult, 64> results;   ///< Engine thread -> UI thread
+    TripleBuffer<GameSnapshot> snapshots;   ///< Engine thread -> UI thread
+    uint64_t next_id = 1;                   ///< UI-thread counter for command ids
+    uint64_t version = 0;                   ///< Engine-thread snapshot counter
+    std::atomic<bool> running{true};
+    std::thread worker;
+
+    void loop();      ///< Engine thread body
+    void publish();   ///< Captures and publishes a snapshot
+};
+
+} // namespace coup
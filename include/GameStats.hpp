@@ -0,0 +1,131 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace coup {
+
+/**
+ * @brief Actions counted by GameStats: the turn actions, then the out-of-turn abilities.
+ */
+enum class StatAction : uint8_t {
+    Gather, Tax, Bribe, Invest, Arrest, Sanction, Coup, Skip,
+    UndoTax, UndoBribe, UndoCoup, PeekAndDisable,
+    Count
+};
+
+/**
+ * @brief Why an action was rejected: one entry per exception of Exceptions.hpp.
+ */
+enum class Rejection : uint8_t {
+    NotYourTurn, InvalidAction, GameNotOver, GameAlreadyOver, PlayerNotFound, DuplicatePlayerName,
+    PlayerAlreadyDead, CannotTargetYourself, NotEnoughCoins, MustCoup, UndoNotAllowed, Other,
+    Count
+};
+
+enum class StatOutcome : uint8_t { Ok, Rejected, Count };
+
+const char *to_string(StatAction action);
+const char *to_string(Rejection reason);
+
+/**
+ * @brief The action logged by Game::perform_action under `name`, or StatAction::Count if none.
+ */
+StatAction stat_action_from_name(std::string_view name);
+
+/**
+ * @brief Maps an exception thrown by an action to its Rejection.
+ */
+Rejection classify_rejection(const std::exception &e);
+
+/**
+ * @brief Merged counters of every thread, as returned by GameStats::snapshot().
+ */
+struct GameStatsSnapshot {
+    static constexpr size_t ACTIONS = static_cast<size_t>(StatAction::Count);
+    static constexpr size_t REJECTIONS = static_cast<size_t>(Rejection::Count);
+    static constexpr size_t OUTCOMES = static_cast<size_t>(StatOutcome::Count);
+    static constexpr size_t ROLES = 7;         ///< The six roles, then any other
+    static constexpr size_t COIN_BUCKETS = 14; ///< 0 .. 12 coins, then 13 or more
+    static constexpr size_t TURN_BUCKETS = 10; ///< Up to 8, 16, ... 2048 turns, then more
+
+    static const char *const ROLE_NAMES[ROLES];
+
+    uint64_t actions[ACTIONS][ROLES][OUTCOMES] = {};
+    uint64_t rejections[ACTIONS][REJECTIONS] = {};
+    uint64_t elimination_coins[COIN_BUCKETS] = {};
+    uint64_t elimination_coins_sum = 0;
+    uint64_t game_turns[TURN_BUCKETS] = {};
+    uint64_t game_turns_sum = 0;
+    uint64_t wins[ROLES] = {};
+
+    /**
+     * @brief Slot of a role name in the per-role counters (the last slot for unknown roles).
+     */
+    static size_t role_slot(std::string_view role);
+
+    /**
+     * @brief Upper bound of a game_turns bucket (the last bucket has none).
+     */
+    static uint64_t turn_bucket_limit(size_t bucket) { return uint64_t{8} << bucket; }
+
+    uint64_t count(StatAction action, StatOutcome outcome) const;
+    uint64_t eliminations() const;
+    uint64_t games() const;
+
+    /**
+     * @brief Writes every counter as one JSON object.
+     */
+    void write_json(std::ostream &out) const;
+
+    /**
+     * @brief Writes every counter in the Prometheus text exposition format.
+     */
+    void write_prometheus(std::ostream &out) const;
+};
+
+/**
+ * @brief Process-wide game statistics for production dashboards.
+ *
+ * Every thread counts into its own shard, written only by that thread, so counting is a
+ * relaxed load and store with no shared cache line. snapshot() sums the shards of every
+ * thread that ever counted (shards of finished threads are kept), so reads cost more
+ * than writes. Counts taken while a snapshot is merged may land in it or in the next one.
+ *
+ * Every Player action and role ability counts itself, successful or rejected, through
+ * Player::act, whichever front-end called it. Game counts finished games, and eliminations
+ * once they are final: a coup's victim when its attacker's next turn begins or the game ends,
+ * since a General can undo the coup until then.
+ */
+class GameStats {
+public:
+    static void count_action(StatAction action, std::string_view role, StatOutcome outcome);
+    static void count_rejection(StatAction action, std::string_view role, Rejection reason);
+    static void count_rejection(StatAction action, std::string_view role, const std::exception &e);
+    static void count_elimination(int coins);
+    static void count_game(int turns, std::string_view winner_role);
+
+    /**
+     * @brief Sums the counters of every thread.
+     */
+    static GameStatsSnapshot snapshot();
+
+    /**
+     * @brief Zeroes every thread's counters (counts made meanwhile may survive).
+     */
+    static void reset();
+
+    /**
+     * @brief Writes a snapshot to `path`: Prometheus text if it ends in ".prom" or ".txt", JSON otherwise.
+     * @return false if the file could not be written.
+     */
+    static bool dump(const std::string &path);
+};
+
+} // namespace coup
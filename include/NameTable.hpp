@@ -0,0 +1,70 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef COUP_MAX_PLAYERS
+#define COUP_MAX_PLAYERS 8 ///< Override with -DCOUP_MAX_PLAYERS=<n> (see MAX_PLAYERS in the Makefile)
+#endif
+
+namespace coup {
+
+/**
+ * @brief Most names (and so players) a game can hold; sizes the game's per-player arrays.
+ */
+constexpr size_t MAX_PLAYERS = COUP_MAX_PLAYERS;
+
+/**
+ * @brief Handle of a name interned by a game; the index of the name in its NameTable.
+ */
+using PlayerId = uint32_t;
+
+/// PlayerId that refers to no name (e.g. a player not added to any game yet).
+constexpr PlayerId NO_PLAYER = UINT32_MAX;
+
+/**
+ * @brief Interning table mapping each distinct name to a stable PlayerId.
+ *
+ * A name is stored once, when it is first interned; ids are handed out in order, stay
+ * valid until the table is destroyed and are always below MAX_PLAYERS. Lookups by string
+ * are meant for the edges of the game (its public name-based API); everything inside
+ * keys on the ids.
+ */
+class NameTable {
+public:
+    explicit NameTable(std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+
+    /**
+     * @brief Returns the id of `name`, adding it to the table if it is new.
+     * @throws InvalidActionException if the table already holds MAX_PLAYERS names.
+     */
+    PlayerId intern(std::string_view name);
+
+    /**
+     * @brief Returns the id of `name`, or NO_PLAYER if it was never interned.
+     */
+    PlayerId find(std::string_view name) const;
+
+    /**
+     * @brief Returns the name behind `id` (which must come from this table).
+     */
+    const std::pmr::string &name(PlayerId id) const { return names[id]; }
+
+    size_t size() const { return names.size(); }
+
+    /**
+     * @brief Swaps contents with a table using the same memory resource.
+     */
+    void swap(NameTable &other) { names.swap(other.names); }
+
+private:
+    std::pmr::vector<std::pmr::string> names; ///< Interned names; a name's id is its index
+};
+
+} // namespace coup
@@ -4,10 +4,35 @@
 
 #include <string>
 #include <memory>
+#include "Exceptions.hpp"
+#include "GameStats.hpp"
+#include "NameTable.hpp"
+#include "SeatFlags.hpp"
+#include "Trace.hpp"
 
 namespace coup {
 
 class Game; // Forward declaration to avoid including Game.hpp
+class Player;
+
+/**
+ * @brief Why Player::check refuses an action: the exception the action would throw, with
+ * what it needs to build it. Checking builds no strings, so it neither throws nor allocates.
+ */
+struct Refusal {
+    Rejection reason = Rejection::Count; ///< Class of the exception; Count if the action is allowed
+    const char *text = "";               ///< InvalidAction reason, or the action of CannotTargetYourself / UndoNotAllowed
+    const Player *player = nullptr;      ///< Whose name (PlayerNotFound / PlayerAlreadyDead) or role (UndoNotAllowed)
+    int required = 0;                    ///< NotEnoughCoins: coins needed
+    int current = 0;                     ///< NotEnoughCoins: coins held
+
+    explicit operator bool() const { return reason != Rejection::Count; }
+
+    /**
+     * @brief Throws the exception the refused action would have thrown.
+     */
+    [[noreturn]] void raise() const;
+};
 
 /**
  * @brief Abstract base class representing a player in the Coup game.
@@ -16,13 +41,67 @@ class Game; // Forward declaration to avoid including Game.hpp
  * and hooks for passive/active role-specific behavior.
  */
 class Player {
+    friend class Game; // assigns the id and seat when the player is added
+
+public:
+    static constexpr size_t NO_SEAT = SIZE_MAX; ///< seat() of a player not added to its game yet
+
 protected:
     std::string name;        ///< Player name
+    PlayerId player_id = NO_PLAYER; ///< Interned name in the game (set by Game::add_player)
+    size_t seat_index = NO_SEAT;    ///< Seat in the game (set by Game::add_player)
     Game* game;              ///< Pointer to the game instance
     int coin_count = 0;      ///< Number of coins the player currently holds
-    bool active = true;      ///< Whether the player is alive in the game
-    bool under_sanction = false;   ///< Whether player is currently sanctioned
-    bool arrest_disabled = false; ///< Whether arrest is blocked for this player
+
+    /// Status flags (alive, sanctioned, arrest blocked) until the player is seated; the game's
+    /// SeatFlags hold them afterwards.
+    SeatFlags own_flags{SeatFlags::bit(0), 0, 0};
+
+    SeatFlags &flags();             ///< Masks holding this player's flags
+    const SeatFlags &flags() const;
+    uint64_t flag_bit() const;      ///< This player's bit in flags()
+
+    /**
+     * @brief ensure_coup_required() against `rules` (a RulesConfig or FixedRules), for action
+     * bodies run through Game::with_rules.
+     */
+    template <typename Rules>
+    void ensure_coup_required(const Rules &rules) const {
+        if (coin_count >= rules.forced_coup_at)
+            throw MustCoupWith10CoinsException();
+    }
+
+    /**
+     * @brief Runs an action or ability: check()s it, then runs `body` (its effects) and counts
+     * it as successful in GameStats, or counts it as rejected and throws what check() found.
+     *
+     * Every action and role ability goes through here, so each one is counted once whichever
+     * front-end (bots, GUI, scripts, reactions) called it, and its rules live only in check().
+     */
+    template <typename Body>
+    void act(StatAction action, const Player *target, Body &&body) {
+        {
+            COUP_TRACE_SPAN("validate");
+            if (Refusal refusal = check(action, target)) {
+                GameStats::count_rejection(action, role(), refusal.reason);
+                refusal.raise();
+            }
+        }
+        {
+            COUP_TRACE_SPAN("execute");
+            body();
+        }
+        GameStats::count_action(action, role(), StatOutcome::Ok);
+    }
+
+    Refusal check_turn() const;   ///< NotYourTurn (or InvalidAction with no players) unless in turn
+    Refusal check_active() const; ///< GameAlreadyOver once the game is over
+
+    /**
+     * @brief The checks of Player::check, against `rules` (a RulesConfig or FixedRules).
+     */
+    template <typename Rules>
+    Refusal check_rules(StatAction action, const Player *target, const Rules &rules) const;
 
 public:
     /**
@@ -42,6 +121,16 @@ public:
      */
     const std::string& get_name() const;
 
+    /**
+     * @brief Returns the player's interned name id in its game (NO_PLAYER until added).
+     */
+    PlayerId id() const { return player_id; }
+
+    /**
+     * @brief Returns the player's seat index in its game (NO_SEAT until added).
+     */
+    size_t seat() const { return seat_index; }
+
     /**
      * @brief Returns the number of coins the player has.
      */
@@ -70,10 +159,24 @@ public:
      */
     virtual std::string role() const = 0;
 
+    // ===== Checks =====
+
+    /**
+     * @brief Checks whether `action` (on `target`, for the targeted ones) would be accepted now,
+     * without throwing, printing or changing anything.
+     *
+     * These are the checks the action itself runs first, so the action throws exactly when
+     * check() refuses it (the exception refusal.raise() throws). Roles override it for their
+     * abilities; the base refuses the abilities of other roles with UndoNotAllowed.
+     *
+     * @return An empty Refusal if the action would be accepted, otherwise why not.
+     */
+    virtual Refusal check(StatAction action, const Player *target = nullptr) const;
+
     // ===== Basic Actions =====
 
     /**
-     * @brief Gain 1 coin (does not target another player).
+     * @brief Gain RulesConfig::gather_income coins (does not target another player).
      * @throws NotYourTurnException or InvalidActionException if under sanction or must coup.
      */
     void gather();
@@ -85,13 +188,13 @@ public:
     void skip_turn();
 
     /**
-     * @brief Gain 2 coins (can be overridden by role).
+     * @brief Gain RulesConfig::tax_income coins (can be overridden by role).
      * @throws NotYourTurnException or InvalidActionException if under sanction or must coup.
      */
     virtual void tax();
 
     /**
-     * @brief Spend 4 coins to bribe (used by some roles).
+     * @brief Spend RulesConfig::bribe_cost coins to bribe (used by some roles).
      * @throws NotYourTurnException or NotEnoughCoinsException.
      */
     void bribe();
@@ -137,7 +240,7 @@ public:
     void disable_arrest();
 
     /**
-     * @brief Throws if player has 10+ coins and has not performed a coup.
+     * @brief Throws if player has RulesConfig::forced_coup_at+ coins and has not performed a coup.
      * @throws MustCoupWith10CoinsException.
      */
     void ensure_coup_required() const;
@@ -0,0 +1,103 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace coup {
+
+/**
+ * @brief Elo ratings of competitors playing multiplayer games.
+ *
+ * A game with a finishing order counts as every pair of different competitors playing
+ * each other: the better placed one wins, equal places draw. Each pair moves the ratings
+ * by K / (players - 1), so a game weighs the same at every table size. All updates of a
+ * game are computed from the ratings before it.
+ */
+class EloRatings {
+public:
+    /**
+     * @brief Starts `competitors` ratings at `initial`.
+     */
+    explicit EloRatings(size_t competitors, double k = 16.0, double initial = 1500.0);
+
+    /**
+     * @brief Records one game.
+     * @param who Competitor of each seat (a competitor may hold several seats).
+     * @param ranks Place of each seat, lower is better; equal values are a tie.
+     */
+    void update(const std::vector<size_t> &who, const std::vector<int> &ranks);
+
+    double rating(size_t competitor) const { return ratings[competitor]; }
+
+    /**
+     * @brief Share of pairwise comparisons won (draws count half), 0.5 before any.
+     */
+    double score(size_t competitor) const;
+
+    /**
+     * @brief Half-width of the 95% interval of the rating, from the pairwise score and
+     * the number of comparisons (infinite before any decisive result).
+     */
+    double interval(size_t competitor) const;
+
+    uint64_t comparisons(size_t competitor) const { return pairs[competitor]; }
+    size_t size() const { return ratings.size(); }
+
+private:
+    double k_factor;
+    std::vector<double> ratings;
+    std::vector<double> points;  ///< Pairwise points won
+    std::vector<uint64_t> pairs; ///< Pairwise comparisons played
+};
+
+/**
+ * @brief TrueSkill ratings (a Gaussian belief of each competitor's skill).
+ *
+ * Multiplayer games use the pairwise approximation of the factor graph: each pair of
+ * adjacent places (every seat of one place against every seat of the next) is a two-player
+ * TrueSkill update from the pre-game beliefs, and the updates are summed. Ties and pairs of
+ * one competitor with itself carry no update.
+ */
+class TrueSkillRatings {
+public:
+    /**
+     * @brief Starts `competitors` beliefs at N(mu, sigma^2).
+     * @param beta Performance noise of one game.
+     * @param tau Skill drift added to sigma before every game.
+     */
+    explicit TrueSkillRatings(size_t competitors, double mu = 25.0, double sigma = 25.0 / 3,
+                              double beta = 25.0 / 6, double tau = 25.0 / 300);
+
+    /**
+     * @brief Records one game (same arguments as EloRatings::update).
+     */
+    void update(const std::vector<size_t> &who, const std::vector<int> &ranks);
+
+    double mu(size_t competitor) const { return means[competitor]; }
+    double sigma(size_t competitor) const;
+
+    /**
+     * @brief mu - 3 sigma: a rating the competitor very likely exceeds, used to rank.
+     */
+    double conservative(size_t competitor) const { return mu(competitor) - 3 * sigma(competitor); }
+
+    size_t size() const { return means.size(); }
+
+private:
+    double beta2;
+    double tau2;
+    std::vector<double> means;
+    std::vector<double> variances;
+
+    // Scratch of update(), kept so that rating a game reuses their buffers
+    std::vector<size_t> involved;       ///< Competitors of the game, sorted, each once
+    std::vector<size_t> slot;           ///< Seat → entry in involved
+    std::vector<int> places;            ///< Distinct ranks, best first
+    std::vector<double> mean_delta;     ///< Entry in involved → summed mean update
+    std::vector<double> variance_scale; ///< Entry in involved → product of variance factors
+};
+
+} // namespace coup
@@ -0,0 +1,206 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "NameTable.hpp"
+
+namespace coup {
+
+class Game;
+
+/**
+ * @brief Out-of-turn abilities, in the order they are resolved when several are chosen.
+ */
+enum class ReactionKind : uint8_t {
+    UndoCoup,       // General::undo_coup on the coup's target
+    UndoBribe,      // Judge::undo_bribe on the briber
+    UndoTax,        // Governor::undo_tax on the taxer
+    PeekAndDisable  // Spy::peek_and_disable on a player of the Spy's choice
+};
+
+/**
+ * @brief Returns the ability's name ("undo_coup", "undo_bribe", "undo_tax", "peek_and_disable").
+ */
+const char *to_string(ReactionKind kind);
+
+/**
+ * @brief One ability a player may use in a reaction window.
+ */
+struct ReactionOffer {
+    PlayerId responder = NO_PLAYER;
+    ReactionKind kind = ReactionKind::PeekAndDisable;
+    PlayerId target = NO_PLAYER; ///< Fixed target, or NO_PLAYER if the responder picks one
+};
+
+/**
+ * @brief What became of one offer when its window closed.
+ */
+struct ReactionOutcome {
+    ReactionOffer offer;
+    bool answered = false;       ///< false if the deadline passed first
+    bool reacted = false;        ///< The responder chose to use the ability
+    PlayerId target = NO_PLAYER; ///< Target used
+    bool applied = false;        ///< The ability went through
+    std::string error;           ///< Why the game rejected it, if it did
+};
+
+/**
+ * @brief A closed reaction window.
+ */
+struct ResolvedWindow {
+    uint64_t id = 0;
+    Game *game = nullptr;
+    PlayerId actor = NO_PLAYER;
+    std::string action;
+    std::vector<ReactionOutcome> outcomes; ///< In resolution order: chosen reactions by priority, then passes
+};
+
+/**
+ * @brief Reaction phases of many games, driven without blocking.
+ *
+ * After an action the driver opens a window. The window offers every eligible player
+ * its out-of-turn abilities: a Governor can undo a tax, a Judge a bribe, a General a coup
+ * (when it can pay), and a Spy can peek and disable anyone. Bots answer through a callback
+ * as soon as the window is polled; humans answer with react() or pass() before the deadline, and
+ * an unanswered offer counts as a pass.
+ *
+ * poll() closes every window that is fully answered or past its deadline: chosen reactions
+ * are applied through the role's own ability in ReactionKind order (ties go to the seat
+ * that comes first after the actor), a rejected one does not stop the rest, and the
+ * window is reported as resolved. Nothing blocks: one thread can keep thousands of windows
+ * of different games open and poll them all, at a cost proportional to the windows that
+ * changed or expired. A window whose offers all go to bots closes on its first poll, so it
+ * gets no deadline (unless a bot is dropped before then).
+ *
+ * Games are referenced, not owned: a game must outlive its windows or be forgotten first.
+ */
+class ReactionScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Decides a bot's reaction: returns the target to use the ability on
+     * (`offer.target` when it is fixed), or NO_PLAYER to pass.
+     */
+    using BotResponder = std::function<PlayerId(const Game &, const ReactionOffer &)>;
+
+    static constexpr uint64_t NO_WINDOW = 0;
+
+    /**
+     * @param human_deadline Time humans have to answer a window.
+     */
+    explicit ReactionScheduler(Clock::duration human_deadline = std::chrono::seconds(5));
+
+    /**
+     * @brief Makes `player` of `game` a bot: its offers are answered by `responder`.
+     */
+    void set_bot(const Game &game, PlayerId player, BotResponder responder);
+
+    /**
+     * @brief Closes the game's windows without applying them and drops its bots.
+     */
+    void forget(const Game &game);
+
+    /**
+     * @brief Opens the reaction window of `actor`'s last action (Game::last_action_of).
+     * @return The window, or NO_WINDOW if nobody can react to it.
+     */
+    uint64_t open(Game &game, PlayerId actor, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Opens a window for an explicit action: "tax", "bribe", "coup" (with its
+     * target) or any other action name, which only Spies may react to.
+     */
+    uint64_t open(Game &game, PlayerId actor, std::string_view action, PlayerId target,
+                  Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Uses one of `responder`'s offers in an open window.
+     * @param target Target of the ability; needed only when the offer has no fixed target.
+     * @throws InvalidActionException if the window is closed, the offer does not exist or
+     * was already answered, or a target is missing.
+     */
+    void react(uint64_t window, PlayerId responder, ReactionKind kind, PlayerId target = NO_PLAYER);
+
+    /**
+     * @brief Passes on every unanswered offer of `responder` in an open window.
+     * @throws InvalidActionException if the window is closed.
+     */
+    void pass(uint64_t window, PlayerId responder);
+
+    /**
+     * @brief Asks bots, then resolves the windows that are complete or past their deadline.
+     * @return Number of windows appended to `resolved`.
+     */
+    size_t poll(std::vector<ResolvedWindow> &resolved, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Offers of an open window (empty if it is closed).
+     */
+    const std::vector<ReactionOffer> &offers(uint64_t window) const;
+
+    bool is_open(uint64_t window) const;
+
+    /**
+     * @brief True while the game has an open window: its next action should wait.
+     */
+    bool has_open_window(const Game &game) const;
+
+    size_t open_windows() const { return open_count; }
+
+    /**
+     * @brief Deadlines still queued, including those of windows closed before them.
+     */
+    size_t queued_deadlines() const { return deadlines.size(); }
+
+private:
+    struct Answer {
+        bool answered = false;
+        PlayerId target = NO_PLAYER; ///< NO_PLAYER: passed
+    };
+
+    struct Window {
+        uint32_t generation = 0;
+        bool open = false;
+        bool queued = false; ///< In the ready queue
+        bool timed = false;  ///< Has an entry in deadlines
+        Game *game = nullptr;
+        PlayerId actor = NO_PLAYER;
+        std::string action;
+        std::vector<ReactionOffer> offers;
+        std::vector<Answer> answers;
+        size_t unanswered = 0;
+    };
+
+    struct GameEntry {
+        std::array<BotResponder, MAX_PLAYERS> bots;
+        size_t open_windows = 0;
+    };
+
+    using Deadline = std::pair<Clock::time_point, uint64_t>;
+
+    Clock::duration deadline_after;
+    std::vector<Window> windows;
+    std::vector<uint32_t> free_slots;
+    std::vector<uint64_t> ready;  ///< Windows to look at on the next poll (new or answered)
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines;
+    std::unordered_map<const Game *, GameEntry> games;
+    size_t open_count = 0;
+
+    Window *find(uint64_t window);
+    const Window *find(uint64_t window) const;
+    void mark_ready(uint64_t id, Window &w);
+    void answer(Window &w, size_t offer, PlayerId target);
+    void close(uint64_t id, Window &w, std::vector<ResolvedWindow> *resolved);
+};
+
+} // namespace coup
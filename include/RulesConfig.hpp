@@ -0,0 +1,97 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace coup {
+
+/**
+ * @brief The costs and thresholds of the rules, given to a Game at construction.
+ *
+ * The defaults are the standard rules. Everything that reads a cost (Player actions, role
+ * abilities, bots, the batched simulator) takes it from the game's RulesConfig, so rule
+ * balance can be tuned without touching the code.
+ */
+struct RulesConfig {
+    int gather_income = 1;        ///< Coins from Gather
+    int tax_income = 2;           ///< Coins from Tax
+    int governor_tax = 3;         ///< Coins from a Governor's Tax
+    int bribe_cost = 4;           ///< Price of Bribe
+    int sanction_cost = 3;        ///< Price of Sanction
+    int judge_sanction_extra = 1; ///< Added to the price of sanctioning a Judge
+    int coup_cost = 7;            ///< Price of Coup
+    int forced_coup_at = 10;      ///< Coins from which the player in turn must coup
+    int invest_cost = 3;          ///< Coins a Baron pays (and must hold) to invest
+    int invest_return = 6;        ///< Coins a Baron gets back from investing
+    int general_undo_cost = 5;    ///< Price of a General's undo_coup
+    int merchant_bonus_at = 3;    ///< Coins from which a Merchant gets the turn-start bonus
+    int merchant_bonus = 1;       ///< Size of the Merchant's turn-start bonus
+
+    /**
+     * @brief Checks that the rules can be played.
+     * @throws InvalidActionException if a value is negative or a forced coup cannot be paid.
+     */
+    void validate() const;
+
+    /**
+     * @brief Sets the value named `name` (as listed by fields()).
+     * @throws InvalidActionException for an unknown name.
+     */
+    void set(const std::string &name, int value);
+
+    /**
+     * @brief Returns the value named `name`.
+     * @throws InvalidActionException for an unknown name.
+     */
+    int get(const std::string &name) const;
+
+    /**
+     * @brief Names of all values, in declaration order.
+     */
+    static const std::vector<std::string> &fields();
+
+    bool operator==(const RulesConfig &other) const;
+    bool operator!=(const RulesConfig &other) const { return !(*this == other); }
+};
+
+/**
+ * @brief The standard rules (RulesConfig's defaults) as a compile-time constant.
+ */
+inline constexpr RulesConfig STANDARD_RULES{};
+
+static_assert(sizeof(RulesConfig) == 13 * sizeof(int), "FixedRules must mirror every RulesConfig value");
+
+/**
+ * @brief A RulesConfig fixed at compile time: the same values, as static constants of the type.
+ *
+ * Code templated on its rules type reads `rules.coup_cost` the same way from a RulesConfig
+ * (run-time values) and from a FixedRules<R>, whose instantiation folds every value into
+ * the code as an immediate. Game::with_rules picks between the two.
+ */
+template <const RulesConfig &R>
+struct FixedRules {
+    static constexpr int gather_income = R.gather_income;
+    static constexpr int tax_income = R.tax_income;
+    static constexpr int governor_tax = R.governor_tax;
+    static constexpr int bribe_cost = R.bribe_cost;
+    static constexpr int sanction_cost = R.sanction_cost;
+    static constexpr int judge_sanction_extra = R.judge_sanction_extra;
+    static constexpr int coup_cost = R.coup_cost;
+    static constexpr int forced_coup_at = R.forced_coup_at;
+    static constexpr int invest_cost = R.invest_cost;
+    static constexpr int invest_return = R.invest_return;
+    static constexpr int general_undo_cost = R.general_undo_cost;
+    static constexpr int merchant_bonus_at = R.merchant_bonus_at;
+    static constexpr int merchant_bonus = R.merchant_bonus;
+
+    static constexpr const RulesConfig &config() { return R; }
+};
+
+/**
+ * @brief The standard rules as a FixedRules type.
+ */
+using StandardRules = FixedRules<STANDARD_RULES>;
+
+} // namespace coup
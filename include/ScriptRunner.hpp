@@ -0,0 +1,103 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include "Game.hpp"
+#include "GameArena.hpp"
+#include "GameEngine.hpp"
+#include "RulesConfig.hpp"
+
+namespace coup {
+
+/**
+ * @brief Outcome of ScriptRunner::run over one script.
+ */
+struct ScriptResult {
+    size_t commands = 0;     ///< Commands executed, including rejected ones
+    size_t errors = 0;       ///< Rejected or malformed commands
+    size_t error_line = 0;   ///< Line of the first error (0 if none)
+    std::string error;       ///< Message of the first error
+    std::string winner;      ///< Winner's name once the game is over
+
+    bool ok() const { return errors == 0; }
+};
+
+/**
+ * @brief Plays a game from a line protocol, without a display.
+ *
+ * One command per line; blank lines and lines starting with '#' are skipped:
+ *
+ *     add <name> <role>                 seat a player (Governor, Spy, Baron, General, Judge, Merchant)
+ *     <action> <player> [target]        gather, tax, bribe, invest, skip, arrest, sanction, coup
+ *     undo_tax <governor> <target>      out-of-turn abilities
+ *     undo_bribe <judge> <target>
+ *     undo_coup <general> <target>
+ *     peek <spy> <target>
+ *     expect turn <name>                checks, rejected when they do not hold
+ *     expect coins <name> <n>
+ *     expect alive|dead <name>
+ *     expect winner <name>
+ *     show                              writes the turn and every player to the reply stream
+ *     new                               starts a new game
+ *
+ * Commands run against one Game built in a GameArena, which `new` resets, so a batch of
+ * scripts replays back-to-back without reallocating. A rejected command throws the game's
+ * exception (or InvalidActionException for malformed lines) and leaves the game as it was.
+ */
+class ScriptRunner {
+public:
+    /**
+     * @brief Builds the runner's game, which prints its log unless `log` is GameLog::Quiet.
+     */
+    explicit ScriptRunner(const RulesConfig &rules = RulesConfig(), GameLog log = GameLog::Printed);
+
+    ScriptRunner(const ScriptRunner &) = delete;
+    ScriptRunner &operator=(const ScriptRunner &) = delete;
+
+    /**
+     * @brief Sets where command replies go ("ok", query output, "error: ..."); none by default.
+     */
+    void set_reply(std::ostream *out) { reply = out; }
+
+    /**
+     * @brief Runs one command line.
+     * @throws CoupException if the command is malformed or rejected by the game.
+     */
+    void execute(const std::string &line);
+
+    /**
+     * @brief Runs every line of `in`, replying to each if a reply stream is set.
+     * @param stop_on_error Stop at the first rejected command instead of reading on.
+     */
+    ScriptResult run(std::istream &in, bool stop_on_error = true);
+
+    /**
+     * @brief Runs a script held in memory after starting a new game.
+     */
+    ScriptResult run_script(const std::string &script, bool stop_on_error = true);
+
+    /**
+     * @brief Drops every player and starts a new game.
+     */
+    void new_game();
+
+    Game &game() { return current; }
+    const Game &game() const { return current; }
+
+private:
+    void run_ability(const std::string &ability, Player &actor, Player &target);
+    void run_expect(std::istream &words);
+    const PlayerView &view_of(const std::string &name); ///< Captures the game, then finds `name`
+    void show(std::ostream &out);
+
+    GameArena arena;
+    Game current;
+    GameSnapshot view; ///< Reused by the queries, which also work once the game is over
+    std::ostream *reply = nullptr;
+};
+
+} // namespace coup
@@ -0,0 +1,50 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "NameTable.hpp"
+
+namespace coup {
+
+static_assert(MAX_PLAYERS <= 64, "SeatFlags keeps one bit per seat in a uint64_t");
+
+/**
+ * @brief Status flags of every seat of a game: one 64-bit mask per flag, bit i for seat i.
+ *
+ * Questions about all seats become single bit operations: counting alive players is a
+ * popcount and finding the next alive seat is a count-trailing-zeros.
+ */
+struct SeatFlags {
+    uint64_t active = 0;          ///< Alive players
+    uint64_t sanctioned = 0;      ///< Players under sanction
+    uint64_t arrest_disabled = 0; ///< Players blocked from using arrest
+
+    /**
+     * @brief Mask with only `seat`'s bit set.
+     */
+    static constexpr uint64_t bit(size_t seat) { return uint64_t{1} << seat; }
+
+    /**
+     * @brief Number of seats set in `mask`.
+     */
+    static int count(uint64_t mask) { return __builtin_popcountll(mask); }
+
+    /**
+     * @brief Lowest seat set in `mask` (which must not be empty).
+     */
+    static int first(uint64_t mask) { return __builtin_ctzll(mask); }
+
+    /**
+     * @brief First seat set in `mask` after `seat`, wrapping around to the lowest; -1 if none.
+     */
+    static int next_after(uint64_t mask, size_t seat) {
+        if (!mask)
+            return -1;
+        uint64_t later = seat + 1 < 64 ? mask & (~uint64_t{0} << (seat + 1)) : 0;
+        return __builtin_ctzll(later ? later : mask);
+    }
+};
+
+} // namespace coup
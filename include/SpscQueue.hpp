@@ -0,0 +1,65 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace coup {
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * Slots live in a fixed ring; the producer only writes `tail` and the consumer only
+ * writes `head`, so push/pop are a couple of atomic loads/stores and never block.
+ *
+ * @tparam T Element type (must be default-constructible and movable).
+ * @tparam Capacity Number of slots, a power of two.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    /**
+     * @brief Producer side: appends an item.
+     * @return false if the queue is full (the item is left untouched).
+     */
+    bool try_push(T &item) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity)
+            return false;
+        slots[t & (Capacity - 1)] = std::move(item);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side: removes the oldest item.
+     * @return false if the queue is empty.
+     */
+    bool try_pop(T &out) {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+            return false;
+        out = std::move(slots[h & (Capacity - 1)]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Returns true if no items are waiting (exact only on the consumer thread).
+     */
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<T, Capacity> slots;
+    alignas(64) std::atomic<size_t> head{0};  ///< Next slot to pop (written by consumer)
+    alignas(64) std::atomic<size_t> tail{0};  ///< Next slot to push (written by producer)
+};
+
+} // namespace coup
@@ -0,0 +1,105 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "GameEngine.hpp"
+
+namespace coup {
+
+class Game;
+
+/**
+ * @brief One recorded version of a game: immutable, and sharing unchanged parts with its neighbours.
+ *
+ * Each player is an immutable node; a new version points at the previous version's node for
+ * every player that did not change, so a version costs one pointer per seat plus the
+ * players (and coup list) that actually changed.
+ */
+struct TimelineState {
+    using CoupList = std::vector<std::pair<std::string, std::string>>;
+
+    uint64_t snapshot_version = 0;                            ///< GameSnapshot::version it was recorded from
+    int turn = 0;                                             ///< Game::turns_played() at that point
+    std::vector<std::shared_ptr<const PlayerView>> players;   ///< Seat order
+    std::shared_ptr<const CoupList> coup_pending_list;        ///< (attacker, target)
+    int current = -1;
+    bool game_over = false;
+    std::string winner;
+    std::string last_action;
+    int forced_coup_at = 0;
+
+    /**
+     * @brief Writes this version out as a regular snapshot (for drawing).
+     */
+    void materialize(GameSnapshot &out) const;
+};
+
+/**
+ * @brief Every version of one game, indexed by turn, for rewinding and post-game analysis.
+ *
+ * Versions are appended with record() and never change afterwards, so any of them can be
+ * looked at (or handed to another thread) at any time without copying the game.
+ */
+class Timeline {
+public:
+    static constexpr size_t NO_VERSION = static_cast<size_t>(-1);
+
+    /**
+     * @brief Appends the state shown by `snap`.
+     *
+     * A snapshot of an earlier turn than the last one recorded (a reset game) starts the
+     * timeline over.
+     * @return Index of the new version.
+     */
+    size_t record(const GameSnapshot &snap);
+
+    /**
+     * @brief Appends the current state of `game`.
+     */
+    size_t record(const Game &game);
+
+    /**
+     * @brief Drops every version.
+     */
+    void clear();
+
+    size_t size() const { return states.size(); }
+    bool empty() const { return states.empty(); }
+
+    /**
+     * @brief The version at `index` (0 is the oldest).
+     * @throws std::out_of_range if there is no such version.
+     */
+    const TimelineState &at(size_t index) const { return states.at(index); }
+
+    /**
+     * @brief Newest version recorded while `turn` was being played, or NO_VERSION if there is none.
+     *
+     * Turns before the first recorded one have no version; later turns without a version of
+     * their own (none recorded) map to the newest version before them.
+     */
+    size_t version_at_turn(int turn) const;
+
+    /**
+     * @brief Turn of the first and of the newest version (0 and -1 when empty).
+     */
+    int first_turn() const { return states.empty() ? 0 : states.front().turn; }
+    int last_turn() const { return states.empty() ? -1 : states.back().turn; }
+
+    /**
+     * @brief Number of player nodes two versions share.
+     */
+    size_t shared_players(size_t a, size_t b) const;
+
+private:
+    std::vector<TimelineState> states;
+    std::vector<size_t> turn_end; ///< turn - first_turn() -> newest version of that turn
+    GameSnapshot scratch;         ///< Reused by record(const Game &)
+};
+
+} // namespace coup
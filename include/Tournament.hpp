@@ -0,0 +1,158 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Bot.hpp"
+#include "NameTable.hpp"
+#include "Ratings.hpp"
+#include "RulesConfig.hpp"
+
+namespace coup {
+
+/**
+ * @brief A bot policy entered in a tournament.
+ */
+struct PolicySpec {
+    std::string name;                           ///< Name in results and standings
+    BotStrength strength = BotStrength::Random;
+    int think_budget_ms = 2;                    ///< Per-move budget of BotStrength::Search
+
+    /**
+     * @brief Parses "[name=]random", "[name=]greedy" or "[name=]search[:ms]".
+     * @throws InvalidActionException for anything else.
+     */
+    static PolicySpec parse(const std::string &text);
+};
+
+/**
+ * @brief How the policies are seated at tables.
+ */
+enum class Pairing {
+    RoundRobin, // Every combination of policies for a table, in turn
+    Swiss       // Rounds of tables of neighbours in the current standings
+};
+
+struct TournamentConfig {
+    std::vector<PolicySpec> policies;
+    size_t seats = 4;                         ///< Players per game (2 to MAX_PLAYERS)
+    size_t games = 6000;                      ///< Games in the whole tournament
+    Pairing pairing = Pairing::RoundRobin;
+    size_t swiss_rounds = 10;                 ///< Rounds of a Swiss tournament
+    uint32_t seed = 1;                        ///< Seed of game g's bots is derived from seed + g
+    unsigned threads = 1;                     ///< Worker threads playing games
+    int max_turns = 2000;                     ///< Turns after which a game is stopped undecided
+    RulesConfig rules;
+};
+
+/**
+ * @brief Result of one tournament game.
+ */
+struct MatchResult {
+    size_t game = 0;                          ///< Index in the tournament
+    size_t round = 0;                         ///< Swiss round (0 for round-robin)
+    size_t seats = 0;                         ///< Seats used in the arrays below
+    std::array<uint16_t, MAX_PLAYERS> policy{}; ///< Policy index by seat
+    std::array<uint8_t, MAX_PLAYERS> role{};    ///< Index in Tournament::ROLES by seat
+    std::array<int, MAX_PLAYERS> rank{};        ///< Place by seat: 0 for the winner, higher for earlier eliminations
+    int winner = -1;                          ///< Winning seat, or -1 if stopped undecided
+    int turns = 0;
+};
+
+/**
+ * @brief Plays bot policies against each other and rates them.
+ *
+ * Game g is seated from its round's tables: the table cycles fastest, then the rotation
+ * of the policies over the seats, then the rotation of the six roles, so every policy
+ * plays every seat and every role equally often. Games run on a pool of worker threads
+ * in chunks; finished results are applied in game order, so the ratings (and a Swiss
+ * tournament's pairings, taken from the ratings at the end of each round) do not depend
+ * on the thread count. Only BotStrength::Search, which thinks on a time budget, does not
+ * replay exactly.
+ *
+ * Ratings count a game as its winner beating every other seat, the losers tying (an
+ * undecided game is an all-round draw). Elimination order is kept in MatchResult::rank
+ * but not rated: a policy that outlasts others without winning is not playing better.
+ */
+class Tournament {
+public:
+    static const std::array<const char *, 6> ROLES; ///< Roles as accepted by Game::add_player
+
+    using ResultSink = std::function<void(const MatchResult &)>;
+
+    /**
+     * @throws InvalidActionException for fewer than two policies, duplicate policy names, a bad
+     * seat count or invalid rules.
+     */
+    explicit Tournament(TournamentConfig config);
+
+    /**
+     * @brief Plays the whole tournament.
+     * @param sink Called with every result in game order, after the ratings took it in.
+     */
+    void run(const ResultSink &sink = {});
+
+    /**
+     * @brief Plays one game through Game and Bot, with the game log off (games run on worker threads).
+     * @param policy Policy index by seat.
+     * @param role Index in ROLES by seat.
+     * @param seed Seeds the seats' bots.
+     */
+    MatchResult play_match(const std::vector<size_t> &policy, const std::vector<size_t> &role, uint32_t seed) const;
+
+    /**
+     * @brief Policy tables of a round-robin: every multiset of `seats` policies, except a
+     * policy alone at its table.
+     */
+    static std::vector<std::vector<size_t>> round_robin_tables(size_t policies, size_t seats);
+
+    /**
+     * @brief Policy tables of a Swiss round: consecutive groups of `seats` in `standings`
+     * (best first), the last one filled up from the top.
+     */
+    static std::vector<std::vector<size_t>> swiss_tables(const std::vector<size_t> &standings, size_t seats);
+
+    /**
+     * @brief Policy indices from best to worst by conservative TrueSkill.
+     */
+    std::vector<size_t> standings() const;
+
+    const TournamentConfig &config() const { return settings; }
+    const EloRatings &elo() const { return elo_ratings; }
+    const TrueSkillRatings &trueskill() const { return trueskill_ratings; }
+    uint64_t games_played(size_t policy) const { return played[policy]; }
+    uint64_t wins(size_t policy) const { return won[policy]; }
+
+    /**
+     * @brief Writes the CSV header of write_result rows.
+     */
+    void write_header(std::ostream &out) const;
+
+    /**
+     * @brief Writes one result as a CSV row: game, round, policy and role of each seat,
+     * winning policy and turns.
+     */
+    void write_result(std::ostream &out, const MatchResult &result) const;
+
+    /**
+     * @brief Writes the standings as CSV: games, wins, Elo with its 95% interval, TrueSkill.
+     */
+    void write_standings(std::ostream &out) const;
+
+private:
+    TournamentConfig settings;
+    EloRatings elo_ratings;
+    TrueSkillRatings trueskill_ratings;
+    std::vector<uint64_t> played;
+    std::vector<uint64_t> won;
+
+    void record(const MatchResult &result);
+};
+
+} // namespace coup
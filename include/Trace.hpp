@@ -0,0 +1,120 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace coup {
+
+/**
+ * @brief Latency spans of game actions, for finding where a slow turn spends its time.
+ *
+ * Tracing is off until enable() is called; a disabled span costs one relaxed load. An
+ * enabled span reads the time stamp counter twice and writes one event into its thread's
+ * ring buffer, which keeps the newest RING_EVENTS events and overwrites older ones.
+ * Rings are allocated on a thread's first span and kept after the thread ends.
+ *
+ * write_chrome_json() exports every ring in the Chrome trace-event format, which
+ * chrome://tracing and Perfetto open directly. Building with -DCOUP_NO_TRACE removes the
+ * spans altogether.
+ */
+class Tracer {
+public:
+    static constexpr size_t RING_EVENTS = size_t{1} << 14;
+
+    static void enable(bool on = true) { active.store(on, std::memory_order_relaxed); }
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Current time stamp: the TSC on x86, steady_clock nanoseconds elsewhere.
+     */
+    static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    /**
+     * @brief Time stamp ticks per microsecond (measured once, on first use).
+     */
+    static double ticks_per_us();
+
+    /**
+     * @brief Adds a finished span to the calling thread's ring.
+     * @param name Static string naming the span (it is kept by pointer).
+     */
+    static void record(const char *name, uint64_t begin, uint64_t end);
+
+    /**
+     * @brief Events currently kept in all rings.
+     */
+    static size_t events();
+
+    /**
+     * @brief Drops the events of every ring; threads may keep tracing meanwhile.
+     *
+     * Each ring only moves its start up to the events written so far: the write position
+     * stays with the owning thread, so clearing never races with record().
+     */
+    static void clear();
+
+    /**
+     * @brief Writes every kept event as Chrome trace-event JSON (complete "X" events, in microseconds).
+     */
+    static void write_chrome_json(std::ostream &out);
+
+    /**
+     * @brief Writes write_chrome_json() to `path`.
+     * @return false if the file could not be written.
+     */
+    static bool dump(const std::string &path);
+
+private:
+    static inline std::atomic<bool> active{false};
+};
+
+/**
+ * @brief Records the time from its construction to its destruction as one span.
+ */
+class TraceSpan {
+public:
+    explicit TraceSpan(const char *span_name)
+        : name(Tracer::enabled() ? span_name : nullptr), begin(name ? Tracer::now() : 0) {}
+
+    ~TraceSpan() {
+        if (name)
+            Tracer::record(name, begin, Tracer::now());
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    const char *name;
+    uint64_t begin;
+};
+
+} // namespace coup
+
+#define COUP_TRACE_JOIN2(a, b) a##b
+#define COUP_TRACE_JOIN(a, b) COUP_TRACE_JOIN2(a, b)
+
+#ifdef COUP_NO_TRACE
+#define COUP_TRACE_SPAN(name) ((void)0)
+#else
+/**
+ * @brief Traces the rest of the enclosing scope under `name` (a string literal).
+ */
+#define COUP_TRACE_SPAN(name) ::coup::TraceSpan COUP_TRACE_JOIN(coup_trace_span_, __LINE__)(name)
+#endif
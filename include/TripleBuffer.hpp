@@ -0,0 +1,52 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <atomic>
+
+namespace coup {
+
+/**
+ * @brief Lock-free triple buffer passing the latest value from one writer to one reader.
+ *
+ * The writer fills back() and publish()es it; the reader acquire()s the newest published
+ * value. Neither side ever waits: the three buffers are owned by the writer, the reader,
+ * and the shared "middle" slot, and ownership moves with a single atomic exchange.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    /**
+     * @brief Writer side: the buffer to fill before the next publish().
+     */
+    T &back() { return buffers[back_index]; }
+
+    /**
+     * @brief Writer side: makes back() the newest value and takes another buffer to write.
+     */
+    void publish() {
+        back_index = middle.exchange(back_index | DIRTY, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /**
+     * @brief Reader side: returns the newest published value.
+     *
+     * The returned reference stays valid and unchanged until the next acquire().
+     */
+    const T &acquire() {
+        if (middle.load(std::memory_order_relaxed) & DIRTY)
+            front_index = middle.exchange(front_index, std::memory_order_acq_rel) & INDEX_MASK;
+        return buffers[front_index];
+    }
+
+private:
+    static constexpr unsigned DIRTY = 4;       ///< Set when middle holds an unread value
+    static constexpr unsigned INDEX_MASK = 3;
+
+    T buffers[3];
+    std::atomic<unsigned> middle{1};
+    unsigned back_index = 0;   ///< Writer-owned
+    unsigned front_index = 2;  ///< Reader-owned
+};
+
+} // namespace coup
@@ -0,0 +1,353 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Bot.hpp"
+
+namespace coup {
+
+class Game;
+class Player;
+
+/**
+ * @brief One action a player takes in its turn, as chosen by an ActionSource.
+ */
+struct TurnAction {
+    enum class Kind { Gather, Tax, Bribe, Invest, Arrest, Sanction, Coup, Skip };
+
+    Kind kind = Kind::Skip;
+    std::string target; ///< Target name for Arrest / Sanction / Coup
+
+    bool needs_target() const { return kind == Kind::Arrest || kind == Kind::Sanction || kind == Kind::Coup; }
+
+    /**
+     * @brief Returns the text form, such as "tax" or "coup bob".
+     */
+    std::string describe() const;
+
+    /**
+     * @brief Parses the text form ("gather", "tax", "bribe", "invest", "skip", "arrest <name>",
+     * "sanction <name>", "coup <name>").
+     * @throws InvalidActionException for anything else.
+     */
+    static TurnAction parse(const std::string &text);
+
+    /**
+     * @brief Converts a bot's move.
+     */
+    static TurnAction from(const BotMove &move);
+
+    bool operator==(const TurnAction &other) const { return kind == other.kind && target == other.target; }
+};
+
+/**
+ * @brief Performs `action` for `actor` through the regular Player API.
+ * @throws Whatever the action throws if it is illegal.
+ */
+void apply_action(Game &game, Player &actor, const TurnAction &action);
+
+// ======================
+// Futures
+// ======================
+
+/**
+ * @brief A TurnAction that may not be known yet: what a turn driver waits on.
+ *
+ * Filled once by its ActionPromise, from any thread. A continuation registered with
+ * then() runs exactly once, on the thread that fills the action (or at once if it is
+ * already there).
+ */
+class ActionFuture {
+public:
+    ActionFuture() = default;
+
+    /**
+     * @brief A future that is ready with `action`.
+     */
+    static ActionFuture ready(TurnAction action);
+
+    bool valid() const { return state != nullptr; }
+    bool is_ready() const;
+
+    /**
+     * @brief The action; only once is_ready().
+     */
+    TurnAction get() const;
+
+    /**
+     * @brief Runs `wake` once the action is there.
+     */
+    void then(std::function<void()> wake);
+
+private:
+    friend class ActionPromise;
+
+    struct State {
+        std::mutex lock;
+        std::optional<TurnAction> action;
+        std::function<void()> wake;
+    };
+
+    std::shared_ptr<State> state;
+};
+
+/**
+ * @brief The writing end of an ActionFuture.
+ */
+class ActionPromise {
+public:
+    ActionPromise();
+
+    ActionFuture future() const;
+
+    /**
+     * @brief Fills the action and wakes the waiting driver.
+     * @throws InvalidActionException if it was already filled.
+     */
+    void set(TurnAction action);
+
+    bool fulfilled() const;
+
+private:
+    std::shared_ptr<ActionFuture::State> state;
+};
+
+// ======================
+// Action Sources
+// ======================
+
+/**
+ * @brief Whoever picks a seat's actions: a bot, a person behind a GUI or a network, a replay.
+ *
+ * The driver asks for one action at a time and does not touch the game until the future
+ * is ready, so a source may read the game (for instance from another thread) while it
+ * decides.
+ */
+class ActionSource {
+public:
+    virtual ~ActionSource() = default;
+
+    /**
+     * @brief Starts choosing the next action of `self`, whose turn it is.
+     */
+    virtual ActionFuture choose_action(const Game &game, const Player &self) = 0;
+
+    /**
+     * @brief Called when the game accepted the chosen action.
+     */
+    virtual void accepted(const Player &self, const TurnAction &action);
+
+    /**
+     * @brief Called when the game rejected the chosen action.
+     * @return true to be asked again, false to stop the game with the error.
+     */
+    virtual bool rejected(const Player &self, const TurnAction &action, const std::string &why);
+};
+
+/**
+ * @brief Fixed worker threads running queued jobs, for bots that think off the driver's thread.
+ */
+class WorkerPool {
+public:
+    explicit WorkerPool(unsigned threads = std::max(1u, std::thread::hardware_concurrency()));
+
+    /**
+     * @brief Finishes the queued jobs and joins the workers.
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    void post(std::function<void()> job);
+
+private:
+    std::mutex lock;
+    std::condition_variable wake;
+    std::deque<std::function<void()>> jobs;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+};
+
+/**
+ * @brief A Bot picking the actions; it thinks on a WorkerPool if given one, else at once.
+ *
+ * A rejected move is not chosen again in the same turn: the remaining candidates are
+ * tried in order, as Bot::play_turn does.
+ */
+class BotSource : public ActionSource {
+public:
+    explicit BotSource(Bot bot, WorkerPool *pool = nullptr);
+
+    ActionFuture choose_action(const Game &game, const Player &self) override;
+    void accepted(const Player &self, const TurnAction &action) override;
+    bool rejected(const Player &self, const TurnAction &action, const std::string &why) override;
+
+private:
+    Bot bot;
+    WorkerPool *pool;
+    std::vector<TurnAction> refused; ///< Moves rejected in the current turn
+
+    TurnAction decide(const Game &game, const Player &self);
+};
+
+/**
+ * @brief Actions handed in from outside (a GUI click, a network message) with submit().
+ */
+class ManualSource : public ActionSource {
+public:
+    ActionFuture choose_action(const Game &game, const Player &self) override;
+    bool rejected(const Player &self, const TurnAction &action, const std::string &why) override;
+
+    /**
+     * @brief True while the driver waits for this source.
+     */
+    bool waiting() const;
+
+    /**
+     * @brief Hands in the awaited action.
+     * @throws InvalidActionException if the driver is not waiting for one.
+     */
+    void submit(TurnAction action);
+
+    /**
+     * @brief Why the last submitted action was rejected ("" if it was not).
+     */
+    std::string last_error() const;
+
+private:
+    mutable std::mutex lock;
+    std::optional<ActionPromise> pending;
+    std::string error;
+};
+
+/**
+ * @brief Actions read from a recorded game, one TurnAction::parse line at a time.
+ *
+ * Blank lines and lines starting with '#' are skipped. A rejected action, or running
+ * out of lines, stops the game.
+ */
+class ReplaySource : public ActionSource {
+public:
+    explicit ReplaySource(std::vector<std::string> lines);
+
+    /**
+     * @brief Reads the lines of `in`.
+     */
+    static ReplaySource from_stream(std::istream &in);
+
+    ActionFuture choose_action(const Game &game, const Player &self) override;
+    bool rejected(const Player &self, const TurnAction &action, const std::string &why) override;
+
+    size_t remaining() const { return lines.size() - next; }
+
+private:
+    std::vector<std::string> lines;
+    size_t next = 0;
+};
+
+// ======================
+// Driver
+// ======================
+
+class TurnExecutor;
+
+/**
+ * @brief Plays one game to its end, asking each seat's ActionSource for its actions.
+ *
+ * This is the game's turn loop written as a resumable task: resume() plays actions until
+ * one has to be waited for, then returns instead of blocking, and the executor resumes it
+ * once the action arrives. Illegal actions go back to their source, which decides whether
+ * to try again.
+ */
+class GameTask {
+public:
+    enum class Status {
+        Ready,    // Can make progress
+        Waiting,  // Waiting for a source's action
+        Finished, // The game is over, or max_actions were played
+        Failed    // A source gave up on a rejected action, or ran out
+    };
+
+    /**
+     * @param sources Source of each seat, in seat order (not owned).
+     * @param max_actions Actions after which the task stops (the game stays undecided).
+     */
+    GameTask(Game &game, std::vector<ActionSource *> sources, int max_actions = 10000);
+
+    /**
+     * @brief Plays until an action must be waited for or the game ends.
+     */
+    Status resume();
+
+    Status status() const { return current; }
+    bool done() const { return current == Status::Finished || current == Status::Failed; }
+    const std::string &error() const { return failure; }
+    int actions() const { return played; }
+    Game &game() const { return table; }
+
+private:
+    friend class TurnExecutor;
+
+    Game &table;
+    std::vector<ActionSource *> seats;
+    int max_actions;
+    int played = 0;
+    Status current = Status::Ready;
+    std::string failure;
+    ActionFuture awaited;
+    size_t awaited_seat = 0;
+    TurnExecutor *executor = nullptr;
+};
+
+/**
+ * @brief Runs many GameTasks on one thread, resuming each when its action arrives.
+ *
+ * A task waiting on a slow source costs nothing until the source fills its future (from
+ * any thread), which puts the task back in the ready queue.
+ */
+class TurnExecutor {
+public:
+    /**
+     * @brief Adds a task (not owned; it must outlive the executor's use of it).
+     */
+    void spawn(GameTask &task);
+
+    /**
+     * @brief Resumes every task that is ready now, without waiting.
+     * @return Number of tasks resumed.
+     */
+    size_t run_ready();
+
+    /**
+     * @brief Runs until every spawned task is done, sleeping while all of them wait.
+     */
+    void run();
+
+    /**
+     * @brief Tasks spawned and not done yet.
+     */
+    size_t active() const;
+
+private:
+    friend class GameTask;
+
+    mutable std::mutex lock;
+    std::condition_variable woken;
+    std::deque<GameTask *> ready;
+    size_t live = 0;
+
+    void wake(GameTask &task);
+};
+
+} // namespace coup
@@ -0,0 +1,106 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace coup {
+
+/**
+ * @brief GUI code regions measured by FrameProfiler::Scope.
+ */
+enum class ProfileSection {
+    HandleEvents,            // GUI::handleEvents
+    Render,                  // GUI::render (including renders triggered from event handlers)
+    SpecialButtonsPanel,     // GUI::drawSpecialButtonsPanel
+    TargetSelectionButtons,  // GUI::drawTargetSelectionButtons
+    Count
+};
+
+/**
+ * @brief Lightweight per-frame timing and counting for the GUI.
+ *
+ * Each frame records its total time, the time spent in every ProfileSection and
+ * counters for draw calls, text objects created and game queries. The last frames
+ * are kept in a fixed-size ring buffer used by the on-screen overlay and CSV export.
+ */
+class FrameProfiler {
+public:
+    static constexpr size_t SECTION_COUNT = static_cast<size_t>(ProfileSection::Count);
+
+    /**
+     * @brief Statistics of a single frame.
+     */
+    struct Sample {
+        double frame_ms = 0;                    ///< Wall time of the whole frame
+        double section_ms[SECTION_COUNT] = {};  ///< Wall time per section (sections may nest)
+        unsigned draw_calls = 0;                ///< window.draw calls
+        unsigned texts_created = 0;             ///< sf::Text objects constructed
+        unsigned game_queries = 0;              ///< Game state (snapshot) reads
+    };
+
+    /**
+     * @brief RAII timer adding its lifetime to a section of the current frame.
+     */
+    class Scope {
+    public:
+        Scope(FrameProfiler &profiler, ProfileSection section);
+        ~Scope();
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        FrameProfiler &profiler;
+        ProfileSection section;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * @brief Creates a profiler remembering the last `capacity` frames.
+     */
+    explicit FrameProfiler(size_t capacity = 4096);
+
+    void begin_frame();  ///< Starts timing a new frame and resets its counters
+    void end_frame();    ///< Stores the current frame in the history
+
+    void count_draw() { ++current.draw_calls; }      ///< Records one draw call
+    void count_text() { ++current.texts_created; }   ///< Records one sf::Text construction
+    void count_query() { ++current.game_queries; }   ///< Records one game query
+
+    /**
+     * @brief Returns the number of frames stored in the history.
+     */
+    size_t size() const { return count; }
+
+    /**
+     * @brief Returns a stored frame by age (0 = most recent completed frame).
+     */
+    const Sample &recent(size_t age) const;
+
+    /**
+     * @brief Returns the average frames per second over the last `frames` frames.
+     */
+    double average_fps(size_t frames = 60) const;
+
+    /**
+     * @brief Writes the stored frames (oldest first) to a CSV file.
+     * @return true if the file was written.
+     */
+    bool export_csv(const std::string &path) const;
+
+    void toggle_overlay() { overlay = !overlay; }   ///< Shows/hides the on-screen overlay
+    bool overlay_visible() const { return overlay; }
+
+private:
+    std::vector<Sample> history;  ///< Ring buffer of completed frames
+    size_t head = 0;              ///< Next slot to write
+    size_t count = 0;             ///< Number of valid samples
+    Sample current;               ///< Frame being recorded
+    std::chrono::steady_clock::time_point frame_start;
+    bool overlay = false;
+};
+
+} // namespace coup
@@ -3,7 +3,15 @@
 #pragma once
 
 #include "../Game.hpp"
+#include "../GameEngine.hpp"
+#include "../Bot.hpp"
+#include "../TurnDriver.hpp"
+#include "../Timeline.hpp"
+#include "HitRegistry.hpp"
+#include "FrameProfiler.hpp"
 #include <SFML/Graphics.hpp>
+#include <chrono>
+#include <map>
 #include <memory>
 #include <string>
 #include <optional>
@@ -20,32 +28,25 @@ enum class GUIState {
     Playing  // Active game screen
 };
 
-enum class PendingTargetAction {
-    None,
-    Arrest,
-    Sanction,
-    Coup
-};
-
 // ====== GUI Class ======
 
 class GUI {
 public:
     // --- Constructor and Run Loop ---
-    GUI(Game &game);     ///< Initializes GUI with reference to game
+    GUI(Game &game);     ///< Initializes GUI and starts the engine thread driving the game
     void run();          ///< Main event/render loop
 
 private:
     // --- Game & SFML References ---
-    Game &game;                            ///< Reference to game logic
+    GameEngine engine;                     ///< Runs the game on its own thread
+    const GameSnapshot *snapshot = nullptr; ///< Game state for the current frame
     sf::RenderWindow window;              ///< Main SFML window
     sf::Font font;                        ///< Loaded font
     sf::RectangleShape input_box;         ///< Input field rectangle
 
     // --- Game State Tracking ---
     GUIState state = GUIState::Setup;
-    PendingTargetAction pending_target_action = PendingTargetAction::None;
-    sf::FloatRect persistent_new_game_button;
+    std::optional<TurnAction::Kind> pending_target; ///< Target action waiting for its target click
 
     // --- Input State ---
     std::string name_input;               ///< Current name being typed
@@ -54,16 +55,45 @@ private:
     std::string info_message;             ///< Info message to show user
 
     // --- UI Button Interaction ---
-    std::vector<std::pair<sf::FloatRect, std::string>> action_buttons_bounds; // Action buttons with labels
-    std::vector<sf::FloatRect> target_button_bounds;                          // Target button hitboxes
-    std::vector<std::string> current_target_names;                            // Names of current target candidates
+    HitRegistry hits;                                  // Widgets drawn in the last frame, for hit-testing
+    std::vector<std::string> action_labels;            // Labels of action buttons (ActionButton index)
+    std::vector<size_t> current_targets;               // Snapshot seats of current target candidates (TargetButton index)
 
     struct SpecialButtonInfo {
-        sf::FloatRect bounds;
         std::string player_name;
         std::string role;
     };
-    std::vector<SpecialButtonInfo> special_buttons_positions;                 // e.g., Undo Tax buttons
+    std::vector<SpecialButtonInfo> special_buttons_positions; // e.g., Undo Tax buttons (SpecialButton index)
+
+    // --- Bots ---
+    std::map<std::string, std::shared_ptr<Bot>> bots;  ///< Bot-controlled players by name (used on the engine thread)
+
+    struct PendingBot {
+        std::string name;
+        std::shared_ptr<Bot> bot;
+    };
+    std::map<uint64_t, PendingBot> pending_bots;       ///< Bots whose add command has no result yet, by command id
+    BotStrength bot_strength = BotStrength::Greedy;    ///< Strength for the next "Add Bot"
+    int bot_delay_ms = 500;                            ///< Pause before a bot starts its move
+    uint64_t bot_command = 0;                          ///< Bot move in flight (0 if none)
+    uint64_t bot_turn_version = 0;                     ///< Snapshot version the delay was started for
+    std::chrono::steady_clock::time_point bot_turn_since;   ///< When the current bot turn was first seen
+    std::chrono::steady_clock::time_point bot_submitted_at; ///< When bot_command was submitted
+    double last_bot_latency_ms = -1;                   ///< Submit-to-result time of the last bot move
+
+    // --- Commands Awaiting a Result ---
+    uint64_t target_command = 0;          ///< Last Arrest/Sanction/Coup command
+    uint64_t peek_command = 0;            ///< Last Spy peek command
+    PlayerView peek_target;               ///< Target of peek_command (shown in the result popup)
+
+    // --- Timeline ---
+    Timeline timeline;                    ///< Every published version of the game, by turn
+    uint64_t recorded_version = 0;        ///< Newest snapshot version in the timeline
+    std::optional<int> scrub_turn;        ///< Turn being looked back at (empty: live game)
+    GameSnapshot scrubbed;                ///< Version of scrub_turn, materialized for drawing
+
+    // --- Profiling ---
+    FrameProfiler profiler;                            // Frame timings/counters (F3 overlay, F12 CSV export)
 
     // =============================
     // === RENDERING FUNCTIONS ===
@@ -71,12 +101,14 @@ private:
 
     void render();                                             ///< Main rendering logic
     void drawSetupScreen();                                    ///< Render setup screen (name + role)
-    void drawPlayerPanel(const std::shared_ptr<Player>);       ///< Info panel for current player
-    void drawActionButtons(const std::shared_ptr<Player>);     ///< Draw gather/tax/bribe/etc buttons
+    void drawPlayerPanel(const PlayerView &player);            ///< Info panel for current player
+    void drawActionButtons(const PlayerView &player);          ///< Draw gather/tax/bribe/etc buttons
     void drawSpecialButtonsPanel();                            ///< Draw spy/governor/judge action buttons
-    void drawSpecialActionButton(const std::shared_ptr<Player> player); ///< (Unused but declared)
     void drawTurnInfo();                                       ///< Show info/error boxes
     void drawTargetSelectionButtons();                         ///< Draw buttons for selecting target
+    void drawProfilerOverlay();                                ///< Frame statistics and frame-time histogram
+    void drawBotStatus(const PlayerView &player);              ///< "Thinking" indicator during a bot's turn
+    void drawTimelineBar();                                    ///< Turn scrubber: back / forward / live
 
     // =============================
     // === EVENT & LOGIC HANDLERS ===
@@ -84,25 +116,33 @@ private:
 
     void handleEvents();                                       ///< Poll and handle all SFML events
     void handleSetupInput(const sf::Event &event);             ///< Handle typing and clicks during setup
-    bool handleGlobalButtons(const sf::Vector2i &mouse);       ///< Check global buttons (e.g., New Game)
-    bool handleSpecialButtonClick(const sf::Vector2i &mouse, std::shared_ptr<Player> current); ///< Spy/Governor etc
-    bool handleTargetActionClick(const sf::Vector2i &mouse, std::shared_ptr<Player> current);  ///< Coup/Arrest/Sanction
-    bool handleBasicActionClick(const sf::Vector2i &mouse, std::shared_ptr<Player> current);   ///< Gather/Tax/etc
+    bool handleGlobalButtons(const HitRegistry::Hit &hit);     ///< Check global buttons (e.g., New Game)
+    bool handleSpecialButtonClick(const HitRegistry::Hit &hit, const PlayerView &current); ///< Spy/Governor etc
+    bool handleTargetActionClick(const HitRegistry::Hit &hit, const PlayerView &current);  ///< Coup/Arrest/Sanction
+    bool handleBasicActionClick(const HitRegistry::Hit &hit, const PlayerView &current);   ///< Gather/Tax/etc
+    void applyCommandResults();                                ///< Show results reported by the engine
+    void updateBots();                                         ///< Start the move of a bot in turn once its delay passed
+    bool handleTimelineButtons(const HitRegistry::Hit &hit);   ///< Scrubber clicks
+    void recordTimeline();                                     ///< Add the frame's snapshot to the timeline
+    void scrubTo(std::optional<int> turn);                     ///< Show an earlier turn (empty: back to live)
 
     // =============================
     // === GAME STATE HELPERS ===
     // =============================
 
     bool tryCreateAndAddPlayer(const std::string &name, const std::string &role); ///< Attempts to add a new player
+    bool tryAddBot(const std::string &role);                                      ///< Adds a bot with the selected strength
+    bool isBot(const std::string &name) const;                                    ///< True if the player is bot-controlled
     void handle_gui_exception(const std::exception &e);                           ///< Convert exception to message
+    void handle_gui_error(const std::string &msg);                                ///< Show an error (GUI or engine)
 
     // =============================
     // === POPUPS / MODALS ===
     // =============================
 
     static void show_peek_result_popup(const std::string &role, int coins); ///< Spy peek popup
-    static std::shared_ptr<Player> show_selection_popup(
-        const std::vector<std::shared_ptr<Player>> &targets,
+    static const PlayerView *show_selection_popup(
+        const std::vector<PlayerView> &targets,
         const std::string &title,
         const sf::Color &button_color); ///< Show list of player buttons
 
@@ -111,8 +151,9 @@ private:
     // =============================
 
     void drawText(const std::string &str, float x, float y, unsigned size = 20, sf::Color color = sf::Color::White); ///< Draw text
+    void drawItem(const sf::Drawable &item);                                                                         ///< Counted window.draw
+    const GameSnapshot &view();                                                                                     ///< Counted read of the frame's snapshot
     static sf::RectangleShape createButton(float x, float y, float w, float h, const sf::Color &color);             ///< Make button
-    static bool isMouseOver(const sf::RectangleShape &rect, sf::Vector2i mousePos);                                 ///< Check hit
 };
 
 } // namespace coup
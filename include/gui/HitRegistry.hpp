@@ -0,0 +1,88 @@
+// Anksilae@gmail.com
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace coup {
+
+/**
+ * @brief Kinds of clickable widgets the GUI registers while drawing.
+ */
+enum class WidgetKind {
+    None,          // Nothing under the cursor
+    RoleButton,    // Setup screen: role selector (index = role slot)
+    AddPlayer,     // Setup screen: "Add Player"
+    StartGame,     // Setup screen: "Start Game"
+    AddBot,        // Setup screen: "Add Bot"
+    BotLevel,      // Setup screen: bot strength selector
+    BotDelay,      // Setup screen: bot move delay selector
+    NewGame,       // "New Game" / "Start New Game" button
+    ActionButton,  // Gather / Tax / Arrest ... (index into action labels)
+    TargetButton,  // Target selection (index into current target names)
+    SpecialButton, // Out-of-turn role ability (index into special buttons)
+    TimelineButton // Turn scrubber (0 = back, 1 = forward, 2 = live)
+};
+
+/**
+ * @brief Uniform-grid spatial index of the widgets drawn in the last frame.
+ *
+ * Drawing code registers each button's bounds once while laying it out, and event code
+ * asks which widget lies under the cursor. Every grid cell keeps the (few) widgets that
+ * overlap it, so a lookup inspects a single cell instead of walking every button list.
+ */
+class HitRegistry {
+public:
+    /**
+     * @brief Result of a hit test: which widget was hit and its per-kind index.
+     */
+    struct Hit {
+        WidgetKind kind = WidgetKind::None;
+        int index = -1;
+    };
+
+    /**
+     * @brief Creates an empty registry covering a width x height area.
+     * @param width Width of the covered area in pixels.
+     * @param height Height of the covered area in pixels.
+     * @param cell_size Side of a grid cell in pixels.
+     */
+    HitRegistry(unsigned width, unsigned height, unsigned cell_size = 64);
+
+    /**
+     * @brief Forgets all widgets (called at the start of every frame's layout).
+     */
+    void clear();
+
+    /**
+     * @brief Registers a widget. Widgets added later are considered on top.
+     * @param kind The widget kind.
+     * @param index Per-kind index used by the event handlers.
+     * @param bounds Screen-space bounds of the widget.
+     */
+    void add(WidgetKind kind, int index, const sf::FloatRect &bounds);
+
+    /**
+     * @brief Returns the top-most widget containing the given point.
+     */
+    Hit hit(sf::Vector2i pos) const;
+
+private:
+    struct Entry {
+        WidgetKind kind;
+        int index;
+        sf::FloatRect bounds;
+    };
+
+    unsigned cell_size;
+    unsigned cols;
+    unsigned rows;
+    std::vector<Entry> entries;                     ///< Widgets in registration order
+    std::vector<std::vector<std::uint16_t>> cells;  ///< Per cell: indices into entries
+
+    int cell_index(int col, int row) const { return row * static_cast<int>(cols) + col; }
+};
+
+} // namespace coup
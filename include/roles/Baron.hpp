@@ -24,9 +24,14 @@ public:
     std::string role() const override;
 
     /**
-     * @brief Baron's unique action — invest during their turn to gain 3 coins (net profit).
+     * @brief Checks invest here and every other action as Player::check does.
+     */
+    Refusal check(StatAction action, const Player *target = nullptr) const override;
+
+    /**
+     * @brief Baron's unique action — invest during their turn to gain 3 coins (net profit, with the default RulesConfig).
      * 
-     * Requires at least 3 coins to activate.
+     * Requires at least RulesConfig::invest_cost coins to activate.
      */
     void invest();
 
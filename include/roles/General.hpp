@@ -24,7 +24,12 @@ public:
     std::string role() const override;
 
     /**
-     * @brief Cancels a coup performed against a player (including self) at a cost of 5 coins.
+     * @brief Checks undo_coup here and every other action as Player::check does.
+     */
+    Refusal check(StatAction action, const Player *target = nullptr) const override;
+
+    /**
+     * @brief Cancels a coup performed against a player (including self) at a cost of RulesConfig::general_undo_cost coins (5 by default).
      * 
      * Can only be used once per round.
      * @param target The player whose coup should be undone.
@@ -24,7 +24,12 @@ public:
     std::string role() const override;
 
     /**
-     * @brief Special tax action — takes 3 coins instead of 2.
+     * @brief Checks undo_tax here and every other action as Player::check does.
+     */
+    Refusal check(StatAction action, const Player *target = nullptr) const override;
+
+    /**
+     * @brief Special tax action — takes RulesConfig::governor_tax coins instead of tax_income (3 instead of 2 by default).
      * @throws NotYourTurnException or InvalidActionException if invalid.
      */
     void tax() override;
@@ -23,6 +23,11 @@ public:
      */
     std::string role() const override;
 
+    /**
+     * @brief Checks undo_bribe here and every other action as Player::check does.
+     */
+    Refusal check(StatAction action, const Player *target = nullptr) const override;
+
     /**
      * @brief Cancels a bribe action performed by another player and restores its cost.
      * 
@@ -24,7 +24,7 @@ public:
     std::string role() const override;
 
     /**
-     * @brief Grants 1 bonus coin at the start of the turn if the Merchant has at least 3 coins.
+     * @brief Grants RulesConfig::merchant_bonus coins at the start of the turn if the Merchant has at least merchant_bonus_at.
      */
     void on_turn_start() override;
 };
@@ -28,6 +28,11 @@ public:
      */
     std::string role() const override;
 
+    /**
+     * @brief Checks peek_and_disable here and every other action as Player::check does.
+     */
+    Refusal check(StatAction action, const Player *target = nullptr) const override;
+
     /**
      * @brief Peeks at the target player's role and coins, and disables their ability to arrest on the next turn.
      * 
@@ -0,0 +1,164 @@
+// ActionFuzzer.cpp - Byte streams played as games, with invariant checks
+// Anksilae@gmail.com
+
+#include "ActionFuzzer.hpp"
+#include "Baron.hpp"
+#include "Exceptions.hpp"
+#include "General.hpp"
+#include "Governor.hpp"
+#include "Judge.hpp"
+#include "Spy.hpp"
+
+namespace coup {
+
+namespace {
+
+const std::string ROLES[] = {"Governor", "Spy", "Baron", "General", "Judge", "Merchant"};
+const std::string NAMES[] = {"p0", "p1", "p2", "p3", "p4", "p5"};
+
+static_assert(ActionFuzzer::MAX_SEATS <= sizeof(NAMES) / sizeof(NAMES[0]), "a name for every seat");
+
+enum Op : uint8_t {
+    Gather, Tax, Bribe, Invest, Arrest, Sanction, Coup, Skip,
+    UndoTax, UndoBribe, UndoCoup, Peek,
+    Tax2, Coup2, Gather2, Arrest2
+};
+
+const char *const OP_NAMES[] = {
+    "gather", "tax", "bribe", "invest", "arrest", "sanction", "coup", "skip",
+    "undo_tax", "undo_bribe", "undo_coup", "peek", "tax", "coup", "gather", "arrest",
+};
+
+const StatAction OP_ACTIONS[] = {
+    StatAction::Gather, StatAction::Tax, StatAction::Bribe, StatAction::Invest,
+    StatAction::Arrest, StatAction::Sanction, StatAction::Coup, StatAction::Skip,
+    StatAction::UndoTax, StatAction::UndoBribe, StatAction::UndoCoup, StatAction::PeekAndDisable,
+    StatAction::Tax, StatAction::Coup, StatAction::Gather, StatAction::Arrest,
+};
+
+constexpr uint8_t OWN_SEAT = 0x10;
+constexpr uint8_t PLAY_REFUSED = 0xE0; ///< arg bits that play a step check() refuses
+
+} // namespace
+
+std::string check_invariants(const Game &game) {
+    const auto &players = game.get_all_players_raw();
+    for (const Player *p : players)
+        if (p->coins() < 0)
+            return p->get_name() + " has " + std::to_string(p->coins()) + " coins";
+
+    const int alive = game.alive_count();
+    if (game.is_game_over() != (alive == 1))
+        return "game over is " + std::string(game.is_game_over() ? "set" : "not set") + " with " +
+               std::to_string(alive) + " players alive";
+
+    if (!game.is_game_over()) {
+        const int seat = game.get_current_turn_index();
+        if (seat < 0 || static_cast<size_t>(seat) >= players.size())
+            return "turn index " + std::to_string(seat) + " is not a seat";
+        if (!players[seat]->is_active())
+            return "the player in turn (" + players[seat]->get_name() + ") is eliminated";
+    }
+
+    const auto &attackers = game.get_coup_attackers();
+    for (PlayerId target = 0; target < MAX_PLAYERS; ++target) {
+        if (attackers[target] == NO_PLAYER)
+            continue;
+        const Player *victim = game.get_player_by_id(target);
+        if (!victim)
+            return "a pending coup targets no player";
+        if (victim->is_active())
+            return "a pending coup targets " + victim->get_name() + ", who is alive";
+    }
+    return "";
+}
+
+ActionFuzzer::ActionFuzzer() : current(arena, RulesConfig(), GameLog::Quiet) {}
+
+FuzzStats ActionFuzzer::run(const uint8_t *data, size_t size, std::string &broken) {
+    FuzzStats stats;
+    broken.clear();
+    current.reset();
+    if (size == 0)
+        return stats;
+
+    const size_t seats = data[0] % (MAX_SEATS - 1) + 2;
+    size_t at = 1;
+    for (size_t seat = 0; seat < seats; ++seat)
+        current.add_player(NAMES[seat], ROLES[at < size ? data[at++] % 6 : seat % 6]);
+
+    for (; at + 1 < size && !current.is_game_over(); at += 2) {
+        ++stats.steps;
+        if (!step(data[at], data[at + 1], broken))
+            ++stats.rejected;
+        if (broken.empty())
+            broken = check_invariants(current);
+        if (!broken.empty())
+            break;
+    }
+    stats.finished = current.is_game_over();
+    return stats;
+}
+
+bool ActionFuzzer::step(uint8_t op, uint8_t arg, std::string &broken) {
+    const auto &players = current.get_all_players_raw();
+    const size_t seats = players.size();
+    const uint8_t kind = op & 0x0f;
+    Player &chosen = *players[(op >> 5) % seats];
+    Player &target = *players[arg % seats];
+    const bool reaction = kind >= UndoTax && kind <= Peek;
+    Player &actor = (reaction || (op & OWN_SEAT)) ? chosen : *players[current.get_current_turn_index()];
+
+    const Refusal refusal = actor.check(OP_ACTIONS[kind], &target);
+    if (refusal && (arg & PLAY_REFUSED) != PLAY_REFUSED)
+        return false;
+
+    const std::string what = actor.get_name() + "'s " + OP_NAMES[kind] + " on " + target.get_name();
+    try {
+        perform(kind, actor, target);
+    } catch (const CoupException &e) {
+        if (!refusal)
+            broken = what + " passed check() but threw: " + e.what();
+        else if (classify_rejection(e) != refusal.reason)
+            broken = what + " threw " + e.what() + ", not the " + to_string(refusal.reason) + " check() named";
+        return false;
+    }
+    if (refusal)
+        broken = what + " was refused by check() (" + to_string(refusal.reason) + ") but accepted";
+    return !refusal;
+}
+
+void ActionFuzzer::perform(uint8_t kind, Player &actor, Player &target) {
+    switch (static_cast<Op>(kind)) {
+        case Gather: case Gather2: return actor.gather();
+        case Tax: case Tax2: return actor.tax();
+        case Bribe: return actor.bribe();
+        case Invest:
+            if (auto *baron = dynamic_cast<Baron *>(&actor))
+                return baron->invest();
+            break;
+        case Arrest: case Arrest2: return actor.arrest(target);
+        case Sanction: return actor.sanction(target);
+        case Coup: case Coup2: return actor.coup(target);
+        case Skip: return actor.skip_turn();
+        case UndoTax:
+            if (auto *governor = dynamic_cast<Governor *>(&actor))
+                return governor->undo_tax(target);
+            break;
+        case UndoBribe:
+            if (auto *judge = dynamic_cast<Judge *>(&actor))
+                return judge->undo_bribe(target);
+            break;
+        case UndoCoup:
+            if (auto *general = dynamic_cast<General *>(&actor))
+                return general->undo_coup(target);
+            break;
+        case Peek:
+            if (auto *spy = dynamic_cast<Spy *>(&actor))
+                return spy->peek_and_disable(target);
+            break;
+    }
+    throw UndoNotAllowed(actor.role(), OP_NAMES[kind]); // an ability of another role
+}
+
+} // namespace coup
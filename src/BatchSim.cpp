@@ -0,0 +1,341 @@
+// BatchSim.cpp - Many games of a fixed policy advanced in lockstep
+// Anksilae@gmail.com
+
+#include "BatchSim.hpp"
+#include "Game.hpp"
+#include "Player.hpp"
+#include "Baron.hpp"
+#include "Exceptions.hpp"
+#include <algorithm>
+
+namespace coup {
+
+namespace {
+
+// ======================
+// Policy (scalar form)
+// ======================
+
+enum class Move { Gather, Tax, Invest, Coup };
+
+/**
+ * @brief First state of a game's random stream (a 32-bit finalizer of the seed; never 0).
+ */
+uint32_t seed_stream(uint32_t seed) {
+    uint32_t z = seed + 0x9E3779B9u;
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    z ^= z >> 16;
+    return z ? z : 1;
+}
+
+/**
+ * @brief One xorshift32 step; only shifts and xors, so it runs the same on a whole block.
+ */
+uint32_t next_roll(uint32_t x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+/**
+ * @brief The policy's choice for a player holding `coins`, given this turn's roll.
+ */
+Move decide(const BatchPolicy &policy, const RulesConfig &rules, int coins, bool baron, uint32_t roll) {
+    if (coins >= policy.coup_at)
+        return Move::Coup;
+    if (baron && coins >= rules.invest_cost && static_cast<int>(roll >> 28) < policy.invest_weight)
+        return Move::Invest;
+    if (static_cast<int>((roll >> 24) & 15) < policy.tax_weight)
+        return Move::Tax;
+    return Move::Gather;
+}
+
+/**
+ * @brief Seat of the coup target: the (roll mod opponents)-th alive opponent in seat order.
+ */
+int pick_target(uint32_t alive, int me, uint32_t roll) {
+    uint32_t opponents = alive & ~(1u << me);
+    int k = static_cast<int>((roll & 0xFFFF) % static_cast<uint32_t>(__builtin_popcount(opponents)));
+    while (k-- > 0)
+        opponents &= opponents - 1;
+    return __builtin_ctz(opponents);
+}
+
+// ======================
+// Lanes
+// ======================
+
+constexpr size_t W = BatchSim::LANE_WIDTH;
+typedef int32_t lanes_i __attribute__((vector_size(W * sizeof(int32_t))));
+typedef uint32_t lanes_u __attribute__((vector_size(W * sizeof(uint32_t))));
+
+/**
+ * @brief W games in struct-of-arrays form. Masks are -1 (set) or 0 per lane.
+ */
+struct Block {
+    lanes_i coins[BatchSim::MAX_SEATS]; ///< Coins by seat
+    lanes_i alive;                      ///< Alive seats, one bit each
+    lanes_i turn;                       ///< Seat in turn
+    lanes_i turns;                      ///< Turns played
+    lanes_i live;                       ///< Mask of lanes running a game
+    lanes_u roll;                       ///< Random stream state
+    size_t game[W];                     ///< Index of the game in each lane
+};
+
+/**
+ * @brief Sets `out` to the coins of the seat `seat` names in each lane (a blend over the seats).
+ *
+ * Lane vectors are passed by reference: passing them by value would depend on whether AVX is enabled.
+ */
+void coins_at(const Block &b, const lanes_i &seat, int seats, lanes_i &out) {
+    out = lanes_i{};
+    for (int s = 0; s < seats; ++s)
+        out = (seat == s) ? b.coins[s] : out;
+}
+
+/**
+ * @brief Sets `out` to a mask of the lanes whose `seat` is in the scalar seat mask `seats_mask`.
+ *
+ * Compares against each seat instead of shifting by the lane's seat: per-lane variable
+ * shifts only exist from AVX2 on, so this stays vectorized on plain SSE2 too.
+ */
+void seat_in(const lanes_i &seat, uint32_t seats_mask, lanes_i &out) {
+    out = lanes_i{};
+    for (; seats_mask; seats_mask &= seats_mask - 1)
+        out |= seat == __builtin_ctz(seats_mask);
+}
+
+/**
+ * @brief next_roll() on every lane.
+ */
+void next_rolls(lanes_u &x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+}
+
+bool any(const lanes_i &mask) {
+    for (size_t l = 0; l < W; ++l)
+        if (mask[l])
+            return true;
+    return false;
+}
+
+/**
+ * @brief Plays the games of one run() call over a pool of blocks.
+ */
+class Runner {
+public:
+    Runner(const BatchPolicy &policy, const RulesConfig &rules, int seats, uint32_t governors, uint32_t barons,
+           uint32_t merchants, uint32_t first_seed, std::vector<BatchOutcome> &outcomes)
+        : policy(policy), rules(rules), seats(seats), governors(governors), barons(barons), merchants(merchants),
+          all_alive(seats == 32 ? -1 : static_cast<int32_t>((1u << seats) - 1)), first_seed(first_seed),
+          outcomes(outcomes) {}
+
+    void run(size_t block_count) {
+        std::vector<Block> pool(block_count);
+        for (auto &b : pool) {
+            b.live = lanes_i{};
+            refill(b);
+        }
+        while (finished < outcomes.size())
+            for (auto &b : pool)
+                if (any(b.live))
+                    step(b);
+    }
+
+private:
+    const BatchPolicy &policy;
+    const RulesConfig &rules;
+    const int seats;
+    const uint32_t governors, barons, merchants;
+    const int32_t all_alive;
+    const uint32_t first_seed;
+    std::vector<BatchOutcome> &outcomes;
+    size_t next_game = 0;
+    size_t finished = 0;
+
+    /**
+     * @brief One turn of every live lane of the block.
+     */
+    void step(Block &b) {
+        const lanes_i live = b.live;
+
+        // Draw and choose (the vector form of decide())
+        next_rolls(b.roll);
+        const lanes_i roll = (lanes_i)b.roll;
+        lanes_i cur, baron, governor;
+        coins_at(b, b.turn, seats, cur);
+        seat_in(b.turn, barons, baron);
+        seat_in(b.turn, governors, governor);
+        const lanes_i coup = live & (cur >= policy.coup_at);
+        const lanes_i invest = live & ~coup & baron & (cur >= rules.invest_cost) &
+                               (((roll >> 28) & 15) < policy.invest_weight);
+        const lanes_i tax = live & ~coup & ~invest & (((roll >> 24) & 15) < policy.tax_weight);
+        const lanes_i gather = live & ~coup & ~invest & ~tax;
+
+        // Pay the move; a coup's price is paid here too
+        const lanes_i income = (governor & rules.governor_tax) | (~governor & rules.tax_income);
+        const lanes_i delta = (gather & rules.gather_income) + (tax & income) +
+                              (invest & (rules.invest_return - rules.invest_cost)) - (coup & rules.coup_cost);
+        for (int s = 0; s < seats; ++s)
+            b.coins[s] += (b.turn == s) & delta;
+        b.turns -= live;
+
+        // Coups are a few per game: eliminate lane by lane
+        if (any(coup))
+            for (size_t l = 0; l < W; ++l)
+                if (coup[l])
+                    eliminate(b, l);
+
+        advance(b);
+
+        const lanes_i out_of_turns = b.live & (b.turns >= policy.max_turns);
+        if (any(out_of_turns))
+            for (size_t l = 0; l < W; ++l)
+                if (out_of_turns[l])
+                    finish(b, l, -1);
+
+        if (any(~b.live))
+            refill(b);
+    }
+
+    /**
+     * @brief Removes the coup target of lane `l` and ends its game if one player is left.
+     */
+    void eliminate(Block &b, size_t l) {
+        const uint32_t alive = static_cast<uint32_t>(b.alive[l]);
+        const int target = pick_target(alive, b.turn[l], b.roll[l]);
+        const uint32_t left = alive & ~(1u << target);
+        b.alive[l] = static_cast<int32_t>(left);
+        if (__builtin_popcount(left) == 1)
+            finish(b, l, __builtin_ctz(left));
+    }
+
+    /**
+     * @brief Moves every live lane's turn to the next alive seat and pays the Merchant bonus.
+     */
+    void advance(Block &b) {
+        // The alive seat at the smallest distance 1..seats-1 after the turn
+        lanes_i next = b.turn;
+        lanes_i best = lanes_i{} + seats;
+        for (int s = 0; s < seats; ++s) {
+            lanes_i distance = s - b.turn;
+            distance += (distance <= 0) & seats;
+            const lanes_i closer = ((b.alive & static_cast<int32_t>(1u << s)) != 0) & (distance < best);
+            next = closer ? lanes_i{} + s : next;
+            best = closer ? distance : best;
+        }
+        next = b.live ? next : b.turn;
+
+        lanes_i cur, merchant;
+        coins_at(b, next, seats, cur);
+        seat_in(next, merchants, merchant);
+        const lanes_i bonus = b.live & merchant & (cur >= rules.merchant_bonus_at);
+        for (int s = 0; s < seats; ++s)
+            b.coins[s] += (next == s) & bonus & rules.merchant_bonus;
+        b.turn = next;
+    }
+
+    void finish(Block &b, size_t l, int winner) {
+        BatchOutcome &out = outcomes[b.game[l]];
+        out.winner = winner;
+        out.turns = b.turns[l];
+        for (int s = 0; s < seats; ++s)
+            out.coins[s] = b.coins[s][l];
+        b.live[l] = 0;
+        ++finished;
+    }
+
+    /**
+     * @brief Starts pending games in the block's idle lanes.
+     */
+    void refill(Block &b) {
+        for (size_t l = 0; l < W && next_game < outcomes.size(); ++l) {
+            if (b.live[l])
+                continue;
+            b.game[l] = next_game;
+            for (int s = 0; s < seats; ++s)
+                b.coins[s][l] = 0;
+            b.alive[l] = all_alive;
+            b.turn[l] = 0;
+            b.turns[l] = 0;
+            b.roll[l] = seed_stream(first_seed + static_cast<uint32_t>(next_game));
+            b.live[l] = -1;
+            ++next_game;
+        }
+    }
+};
+
+} // namespace
+
+// ======================
+// BatchSim
+// ======================
+
+BatchSim::BatchSim(std::vector<std::string> roles, BatchPolicy policy, size_t games_in_flight, const RulesConfig &rules)
+    : seat_roles(std::move(roles)), seat_policy(policy), game_rules(rules),
+      blocks(std::max<size_t>(1, (games_in_flight + W - 1) / W)) {
+    game_rules.validate();
+    if (seat_roles.size() < 2 || seat_roles.size() > MAX_SEATS)
+        throw InvalidActionException("BatchSim needs 2 to " + std::to_string(MAX_SEATS) + " seats.");
+    for (size_t s = 0; s < seat_roles.size(); ++s) {
+        const std::string &role = seat_roles[s];
+        if (role == "Governor") governors |= 1u << s;
+        else if (role == "Baron") barons |= 1u << s;
+        else if (role == "Merchant") merchants |= 1u << s;
+        else if (role != "Spy" && role != "Judge" && role != "General")
+            throw InvalidActionException("Unknown role: " + role);
+    }
+    seat_policy.coup_at = std::clamp(seat_policy.coup_at, game_rules.coup_cost, game_rules.forced_coup_at);
+    seat_policy.tax_weight = std::clamp(seat_policy.tax_weight, 0, 16);
+    seat_policy.invest_weight = std::clamp(seat_policy.invest_weight, 0, 16);
+}
+
+/**
+ * @brief Plays the games in blocks of LANE_WIDTH until all are decided or out of turns.
+ */
+std::vector<BatchOutcome> BatchSim::run(uint32_t first_seed, size_t count) const {
+    std::vector<BatchOutcome> outcomes(count);
+    Runner runner(seat_policy, game_rules, static_cast<int>(seat_roles.size()), governors, barons, merchants, first_seed, outcomes);
+    runner.run(std::min(blocks, (count + W - 1) / W));
+    return outcomes;
+}
+
+/**
+ * @brief Plays one game through the rules engine with the policy's choices.
+ */
+BatchOutcome BatchSim::play_scalar(uint32_t seed) const {
+    Game game(game_rules);
+    for (size_t s = 0; s < seat_roles.size(); ++s)
+        game.add_player("P" + std::to_string(s), seat_roles[s]);
+    const auto &players = game.get_all_players_raw();
+
+    BatchOutcome out;
+    uint32_t roll = seed_stream(seed);
+    while (!game.is_game_over() && out.turns < seat_policy.max_turns) {
+        Player &me = *players[game.get_current_turn_index()];
+        roll = next_roll(roll);
+        switch (decide(seat_policy, game_rules, me.coins(), me.role() == "Baron", roll)) {
+            case Move::Coup: {
+                int target = pick_target(static_cast<uint32_t>(game.flags().active), static_cast<int>(me.seat()), roll);
+                me.coup(*players[target]);
+                break;
+            }
+            case Move::Invest: static_cast<Baron &>(me).invest(); break;
+            case Move::Tax: me.tax(); break;
+            case Move::Gather: me.gather(); break;
+        }
+        ++out.turns;
+    }
+
+    if (game.is_game_over())
+        out.winner = SeatFlags::first(game.flags().active);
+    for (size_t s = 0; s < players.size(); ++s)
+        out.coins[s] = players[s]->coins();
+    return out;
+}
+
+} // namespace coup
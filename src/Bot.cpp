@@ -0,0 +1,397 @@
+// Bot.cpp - Computer-controlled player policies
+// Anksilae@gmail.com
+
+#include "Bot.hpp"
+#include "Game.hpp"
+#include "Player.hpp"
+#include "TurnDriver.hpp"
+#include "Exceptions.hpp"
+#include <chrono>
+#include <exception>
+
+namespace coup {
+
+// ======================
+// Names
+// ======================
+
+std::string to_string(BotStrength strength) {
+    switch (strength) {
+        case BotStrength::Random: return "Random";
+        case BotStrength::Greedy: return "Greedy";
+        case BotStrength::Search: return "Search";
+    }
+    return "Unknown";
+}
+
+/**
+ * @brief Returns a short description such as "coup bob".
+ */
+std::string BotMove::describe() const {
+    static const char *names[] = {"gather", "tax", "invest", "arrest", "sanction", "coup", "skip"};
+    std::string text = names[static_cast<int>(type)];
+    if (!target.empty())
+        text += " " + target;
+    return text;
+}
+
+// ======================
+// Simplified Model (Search)
+// ======================
+
+namespace {
+
+/**
+ * @brief Coins and role of one player in the simplified model used by rollouts.
+ */
+struct SimPlayer {
+    int coins = 0;
+    std::string role;
+    bool alive = true;
+};
+
+/**
+ * @brief Compact copy of the parts of a game that matter most for coin races and coups.
+ *
+ * Sanctions, arrest blocking and out-of-turn abilities are left out, so Search
+ * does not consider Sanction or Skip.
+ */
+struct SimState {
+    std::vector<SimPlayer> players;
+    size_t turn = 0;
+    RulesConfig rules;
+
+    size_t alive_count() const {
+        size_t n = 0;
+        for (const auto &p : players)
+            if (p.alive) ++n;
+        return n;
+    }
+};
+
+/**
+ * @brief Picks a random living opponent of `me`, or -1 if none.
+ */
+int random_opponent(const SimState &s, size_t me, std::mt19937 &rng) {
+    int count = 0;
+    for (size_t i = 0; i < s.players.size(); ++i)
+        if (i != me && s.players[i].alive) ++count;
+    if (count == 0)
+        return -1;
+    int pick = std::uniform_int_distribution<int>(0, count - 1)(rng);
+    for (size_t i = 0; i < s.players.size(); ++i)
+        if (i != me && s.players[i].alive && pick-- == 0)
+            return static_cast<int>(i);
+    return -1;
+}
+
+/**
+ * @brief Applies a move of the player in turn to the model and advances the turn.
+ */
+void sim_apply(SimState &s, BotMove::Type type, int target) {
+    SimPlayer &me = s.players[s.turn];
+    const RulesConfig &rules = s.rules;
+    switch (type) {
+        case BotMove::Type::Gather: me.coins += rules.gather_income; break;
+        case BotMove::Type::Tax: me.coins += (me.role == "Governor") ? rules.governor_tax : rules.tax_income; break;
+        case BotMove::Type::Invest:
+            if (me.coins >= rules.invest_cost) me.coins += rules.invest_return - rules.invest_cost;
+            break;
+        case BotMove::Type::Arrest: {
+            SimPlayer &t = s.players[target];
+            if (t.role == "Merchant") {
+                if (t.coins >= 2) t.coins -= 2;
+            } else if (t.coins > 0) {
+                if (t.role != "General") t.coins -= 1;
+                me.coins += 1;
+            }
+            break;
+        }
+        case BotMove::Type::Coup:
+            if (me.coins >= rules.coup_cost) {
+                me.coins -= rules.coup_cost;
+                s.players[target].alive = false;
+            }
+            break;
+        case BotMove::Type::Sanction:
+        case BotMove::Type::Skip: break;
+    }
+
+    if (s.alive_count() <= 1)
+        return;
+    do {
+        s.turn = (s.turn + 1) % s.players.size();
+    } while (!s.players[s.turn].alive);
+
+    SimPlayer &next = s.players[s.turn];
+    if (next.role == "Merchant" && next.coins >= rules.merchant_bonus_at)
+        next.coins += rules.merchant_bonus;
+}
+
+/**
+ * @brief Rollout policy: coup when possible, otherwise a random economic move.
+ */
+void sim_random_step(SimState &s, std::mt19937 &rng) {
+    const SimPlayer &me = s.players[s.turn];
+    int target = random_opponent(s, s.turn, rng);
+
+    if (me.coins >= s.rules.coup_cost) {
+        sim_apply(s, BotMove::Type::Coup, target);
+        return;
+    }
+
+    int roll = std::uniform_int_distribution<int>(0, 9)(rng);
+    if (me.role == "Baron" && me.coins >= s.rules.invest_cost && roll < 4)
+        sim_apply(s, BotMove::Type::Invest, -1);
+    else if (roll < 6)
+        sim_apply(s, BotMove::Type::Tax, -1);
+    else if (roll < 8 && target >= 0 && s.players[target].coins > 0)
+        sim_apply(s, BotMove::Type::Arrest, target);
+    else
+        sim_apply(s, BotMove::Type::Gather, -1);
+}
+
+/**
+ * @brief Plays random moves to the end (or a ply limit) and scores the result for `me`.
+ * @return 1 for a win, 0 if eliminated, the share of a draw otherwise.
+ */
+double sim_rollout(SimState s, size_t me, std::mt19937 &rng, int max_plies = 200) {
+    for (int ply = 0; ply < max_plies && s.alive_count() > 1 && s.players[me].alive; ++ply)
+        sim_random_step(s, rng);
+
+    if (!s.players[me].alive)
+        return 0.0;
+    return 1.0 / static_cast<double>(s.alive_count());
+}
+
+int index_of(const SimState &s, const std::vector<std::string> &names, const std::string &name) {
+    for (size_t i = 0; i < s.players.size(); ++i)
+        if (names[i] == name) return static_cast<int>(i);
+    return -1;
+}
+
+} // namespace
+
+// ======================
+// Bot
+// ======================
+
+Bot::Bot(BotStrength strength, unsigned seed, int think_budget_ms)
+    : level(strength), budget_ms(think_budget_ms), rng(seed) {}
+
+/**
+ * @brief Lists the turn-ending moves that pass the rules' cheap pre-checks.
+ */
+std::vector<BotMove> Bot::candidates(const Game &game, const Player &self) {
+    std::vector<BotMove> moves;
+    std::vector<const Player *> opponents;
+    const auto &seats = game.get_all_players_raw();
+    const uint64_t me = self.seat() == Player::NO_SEAT ? 0 : SeatFlags::bit(self.seat());
+    for (uint64_t others = game.flags().active & ~me; others; others &= others - 1)
+        opponents.push_back(seats[SeatFlags::first(others)]);
+
+    const RulesConfig &rules = game.rules();
+    const int coins = self.coins();
+    if (coins >= rules.forced_coup_at) {
+        for (const Player *o : opponents)
+            moves.push_back({BotMove::Type::Coup, o->get_name()});
+        return moves;
+    }
+
+    if (!self.is_sanctioned()) {
+        moves.push_back({BotMove::Type::Gather, ""});
+        moves.push_back({BotMove::Type::Tax, ""});
+    }
+    if (self.role() == "Baron" && coins >= rules.invest_cost)
+        moves.push_back({BotMove::Type::Invest, ""});
+
+    for (const Player *o : opponents) {
+        const std::string &t = o->get_name();
+        bool has_coins = o->coins() > 0 && !(o->role() == "Merchant" && o->coins() < 2);
+        if (has_coins && !self.is_arrest_disabled() && !game.arrested_same_target(o->id()))
+            moves.push_back({BotMove::Type::Arrest, t});
+        if (coins >= rules.sanction_cost + (o->role() == "Judge" ? rules.judge_sanction_extra : 0))
+            moves.push_back({BotMove::Type::Sanction, t});
+        if (coins >= rules.coup_cost)
+            moves.push_back({BotMove::Type::Coup, t});
+    }
+
+    moves.push_back({BotMove::Type::Skip, ""});
+    return moves;
+}
+
+/**
+ * @brief Chooses a move for the player in turn according to the bot's strength.
+ *
+ * A move already chosen max_repeats times in a row is left out (when there is another).
+ */
+BotMove Bot::choose(const Game &game, const Player &self) {
+    std::vector<BotMove> moves = candidates(game, self);
+    if (moves.empty())
+        return {BotMove::Type::Skip, ""};
+
+    // Two bots can otherwise trade arrests forever (each arrest undoes the other's)
+    if (repeats >= max_repeats && moves.size() > 1) {
+        for (auto it = moves.begin(); it != moves.end(); ++it) {
+            if (it->type == last_move.type && it->target == last_move.target) {
+                moves.erase(it);
+                break;
+            }
+        }
+    }
+
+    BotMove move = moves.front();
+    switch (level) {
+        case BotStrength::Random:
+            move = moves[std::uniform_int_distribution<size_t>(0, moves.size() - 1)(rng)];
+            break;
+        case BotStrength::Greedy:
+            move = choose_greedy(game, self, moves);
+            break;
+        case BotStrength::Search:
+            move = choose_search(game, self, moves);
+            break;
+    }
+
+    bool same = move.type == last_move.type && move.target == last_move.target;
+    repeats = same ? repeats + 1 : 1;
+    last_move = move;
+    return move;
+}
+
+/**
+ * @brief Scores each move by its immediate effect and picks the best (random tie-break).
+ *
+ * A coup beats everything (the richest target first); otherwise the score is the coins
+ * gained plus half of the coins taken from the target.
+ */
+BotMove Bot::choose_greedy(const Game &game, const Player &self, const std::vector<BotMove> &moves) {
+    const RulesConfig &rules = game.rules();
+    double best_score = -1e9;
+    std::vector<const BotMove *> best;
+
+    for (const auto &m : moves) {
+        double score = 0;
+        const Player *target = m.target.empty() ? nullptr : game.get_player_by_name(m.target);
+        switch (m.type) {
+            case BotMove::Type::Coup: score = 100 + target->coins(); break;
+            case BotMove::Type::Invest: score = rules.invest_return - rules.invest_cost; break;
+            case BotMove::Type::Tax: score = (self.role() == "Governor") ? rules.governor_tax : rules.tax_income; break;
+            case BotMove::Type::Gather: score = rules.gather_income; break;
+            case BotMove::Type::Arrest:
+                if (target->role() == "Merchant") score = 1;
+                else if (target->role() == "General") score = 1;
+                else score = 1.5;
+                break;
+            case BotMove::Type::Sanction: score = 0.2; break;
+            case BotMove::Type::Skip: score = 0; break;
+        }
+        if (score > best_score) {
+            best_score = score;
+            best.clear();
+        }
+        if (score == best_score)
+            best.push_back(&m);
+    }
+    return *best[std::uniform_int_distribution<size_t>(0, best.size() - 1)(rng)];
+}
+
+/**
+ * @brief Runs Monte Carlo rollouts for every move, round-robin, until the time budget ends,
+ * and picks the move with the best average outcome. Sanction and Skip are only chosen when
+ * nothing else is listed.
+ */
+BotMove Bot::choose_search(const Game &game, const Player &self, const std::vector<BotMove> &all_moves) {
+    // The model cannot value Sanction or Skip; left in, noisy rollouts pick them and stall the game
+    std::vector<BotMove> moves;
+    for (const auto &m : all_moves)
+        if (m.type != BotMove::Type::Sanction && m.type != BotMove::Type::Skip)
+            moves.push_back(m);
+    if (moves.empty())
+        return all_moves.front();
+
+    SimState root;
+    root.rules = game.rules();
+    std::vector<std::string> names;
+    size_t me = 0;
+    for (const auto &p : game.get_all_players_raw()) {
+        if (p->get_name() == self.get_name()) me = root.players.size();
+        root.players.push_back({p->coins(), p->role(), p->is_active()});
+        names.push_back(p->get_name());
+    }
+    root.turn = me;
+
+    // Each move starts with a few virtual visits at its immediate (0-ply) value, so with a
+    // short budget and noisy rollouts a coup is still preferred over coin moves
+    const int prior_visits = 8;
+    std::vector<double> total(moves.size(), 0.0);
+    std::vector<int> visits(moves.size(), prior_visits);
+    std::vector<int> gain(moves.size(), 0);
+    for (size_t i = 0; i < moves.size(); ++i) {
+        SimState s = root;
+        sim_apply(s, moves[i].type, index_of(s, names, moves[i].target));
+        total[i] = prior_visits * sim_rollout(s, me, rng, 0);
+        gain[i] = s.players[me].coins - root.players[me].coins;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budget_ms);
+
+    do {
+        for (size_t i = 0; i < moves.size(); ++i) {
+            SimState s = root;
+            sim_apply(s, moves[i].type, index_of(s, names, moves[i].target));
+            total[i] += sim_rollout(s, me, rng);
+            ++visits[i];
+        }
+    } while (std::chrono::steady_clock::now() < deadline);
+
+    // Near-ties go to the move that grows the bot's own coins (avoids endless arrest trading)
+    auto value = [&](size_t i) { return total[i] / visits[i] + 0.01 * gain[i]; };
+    size_t best = 0;
+    for (size_t i = 1; i < moves.size(); ++i)
+        if (value(i) > value(best))
+            best = i;
+    return moves[best];
+}
+
+/**
+ * @brief Performs one move through the regular Player API.
+ */
+void Bot::apply(Game &game, Player &self, const BotMove &move) {
+    apply_action(game, self, TurnAction::from(move));
+}
+
+/**
+ * @brief Chooses and performs a move, trying the other candidates if it is rejected.
+ */
+void Bot::play_turn(Game &game, const std::string &name) {
+    if (game.turn() != name)
+        throw NotYourTurnException();
+    auto self = game.get_player_by_name(name);
+
+    BotMove first = choose(game, *self);
+    try {
+        apply(game, *self, first);
+        return;
+    } catch (const CoupException &) {
+        // Fall through to the remaining candidates
+    }
+
+    std::vector<BotMove> moves = candidates(game, *self);
+    std::exception_ptr last_error;
+    for (const auto &m : moves) {
+        if (m.type == first.type && m.target == first.target)
+            continue;
+        try {
+            apply(game, *self, m);
+            return;
+        } catch (const CoupException &) {
+            last_error = std::current_exception();
+        }
+    }
+    if (last_error)
+        std::rethrow_exception(last_error);
+    throw InvalidActionException("Bot has no legal move.");
+}
+
+} // namespace coup
@@ -3,6 +3,8 @@
 
 #include "Game.hpp"
 #include "Exceptions.hpp"
+#include "GameStats.hpp"
+#include "Trace.hpp"
 #include <iostream>
 #include <algorithm>
 #include "Player.hpp"
@@ -24,11 +26,49 @@ namespace coup {
 /**
  * @brief Constructs a new Game and logs initialization.
  */
-Game::Game() {
-    std::cout << "[Game] Initialized new game.\n";
+Game::Game(const RulesConfig &rules, GameLog log) : Game(static_cast<GameArena *>(nullptr), rules, log) {}
+
+/**
+ * @brief Constructs a new Game whose state lives in `arena`.
+ * @throws InvalidActionException if another game uses the arena.
+ */
+Game::Game(GameArena &arena, const RulesConfig &rules, GameLog log) : Game(&arena, rules, log) {}
+
+Game::Game(GameArena *arena_ptr, const RulesConfig &rules, GameLog log)
+    : arena(arena_ptr),
+      memory(arena_ptr ? arena_ptr->resource() : std::pmr::get_default_resource()),
+      rules_config(rules),
+      standard_rules(rules == STANDARD_RULES),
+      roster(memory),
+      external_players(memory),
+      players_list(memory),
+      names(memory),
+      log_enabled(log == GameLog::Printed),
+      last_action(memory) {
+    rules_config.validate();
+    clear_bookkeeping();
+    if (arena) {
+        if (arena->used)
+            throw InvalidActionException("GameArena is already used by another game.");
+        arena->used = true;
+    }
+    last_action.reserve(128); // room for a typical log line, so logging a turn does not allocate
+    if (log_enabled)
+        std::cout << "[Game] Initialized new game.\n";
     this->log_action("[Game] Initialized new game.");
 }
 
+/**
+ * @brief Destroys the game; an arena-backed game releases its arena in one shot.
+ */
+Game::~Game() {
+    if (!arena)
+        return;
+    clear_state();
+    arena->used = false;
+    arena->release();
+}
+
 // ======================
 // State & Validation
 // ======================
@@ -49,7 +89,20 @@ void Game::end_game() {
         throw GameAlreadyOverException();
     }
     game_over = true;
-    std::cout << "[Game] Game has ended.\n";
+    count_pending_eliminations();
+    if (log_enabled)
+        std::cout << "[Game] Game has ended.\n";
+}
+
+/**
+ * @brief Counts the eliminations of the coups still pending: once the game is over no
+ * General can undo them.
+ */
+void Game::count_pending_eliminations() {
+    for (PlayerId target = 0; target < MAX_PLAYERS; ++target)
+        if (coup_attackers[target] != NO_PLAYER)
+            if (const Player *p = player_or_null(target))
+                GameStats::count_elimination(p->coins());
 }
 
 /**
@@ -64,11 +117,22 @@ bool Game::is_game_over() const {
 // Logging
 // ======================
 
+/**
+ * @brief Stores `text` inline.
+ * @throws InvalidActionException if it does not fit.
+ */
+void ActionName::assign(std::string_view text_in) {
+    if (text_in.size() > CAPACITY)
+        throw InvalidActionException("Action name too long: " + std::string(text_in));
+    text_in.copy(text, text_in.size());
+    length = static_cast<unsigned char>(text_in.size());
+}
+
 /**
  * @brief Logs the latest action for display and tracking.
  * @param text The action description.
  */
-void Game::log_action(const std::string &text) {
+void Game::log_action(std::string_view text) {
     last_action = text;
 }
 
@@ -80,47 +144,117 @@ void Game::log_action(const std::string &text) {
  * @brief Adds a new player to the game with the specified role.
  * @param name The name of the player.
  * @param role The role name (e.g., Spy, Judge).
- * @return Shared pointer to the created Player.
+ * @return Pointer to the created Player (owned by the game).
  * @throws DuplicatePlayerNameException if name already exists.
- * @throws InvalidActionException if role is invalid.
+ * @throws InvalidActionException if role is invalid or the game is full.
  */
-std::shared_ptr<Player> Game::add_player(const std::string &name, const std::string &role) {
+Player *Game::add_player(const std::string &name, const std::string &role) {
     assert_game_active();
-
-    for (const auto& p : players_list) {
-        if (p->get_name() == name) {
-            throw DuplicatePlayerNameException(name);
-        }
-    }
-
-    std::shared_ptr<Player> player;
-    if      (role == "Governor") player = std::make_shared<Governor>(*this, name);
-    else if (role == "Spy")      player = std::make_shared<Spy>(*this, name);
-    else if (role == "Judge")    player = std::make_shared<Judge>(*this, name);
-    else if (role == "Baron")    player = std::make_shared<Baron>(*this, name);
-    else if (role == "General")  player = std::make_shared<General>(*this, name);
-    else if (role == "Merchant") player = std::make_shared<Merchant>(*this, name);
+    PlayerId id = claim_seat(name);
+
+    Player *player;
+    if      (role == "Governor") player = &emplace_role<Governor>(name);
+    else if (role == "Spy")      player = &emplace_role<Spy>(name);
+    else if (role == "Judge")    player = &emplace_role<Judge>(name);
+    else if (role == "Baron")    player = &emplace_role<Baron>(name);
+    else if (role == "General")  player = &emplace_role<General>(name);
+    else if (role == "Merchant") player = &emplace_role<Merchant>(name);
     else throw InvalidActionException("Unknown role: " + role);
 
-    players_list.push_back(player);
+    seat(*player, id);
     player->set_active(true);
-    std::cout << "[Game] Added player: " << name << " (" << role << ")\n";
+    if (log_enabled)
+        std::cout << "[Game] Added player: " << name << " (" << role << ")\n";
     return player;
 }
 
+/**
+ * @brief Constructs a role object at the end of the roster.
+ *
+ * The roster is reserved for MAX_PLAYERS up front and never grows, so players never move
+ * once created.
+ */
+template <typename Role>
+Player &Game::emplace_role(const std::string &name) {
+    if (roster.empty())
+        roster.reserve(MAX_PLAYERS);
+    return std::get<Role>(roster.emplace_back(std::in_place_type<Role>, *this, name));
+}
+
 /**
  * @brief Adds an already-created player to the game (used for testing).
  * @param p Shared pointer to the player object.
  */
 void Game::add_player(const std::shared_ptr<Player> &p) {
     assert_game_active();
-    for (const auto& existing : players_list) {
-        if (existing->get_name() == p->get_name()) {
-            throw DuplicatePlayerNameException(p->get_name());
-        }
-    }
-    players_list.push_back(p);
-    std::cout << "[Game] Added player: " << p->get_name() << " (" << p->role() << ")\n";
+    PlayerId id = claim_seat(p->get_name());
+    external_players.push_back(p);
+    seat(*p, id);
+    if (log_enabled)
+        std::cout << "[Game] Added player: " << p->get_name() << " (" << p->role() << ")\n";
+}
+
+/**
+ * @brief Checks that a player named `name` can join and interns the name.
+ * @throws DuplicatePlayerNameException if a player already has the name.
+ * @throws InvalidActionException if the game already has MAX_PLAYERS players or names.
+ */
+PlayerId Game::claim_seat(const std::string &name) {
+    if (player_or_null(names.find(name)))
+        throw DuplicatePlayerNameException(name);
+    if (players_list.size() == MAX_PLAYERS)
+        throw InvalidActionException("Game is full (MAX_PLAYERS is " + std::to_string(MAX_PLAYERS) + ").");
+    return names.intern(name);
+}
+
+/**
+ * @brief Gives a new player the next seat.
+ */
+void Game::seat(Player &player, PlayerId id) {
+    player.player_id = id;
+    id_players[id] = &player;
+
+    // Move the player's flags from its own storage into this seat's bits
+    const size_t seat = players_list.size();
+    const SeatFlags own = player.flags();
+    const uint64_t own_bit = player.flag_bit();
+    const uint64_t bit = SeatFlags::bit(seat);
+    if (own.active & own_bit) seat_flags.active |= bit;
+    if (own.sanctioned & own_bit) seat_flags.sanctioned |= bit;
+    if (own.arrest_disabled & own_bit) seat_flags.arrest_disabled |= bit;
+    player.seat_index = seat;
+
+    if (players_list.empty())
+        players_list.reserve(MAX_PLAYERS);
+    players_list.push_back(&player);
+}
+
+/**
+ * @brief Returns the player behind an id, or nullptr for NO_PLAYER and names that are not players.
+ */
+Player *Game::player_or_null(PlayerId id) const {
+    return id < id_players.size() ? id_players[id] : nullptr;
+}
+
+/**
+ * @brief Returns the player behind an id.
+ * @throws PlayerNotFoundException if the id is not a player.
+ */
+Player &Game::player_at(PlayerId id) const {
+    if (Player *p = player_or_null(id))
+        return *p;
+    throw PlayerNotFoundException(id < names.size() ? std::string(names.name(id)) : std::string());
+}
+
+/**
+ * @brief Looks up the id of a player by name, without interning the name.
+ * @throws PlayerNotFoundException if no player has the name.
+ */
+PlayerId Game::player_id(const std::string &name) const {
+    PlayerId id = names.find(name);
+    if (!player_or_null(id))
+        throw PlayerNotFoundException(name);
+    return id;
 }
 
 /**
@@ -136,26 +270,50 @@ std::vector<std::string> Game::players() const {
 /**
  * @brief Returns all players (active and eliminated).
  */
-std::vector<std::shared_ptr<Player>> Game::get_all_players_raw() const {
+const std::pmr::vector<Player *> &Game::get_all_players_raw() const {
     return players_list;
 }
 
 /**
- * @brief Returns the map of last actions per player.
+ * @brief Looks up the id of a name without interning it.
+ */
+PlayerId Game::id_of(std::string_view name) const {
+    return names.find(name);
+}
+
+/**
+ * @brief Returns the interned name behind an id.
  */
-const std::unordered_map<std::string, std::string>& Game::get_last_actions() const {
-    return last_actions;
+const std::pmr::string &Game::name_of(PlayerId id) const {
+    return names.name(id);
+}
+
+/**
+ * @brief Builds the map of last actions per player name.
+ */
+std::unordered_map<std::string, std::string> Game::get_last_actions() const {
+    std::unordered_map<std::string, std::string> by_name;
+    for (PlayerId id = 0; id < names.size(); ++id)
+        if (action_turn[id] != NO_TURN)
+            by_name.emplace(names.name(id), last_actions[id].view());
+    return by_name;
+}
+
+/**
+ * @brief Returns a player's last recorded action, or an empty view.
+ */
+std::string_view Game::last_action_of(PlayerId player) const {
+    return player < MAX_PLAYERS ? last_actions[player].view() : std::string_view();
 }
 
 /**
  * @brief Gets a player by name.
  * @throws PlayerNotFoundException if name not found.
  */
-std::shared_ptr<Player> Game::get_player_by_name(const std::string &name) const {
+Player *Game::get_player_by_name(const std::string &name) const {
     assert_game_active();
-    for (auto &p : players_list)
-        if (p->get_name() == name)
-            return p;
+    if (Player *p = player_or_null(names.find(name)))
+        return p;
     throw PlayerNotFoundException(name);
 }
 
@@ -166,15 +324,25 @@ std::shared_ptr<Player> Game::get_player_by_name(const std::string &name) const
  */
 void Game::remove_player(const std::string &victim) {
     assert_game_active();
-    for (auto &p : players_list) {
-        if (p->get_name() == victim) {
-            p->set_active(false);
-            std::cout << "[Eliminate] Player " << victim << " has been eliminated(unless undone by a general).\n";
-            this->log_action("[Eliminate] Player " + victim + " has been eliminated(unless undone by a general).\n");
-            return;
-        }
-    }
-    throw PlayerNotFoundException(victim);
+    PlayerId id = names.find(victim);
+    if (!player_or_null(id))
+        throw PlayerNotFoundException(victim);
+    remove_player(id);
+}
+
+/**
+ * @brief Marks a player as eliminated (inactive).
+ * @throws PlayerNotFoundException if the id is not a player.
+ */
+void Game::remove_player(PlayerId victim) {
+    assert_game_active();
+    Player &p = player_at(victim);
+    p.set_active(false);
+    if (coup_attackers[victim] == NO_PLAYER)
+        GameStats::count_elimination(p.coins()); // a coup's victim is counted once it can't be undone
+    if (log_enabled)
+        std::cout << "[Eliminate] Player " << p.get_name() << " has been eliminated(unless undone by a general).\n";
+    log_parts("[Eliminate] Player ", p.get_name(), " has been eliminated(unless undone by a general).\n");
 }
 
 // ======================
@@ -184,52 +352,66 @@ void Game::remove_player(const std::string &victim) {
 /**
  * @brief Gets the name of the current player in turn.
  */
-std::string Game::turn() const {
+const std::string &Game::turn() const {
     if (players_list.empty())
         throw InvalidActionException("No players in game.");
     return players_list.at(current_turn_index)->get_name();
 }
 
+/**
+ * @brief Gets the id of the current player in turn.
+ */
+PlayerId Game::turn_id() const {
+    if (players_list.empty())
+        throw InvalidActionException("No players in game.");
+    return players_list.at(current_turn_index)->id();
+}
+
 /**
  * @brief Advances the game to the next active player's turn.
  */
 void Game::next_turn() {
+    COUP_TRACE_SPAN("Game::next_turn");
     assert_game_active();
     global_turn_counter++;
 
-    std::string prev = turn();
-    std::shared_ptr<Player> prev_player = get_player_by_name(prev);
+    Player *prev_player = players_list.at(current_turn_index);
     prev_player->unsanction();
 
-    if (players().size() == 1) {
-        std::cout << "[Game] Winner is: " << players().front() << std::endl;
-        log_action("[Game] Winner is: " + players().front());
+    if (alive_count() == 1) {
+        const Player &last = *players_list[SeatFlags::next_after(seat_flags.active, current_turn_index)];
+        if (log_enabled)
+            std::cout << "[Game] Winner is: " << last.get_name() << std::endl;
+        log_parts("[Game] Winner is: ", last.get_name());
         game_over = true;
+        count_pending_eliminations();
+        GameStats::count_game(global_turn_counter, last.role());
         return;
     }
 
-    size_t n = players_list.size();
-    do {
-        current_turn_index = (current_turn_index + 1) % n;
-    } while (!players_list[current_turn_index]->is_active());
-
-    for (auto it = coup_pending_list.begin(); it != coup_pending_list.end(); ) {
-        if (it->first == turn()) {
-            it = coup_pending_list.erase(it);
-        } else {
-            ++it;
-        }
+    int next = next_active_seat(current_turn_index);
+    if (next < 0)
+        return; // nobody is alive: nothing to hand the turn to
+    if (static_cast<size_t>(next) <= current_turn_index)
+        ++round_epoch; // the turn wrapped around the seats: a new round, whoever is still seated
+    current_turn_index = static_cast<size_t>(next);
+
+    Player *current = players_list[current_turn_index];
+    turn_began[current->id()] = global_turn_counter;
+    for (PlayerId target = 0; target < MAX_PLAYERS; ++target) {
+        if (coup_attackers[target] != current->id())
+            continue;
+        coup_attackers[target] = NO_PLAYER; // the attacker's coups can no longer be undone
+        GameStats::count_elimination(player_at(target).coins());
     }
 
     prev_player->enable_arrest();
 
-    std::cout << "[Turn] " << prev << " ended. " << turn() << " begins.\n";
-
-    if (current_turn_index == players_list.size() - 1) {
-        undo_tax = undo_bribe = peek_disable = undo_coup = false;
-    }
+    if (log_enabled)
+        std::cout << "[Turn] " << prev_player->get_name() << " ended. " << current->get_name() << " begins.\n";
 
-    players_list[current_turn_index]->on_turn_start();
+    COUP_TRACE_SPAN("on_turn_start");
+    current->on_turn_start();
 }
 
 /**
@@ -268,68 +450,109 @@ std::string Game::winner() const {
 /**
  * @brief Performs a non-targeted action and logs it.
  */
-void Game::perform_action(const std::string &action_name, const std::string &by) {
-    perform_action(action_name, by, "");
+void Game::perform_action(std::string_view action_name, const std::string &by) {
+    static const std::string no_target;
+    perform_action(action_name, by, no_target);
 }
 
 /**
- * @brief Performs an action, optionally with a target, and logs it.
+ * @brief Performs an action by player names; an unknown target is logged as such.
+ * @throws PlayerNotFoundException if `by` is not a player.
  */
-void Game::perform_action(const std::string &action_name, const std::string &by, const std::string &target_name) {
+void Game::perform_action(std::string_view action_name, const std::string &by, const std::string &target_name) {
     assert_game_active();
-    last_actions[by] = action_name;
-    action_turn[by] = global_turn_counter;
-
-    auto actor = get_player_by_name(by);
-    std::string log_line = "[" + action_name + "] performed by " + by + " (" + actor->role() + ")" +
-                           " (Coins: " + std::to_string(actor->coins()) + ")";
-
-    if (!target_name.empty()) {
-        try {
-            auto target = get_player_by_name(target_name);
-            log_line += " on " + target_name + " (" + target->role() + ")" +
-                        " (Coins: " + std::to_string(target->coins()) + ")";
-        } catch (...) {
-            log_line += " → " + target_name + " (Unknown)";
-        }
+    PlayerId actor = names.find(by);
+    if (!player_or_null(actor))
+        throw PlayerNotFoundException(by);
+
+    PlayerId target = names.find(target_name);
+    if (target_name.empty() || player_or_null(target)) {
+        perform_action(action_name, actor, target_name.empty() ? NO_PLAYER : target);
+        return;
     }
 
-    std::cout << log_line << std::endl;
-    this->log_action(log_line);
+    record_action(action_name, *player_or_null(actor), nullptr);
+    last_action.append(" → ").append(target_name).append(" (Unknown)");
+    if (log_enabled)
+        std::cout << last_action << std::endl;
+}
+
+/**
+ * @brief Performs an action, optionally with a target, and logs it.
+ * @throws PlayerNotFoundException if `by` is not a player.
+ */
+void Game::perform_action(std::string_view action_name, PlayerId by, PlayerId target) {
+    COUP_TRACE_SPAN("Game::perform_action");
+    assert_game_active();
+    record_action(action_name, player_at(by), player_or_null(target));
+    if (log_enabled)
+        std::cout << last_action << std::endl;
+}
+
+/**
+ * @brief Records the actor's last action and writes the log line.
+ *
+ * The log line is built in place in the last-action text, so a player's repeated
+ * actions do not allocate.
+ */
+void Game::record_action(std::string_view action_name, const Player &actor, const Player *target) {
+    last_actions[actor.id()].assign(action_name);
+    action_turn[actor.id()] = global_turn_counter;
+
+    log_parts("[", action_name, "] performed by ", actor.get_name(), " (", actor.role(), ")",
+              " (Coins: ", std::to_string(actor.coins()), ")");
+
+    if (target) {
+        last_action.append(" on ").append(target->get_name()).append(" (").append(target->role()).append(")")
+                   .append(" (Coins: ").append(std::to_string(target->coins())).append(")");
+    }
 }
 
 /**
  * @brief Cancels the last action of a player and logs it.
  */
 void Game::cancel_last_action(const std::string &player_name) {
-    last_actions.erase(player_name);
-
-    std::string role;
-    try {
-        role = get_player_by_name(player_name)->role();
-    } catch (...) {
-        role = "Unknown";
+    PlayerId id = names.find(player_name);
+    if (player_or_null(id)) {
+        cancel_last_action(id);
+        return;
     }
+    log_parts("[Undo] Cancelled last action of: ", player_name);
+}
 
-    std::string action_name = (role == "Judge") ? "bribe" : (role == "Governor") ? "tax" : "last action";
-    log_action("[Undo] Cancelled " + action_name + " of: " + player_name);
+/**
+ * @brief Cancels the last action of a player by id and logs it.
+ */
+void Game::cancel_last_action(PlayerId player) {
+    if (player < MAX_PLAYERS)
+        last_actions[player].clear(); // the player still counts as having acted
+
+    Player *p = player_or_null(player);
+    std::string role = p ? p->role() : "Unknown";
+    const char *action_name = (role == "Judge") ? "bribe" : (role == "Governor") ? "tax" : "last action";
+    log_parts("[Undo] Cancelled ", action_name, " of: ", p ? std::string_view(p->get_name()) : std::string_view());
 }
 
 /**
  * @brief Checks whether a specific action can be undone for a player.
  */
 bool Game::can_undo_action(const std::string &target_name, const std::string &expected_action) const {
-    auto it = last_actions.find(target_name);
-    return (it != last_actions.end() && it->second == expected_action);
+    return can_undo_action(names.find(target_name), expected_action);
+}
+
+bool Game::can_undo_action(PlayerId target, std::string_view expected_action) const {
+    return target < MAX_PLAYERS && action_turn[target] != NO_TURN && last_actions[target].view() == expected_action;
 }
 
 /**
  * @brief Checks whether a player's action is still eligible for undo based on turn count.
  */
 bool Game::can_still_undo(const std::string &player_name) const {
-    auto it = action_turn.find(player_name);
-    if (it == action_turn.end()) return false;
-    return (global_turn_counter - it->second) < static_cast<int>(players().size());
+    return can_still_undo(names.find(player_name));
+}
+
+bool Game::can_still_undo(PlayerId player) const {
+    return player < MAX_PLAYERS && action_turn[player] != NO_TURN && action_turn[player] >= turn_began[player];
 }
 
 // ======================
@@ -341,8 +564,13 @@ bool Game::can_still_undo(const std::string &player_name) const {
  */
 void Game::block_arrest_for(const std::string &name) {
     assert_game_active();
-    get_player_by_name(name)->disable_arrest();
-    perform_action("block_arrest", turn(), name);
+    block_arrest_for(get_player_by_name(name)->id());
+}
+
+void Game::block_arrest_for(PlayerId player) {
+    assert_game_active();
+    player_at(player).disable_arrest();
+    perform_action("block_arrest", turn_id(), player);
 }
 
 /**
@@ -352,10 +580,19 @@ bool Game::is_arrest_blocked(const std::string &name) const {
     return get_player_by_name(name)->is_arrest_disabled();
 }
 
+bool Game::is_arrest_blocked(PlayerId player) const {
+    return player_at(player).is_arrest_disabled();
+}
+
 /**
  * @brief Sets the last player who was targeted for arrest.
  */
 void Game::set_last_arrest_target(const std::string &target) {
+    assert_game_active();
+    last_arrested = target.empty() ? NO_PLAYER : player_id(target);
+}
+
+void Game::set_last_arrest_target(PlayerId target) {
     assert_game_active();
     last_arrested = target;
 }
@@ -364,7 +601,11 @@ void Game::set_last_arrest_target(const std::string &target) {
  * @brief Checks if the last arrested player matches the given name.
  */
 bool Game::arrested_same_target(const std::string &target) const {
-    return last_arrested == target;
+    return !target.empty() && arrested_same_target(names.find(target));
+}
+
+bool Game::arrested_same_target(PlayerId target) const {
+    return target != NO_PLAYER && last_arrested == target;
 }
 
 // ======================
@@ -375,14 +616,31 @@ bool Game::arrested_same_target(const std::string &target) const {
  * @brief Adds a coup entry for an attacker and target.
  */
 void Game::add_to_coup(const std::string &attacker, const std::string &target) {
-    coup_pending_list.emplace_back(attacker, target);
+    add_to_coup(player_id(attacker), player_id(target));
+}
+
+void Game::add_to_coup(PlayerId attacker, PlayerId target) {
+    if (target >= MAX_PLAYERS)
+        throw PlayerNotFoundException("");
+    coup_attackers[target] = attacker;
 }
 
 /**
- * @brief Gets the list of all pending coups.
+ * @brief Builds the list of all pending coups, by name.
  */
-const std::vector<std::pair<std::string, std::string>> &Game::get_coup_pending_list() const {
-    return coup_pending_list;
+std::vector<std::pair<std::string, std::string>> Game::get_coup_pending_list() const {
+    std::vector<std::pair<std::string, std::string>> by_name;
+    for (PlayerId target = 0; target < names.size(); ++target)
+        if (coup_attackers[target] != NO_PLAYER)
+            by_name.emplace_back(names.name(coup_attackers[target]), names.name(target));
+    return by_name;
+}
+
+/**
+ * @brief Gets the pending coups as target → attacker.
+ */
+const std::array<PlayerId, MAX_PLAYERS> &Game::get_coup_attackers() const {
+    return coup_attackers;
 }
 
 /**
@@ -391,22 +649,23 @@ const std::vector<std::pair<std::string, std::string>> &Game::get_coup_pending_l
  */
 void Game::cancel_coup(const std::string& target) {
     assert_game_active();
+    PlayerId id = names.find(target);
+    if (id == NO_PLAYER)
+        throw InvalidActionException("No pending coup on " + target);
+    cancel_coup(id);
+}
 
-    bool found = false;
-    for (auto it = coup_pending_list.begin(); it != coup_pending_list.end(); ) {
-        if (it->second == target) {
-            it = coup_pending_list.erase(it);
-            found = true;
-        } else {
-            ++it;
-        }
-    }
+void Game::cancel_coup(PlayerId target) {
+    assert_game_active();
 
+    bool found = target < MAX_PLAYERS && coup_attackers[target] != NO_PLAYER;
     if (found) {
-        get_player_by_name(target)->set_active(true);
-        log_action("[Coup] Coup on " + target + " has been cancelled.\n");
+        coup_attackers[target] = NO_PLAYER;
+        Player &p = player_at(target);
+        p.set_active(true);
+        log_parts("[Coup] Coup on ", p.get_name(), " has been cancelled.\n");
     } else {
-        throw InvalidActionException("No pending coup on " + target);
+        throw InvalidActionException("No pending coup on " + (target < names.size() ? std::string(names.name(target)) : std::string()));
     }
 }
 
@@ -415,12 +674,13 @@ void Game::cancel_coup(const std::string& target) {
  */
 bool Game::is_coup_pending_on(const std::string &target) const {
     assert_game_active();
-    for (const auto &entry : coup_pending_list) {
-        if (entry.second == target) {
-            return true;
-        }
-    }
-    return false;
+    PlayerId id = names.find(target);
+    return id != NO_PLAYER && is_coup_pending_on(id);
+}
+
+bool Game::is_coup_pending_on(PlayerId target) const {
+    assert_game_active();
+    return target < MAX_PLAYERS && coup_attackers[target] != NO_PLAYER;
 }
 
 // ======================
@@ -431,17 +691,61 @@ bool Game::is_coup_pending_on(const std::string &target) const {
  * @brief Resets the entire game state to start a new match.
  */
 void Game::reset() {
-    players_list.clear();
+    clear_state();
+    if (arena)
+        arena->release();
+
     current_turn_index = 0;
+    global_turn_counter = 0;
     game_over = false;
-    coup_pending_list.clear();
-    arrest_blocked_players.clear();
-    last_arrested.clear();
-    last_actions.clear();
-    std::cout << "[Game] Reset complete.\n";
+    last_action.reserve(128);
+    if (log_enabled)
+        std::cout << "[Game] Reset complete.\n";
     log_action("[Game] Reset complete.\n");
 }
 
+/**
+ * @brief Drops all players and bookkeeping.
+ *
+ * Containers are swapped with empty ones rather than cleared, so their buffers
+ * (which may live in the arena) are freed too.
+ */
+void Game::clear_state() {
+    // Players added as objects outlive the game's seats: give them back their own flags
+    for (const auto &p : external_players) {
+        const uint64_t bit = p->flag_bit();
+        p->own_flags = SeatFlags{};
+        if (seat_flags.active & bit) p->own_flags.active = SeatFlags::bit(0);
+        if (seat_flags.sanctioned & bit) p->own_flags.sanctioned = SeatFlags::bit(0);
+        if (seat_flags.arrest_disabled & bit) p->own_flags.arrest_disabled = SeatFlags::bit(0);
+        p->seat_index = Player::NO_SEAT;
+        p->player_id = NO_PLAYER;
+    }
+
+    decltype(players_list)(memory).swap(players_list);
+    decltype(roster)(memory).swap(roster);
+    decltype(external_players)(memory).swap(external_players);
+    NameTable(memory).swap(names);
+    decltype(last_action)(memory).swap(last_action);
+    clear_bookkeeping();
+}
+
+/**
+ * @brief Empties the per-player arrays (they hold no memory of their own).
+ */
+void Game::clear_bookkeeping() {
+    seat_flags = SeatFlags{};
+    id_players.fill(nullptr);
+    for (auto &action : last_actions)
+        action.clear();
+    action_turn.fill(NO_TURN);
+    turn_began.fill(NO_TURN);
+    round_epoch = 1;
+    ability_epoch.fill(0);
+    coup_attackers.fill(NO_PLAYER);
+    last_arrested = NO_PLAYER;
+}
+
 /**
  * @brief Prints the current game state to the console (for debugging).
  */
@@ -0,0 +1,22 @@
+// GameArena.cpp - Monotonic arena for game state
+// Anksilae@gmail.com
+
+#include "GameArena.hpp"
+
+namespace coup {
+
+/**
+ * @brief Creates the arena around an owned initial buffer.
+ */
+GameArena::GameArena(std::size_t initial_bytes)
+    : buffer(new std::byte[initial_bytes]), pool(buffer.get(), initial_bytes) {}
+
+/**
+ * @brief Returns the calling thread's arena.
+ */
+GameArena &GameArena::this_thread() {
+    thread_local GameArena arena;
+    return arena;
+}
+
+} // namespace coup
@@ -0,0 +1,194 @@
+// GameEngine.cpp - Threaded game driver
+// Anksilae@gmail.com
+
+#include "GameEngine.hpp"
+#include <chrono>
+#include <exception>
+
+namespace coup {
+
+// ======================
+// Snapshot Queries
+// ======================
+
+/**
+ * @brief Returns the player in turn, or nullptr if there are no players.
+ */
+const PlayerView *GameSnapshot::current_player() const {
+    if (current < 0 || current >= static_cast<int>(players.size()))
+        return nullptr;
+    return &players[current];
+}
+
+/**
+ * @brief Finds a player by name.
+ */
+const PlayerView *GameSnapshot::find(const std::string &name) const {
+    for (const auto &p : players)
+        if (p.name == name)
+            return &p;
+    return nullptr;
+}
+
+/**
+ * @brief Counts active players.
+ */
+size_t GameSnapshot::alive_count() const {
+    size_t alive = 0;
+    for (const auto &p : players)
+        if (p.active) ++alive;
+    return alive;
+}
+
+// ======================
+// Engine Lifecycle
+// ======================
+
+/**
+ * @brief Publishes the initial state before the engine thread starts.
+ */
+GameEngine::GameEngine(Game &game) : game(game) {
+    publish();
+    worker = std::thread(&GameEngine::loop, this);
+}
+
+GameEngine::~GameEngine() {
+    stop();
+}
+
+/**
+ * @brief Stops and joins the engine thread.
+ */
+void GameEngine::stop() {
+    running.store(false, std::memory_order_release);
+    if (worker.joinable())
+        worker.join();
+}
+
+// ======================
+// UI Thread Side
+// ======================
+
+/**
+ * @brief Queues a command, yielding while the queue is full.
+ */
+uint64_t GameEngine::submit(Command command) {
+    Pending pending{next_id++, std::move(command)};
+    while (!commands.try_push(pending))
+        std::this_thread::yield();
+    return pending.id;
+}
+
+/**
+ * @brief Pops the next command result.
+ */
+bool GameEngine::poll_result(CommandResult &out) {
+    return results.try_pop(out);
+}
+
+/**
+ * @brief Returns the newest published snapshot.
+ */
+const GameSnapshot &GameEngine::snapshot() {
+    return snapshots.acquire();
+}
+
+// ======================
+// Engine Thread Side
+// ======================
+
+/**
+ * @brief Copies everything the UI needs out of the game.
+ */
+void GameEngine::capture(const Game &game, GameSnapshot &out) {
+    const auto &all = game.get_all_players_raw();
+
+    out.players.resize(all.size());
+    size_t alive = 0;
+    for (size_t i = 0; i < all.size(); ++i) {
+        const Player &p = *all[i];
+        PlayerView &v = out.players[i];
+        v.name = p.get_name();
+        v.role = p.role();
+        v.coins = p.coins();
+        v.active = p.is_active();
+        v.sanctioned = p.is_sanctioned();
+        v.arrest_disabled = p.is_arrest_disabled();
+        v.last_action = game.last_action_of(p.id());
+        v.can_still_undo = game.can_still_undo(p.id());
+        if (v.active) ++alive;
+    }
+
+    out.current = all.empty() ? -1 : game.get_current_turn_index();
+    out.turn = game.turns_played();
+    out.game_over = game.is_game_over();
+    out.winner.clear();
+    if (alive == 1) {
+        for (const auto &v : out.players)
+            if (v.active) out.winner = v.name;
+    }
+    out.last_action = game.get_last_action();
+    out.forced_coup_at = game.rules().forced_coup_at;
+    const auto &attackers = game.get_coup_attackers();
+    size_t pending = 0;
+    for (PlayerId target = 0; target < MAX_PLAYERS; ++target) {
+        if (attackers[target] == NO_PLAYER)
+            continue;
+        if (out.coup_pending_list.size() <= pending)
+            out.coup_pending_list.emplace_back();
+        out.coup_pending_list[pending].first = game.name_of(attackers[target]);
+        out.coup_pending_list[pending].second = game.name_of(target);
+        ++pending;
+    }
+    out.coup_pending_list.resize(pending);
+}
+
+/**
+ * @brief Captures the game into the back buffer and publishes it.
+ */
+void GameEngine::publish() {
+    GameSnapshot &back = snapshots.back();
+    capture(game, back);
+    back.version = ++version;
+    snapshots.publish();
+}
+
+/**
+ * @brief Executes queued commands, reporting results and publishing a snapshot after each.
+ *
+ * Spins briefly when idle, then backs off to short sleeps so an idle engine costs no CPU.
+ */
+void GameEngine::loop() {
+    unsigned idle = 0;
+    Pending pending;
+
+    while (running.load(std::memory_order_acquire)) {
+        if (!commands.try_pop(pending)) {
+            if (++idle < 64)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        idle = 0;
+
+        CommandResult result;
+        result.id = pending.id;
+        const std::string before = game.get_last_action();
+        try {
+            pending.command(game);
+            result.ok = true;
+            if (game.get_last_action() != before)
+                result.message = game.get_last_action();
+        } catch (const std::exception &e) {
+            result.message = e.what();
+        }
+        pending.command = nullptr;
+
+        publish();
+        while (!results.try_push(result) && running.load(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+}
+
+} // namespace coup
@@ -0,0 +1,335 @@
+// GameStats.cpp - Per-thread game counters merged on read
+// Anksilae@gmail.com
+
+#include "GameStats.hpp"
+#include "Exceptions.hpp"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace coup {
+
+namespace {
+
+using Snapshot = GameStatsSnapshot;
+
+constexpr const char *ACTION_NAMES[Snapshot::ACTIONS] = {
+    "gather", "tax", "bribe", "invest", "arrest", "sanction", "coup", "skip",
+    "undo_tax", "undo_bribe", "undo_coup", "peek_and_disable",
+};
+
+constexpr const char *REJECTION_NAMES[Snapshot::REJECTIONS] = {
+    "not_your_turn", "invalid_action", "game_not_over", "game_already_over", "player_not_found",
+    "duplicate_player_name", "player_already_dead", "cannot_target_yourself", "not_enough_coins",
+    "must_coup", "undo_not_allowed", "other",
+};
+
+constexpr const char *OUTCOME_NAMES[Snapshot::OUTCOMES] = {"ok", "rejected"};
+
+using Counter = std::atomic<uint64_t>;
+
+/**
+ * @brief One thread's counters, laid out like GameStatsSnapshot.
+ */
+struct Shard {
+    Counter actions[Snapshot::ACTIONS][Snapshot::ROLES][Snapshot::OUTCOMES] = {};
+    Counter rejections[Snapshot::ACTIONS][Snapshot::REJECTIONS] = {};
+    Counter elimination_coins[Snapshot::COIN_BUCKETS] = {};
+    Counter elimination_coins_sum{0};
+    Counter game_turns[Snapshot::TURN_BUCKETS] = {};
+    Counter game_turns_sum{0};
+    Counter wins[Snapshot::ROLES] = {};
+};
+
+/**
+ * @brief Adds to a counter only its own thread writes: no read-modify-write needed.
+ */
+inline void bump(Counter &c, uint64_t n = 1) {
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+struct Registry {
+    std::mutex lock;
+    std::vector<std::shared_ptr<Shard>> shards;
+};
+
+Registry &registry() {
+    static Registry r;
+    return r;
+}
+
+Shard &local() {
+    thread_local std::shared_ptr<Shard> mine = [] {
+        auto shard = std::make_shared<Shard>();
+        Registry &r = registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        r.shards.push_back(shard);
+        return shard;
+    }();
+    return *mine;
+}
+
+template <typename Fn>
+void for_each_shard(Fn &&fn) {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    for (const auto &shard : r.shards)
+        fn(*shard);
+}
+
+template <size_t N>
+void merge(uint64_t (&into)[N], const Counter (&from)[N]) {
+    for (size_t i = 0; i < N; ++i)
+        into[i] += from[i].load(std::memory_order_relaxed);
+}
+
+template <size_t N>
+void zero(Counter (&c)[N]) {
+    for (auto &x : c)
+        x.store(0, std::memory_order_relaxed);
+}
+
+size_t turn_bucket(int turns) {
+    size_t bucket = 0;
+    while (bucket + 1 < Snapshot::TURN_BUCKETS && static_cast<uint64_t>(turns) > Snapshot::turn_bucket_limit(bucket))
+        ++bucket;
+    return bucket;
+}
+
+/**
+ * @brief Writes a cumulative Prometheus histogram.
+ */
+void histogram(std::ostream &out, const char *name, const char *help, const uint64_t *counts, size_t buckets,
+               uint64_t sum, std::string (*limit)(size_t)) {
+    out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << " histogram\n";
+    uint64_t total = 0;
+    for (size_t b = 0; b < buckets; ++b) {
+        total += counts[b];
+        out << name << "_bucket{le=\"" << (b + 1 < buckets ? limit(b) : "+Inf") << "\"} " << total << '\n';
+    }
+    out << name << "_sum " << sum << '\n' << name << "_count " << total << '\n';
+}
+
+std::string coin_limit(size_t b) { return std::to_string(b); }
+std::string turn_limit(size_t b) { return std::to_string(Snapshot::turn_bucket_limit(b)); }
+
+void json_buckets(std::ostream &out, const uint64_t *counts, size_t buckets, std::string (*limit)(size_t)) {
+    out << '[';
+    for (size_t b = 0; b < buckets; ++b)
+        out << (b ? "," : "") << "{\"le\":\"" << (b + 1 < buckets ? limit(b) : "+Inf") << "\",\"count\":" << counts[b] << '}';
+    out << ']';
+}
+
+} // namespace
+
+// ======================
+// Names
+// ======================
+
+const char *const GameStatsSnapshot::ROLE_NAMES[ROLES] = {"Governor", "Spy", "Baron", "General", "Judge", "Merchant", "Other"};
+
+const char *to_string(StatAction action) {
+    return action < StatAction::Count ? ACTION_NAMES[static_cast<size_t>(action)] : "unknown";
+}
+
+const char *to_string(Rejection reason) {
+    return reason < Rejection::Count ? REJECTION_NAMES[static_cast<size_t>(reason)] : "unknown";
+}
+
+StatAction stat_action_from_name(std::string_view name) {
+    if (name == "Skip Turn")
+        return StatAction::Skip;
+    for (size_t i = 0; i < Snapshot::ACTIONS; ++i)
+        if (name == ACTION_NAMES[i])
+            return static_cast<StatAction>(i);
+    return StatAction::Count;
+}
+
+Rejection classify_rejection(const std::exception &e) {
+    if (dynamic_cast<const NotYourTurnException *>(&e)) return Rejection::NotYourTurn;
+    if (dynamic_cast<const InvalidActionException *>(&e)) return Rejection::InvalidAction;
+    if (dynamic_cast<const GameNotOverException *>(&e)) return Rejection::GameNotOver;
+    if (dynamic_cast<const GameAlreadyOverException *>(&e)) return Rejection::GameAlreadyOver;
+    if (dynamic_cast<const PlayerNotFoundException *>(&e)) return Rejection::PlayerNotFound;
+    if (dynamic_cast<const DuplicatePlayerNameException *>(&e)) return Rejection::DuplicatePlayerName;
+    if (dynamic_cast<const PlayerAlreadyDeadException *>(&e)) return Rejection::PlayerAlreadyDead;
+    if (dynamic_cast<const CannotTargetYourselfException *>(&e)) return Rejection::CannotTargetYourself;
+    if (dynamic_cast<const NotEnoughCoinsException *>(&e)) return Rejection::NotEnoughCoins;
+    if (dynamic_cast<const MustCoupWith10CoinsException *>(&e)) return Rejection::MustCoup;
+    if (dynamic_cast<const UndoNotAllowed *>(&e)) return Rejection::UndoNotAllowed;
+    return Rejection::Other;
+}
+
+// ======================
+// Snapshot
+// ======================
+
+size_t GameStatsSnapshot::role_slot(std::string_view role) {
+    for (size_t r = 0; r + 1 < ROLES; ++r)
+        if (role == ROLE_NAMES[r])
+            return r;
+    return ROLES - 1;
+}
+
+uint64_t GameStatsSnapshot::count(StatAction action, StatOutcome outcome) const {
+    uint64_t n = 0;
+    for (size_t r = 0; r < ROLES; ++r)
+        n += actions[static_cast<size_t>(action)][r][static_cast<size_t>(outcome)];
+    return n;
+}
+
+uint64_t GameStatsSnapshot::eliminations() const {
+    uint64_t n = 0;
+    for (uint64_t c : elimination_coins)
+        n += c;
+    return n;
+}
+
+uint64_t GameStatsSnapshot::games() const {
+    uint64_t n = 0;
+    for (uint64_t c : game_turns)
+        n += c;
+    return n;
+}
+
+void GameStatsSnapshot::write_json(std::ostream &out) const {
+    out << "{\"actions\":{";
+    for (size_t a = 0; a < ACTIONS; ++a) {
+        out << (a ? "," : "") << '"' << ACTION_NAMES[a] << "\":{";
+        for (size_t r = 0; r < ROLES; ++r) {
+            out << (r ? "," : "") << '"' << ROLE_NAMES[r] << "\":{";
+            for (size_t o = 0; o < OUTCOMES; ++o)
+                out << (o ? "," : "") << '"' << OUTCOME_NAMES[o] << "\":" << actions[a][r][o];
+            out << '}';
+        }
+        out << '}';
+    }
+    out << "},\"rejections\":{";
+    for (size_t a = 0; a < ACTIONS; ++a) {
+        out << (a ? "," : "") << '"' << ACTION_NAMES[a] << "\":{";
+        for (size_t why = 0; why < REJECTIONS; ++why)
+            out << (why ? "," : "") << '"' << REJECTION_NAMES[why] << "\":" << rejections[a][why];
+        out << '}';
+    }
+    out << "},\"elimination_coins\":{\"buckets\":";
+    json_buckets(out, elimination_coins, COIN_BUCKETS, coin_limit);
+    out << ",\"sum\":" << elimination_coins_sum << ",\"count\":" << eliminations() << "},\"game_turns\":{\"buckets\":";
+    json_buckets(out, game_turns, TURN_BUCKETS, turn_limit);
+    out << ",\"sum\":" << game_turns_sum << ",\"count\":" << games() << "},\"wins\":{";
+    for (size_t r = 0; r < ROLES; ++r)
+        out << (r ? "," : "") << '"' << ROLE_NAMES[r] << "\":" << wins[r];
+    out << "}}\n";
+}
+
+void GameStatsSnapshot::write_prometheus(std::ostream &out) const {
+    out << "# HELP coup_actions_total Actions by type, role of the actor and outcome.\n"
+           "# TYPE coup_actions_total counter\n";
+    for (size_t a = 0; a < ACTIONS; ++a)
+        for (size_t r = 0; r < ROLES; ++r)
+            for (size_t o = 0; o < OUTCOMES; ++o)
+                out << "coup_actions_total{action=\"" << ACTION_NAMES[a] << "\",role=\"" << ROLE_NAMES[r]
+                    << "\",outcome=\"" << OUTCOME_NAMES[o] << "\"} " << actions[a][r][o] << '\n';
+
+    out << "# HELP coup_rejections_total Rejected actions by type and reason.\n"
+           "# TYPE coup_rejections_total counter\n";
+    for (size_t a = 0; a < ACTIONS; ++a)
+        for (size_t why = 0; why < REJECTIONS; ++why)
+            out << "coup_rejections_total{action=\"" << ACTION_NAMES[a] << "\",reason=\"" << REJECTION_NAMES[why]
+                << "\"} " << rejections[a][why] << '\n';
+
+    histogram(out, "coup_elimination_coins", "Coins held by players when they were eliminated.", elimination_coins,
+              COIN_BUCKETS, elimination_coins_sum, coin_limit);
+    histogram(out, "coup_game_turns", "Turns played in finished games.", game_turns, TURN_BUCKETS, game_turns_sum,
+              turn_limit);
+
+    out << "# HELP coup_wins_total Finished games by role of the winner.\n# TYPE coup_wins_total counter\n";
+    for (size_t r = 0; r < ROLES; ++r)
+        out << "coup_wins_total{role=\"" << ROLE_NAMES[r] << "\"} " << wins[r] << '\n';
+}
+
+// ======================
+// Counting
+// ======================
+
+void GameStats::count_action(StatAction action, std::string_view role, StatOutcome outcome) {
+    if (action >= StatAction::Count)
+        return;
+    bump(local().actions[static_cast<size_t>(action)][Snapshot::role_slot(role)][static_cast<size_t>(outcome)]);
+}
+
+void GameStats::count_rejection(StatAction action, std::string_view role, Rejection reason) {
+    if (action >= StatAction::Count || reason >= Rejection::Count)
+        return;
+    Shard &s = local();
+    bump(s.actions[static_cast<size_t>(action)][Snapshot::role_slot(role)][static_cast<size_t>(StatOutcome::Rejected)]);
+    bump(s.rejections[static_cast<size_t>(action)][static_cast<size_t>(reason)]);
+}
+
+void GameStats::count_rejection(StatAction action, std::string_view role, const std::exception &e) {
+    count_rejection(action, role, classify_rejection(e));
+}
+
+void GameStats::count_elimination(int coins) {
+    Shard &s = local();
+    bump(s.elimination_coins[std::clamp<int>(coins, 0, Snapshot::COIN_BUCKETS - 1)]);
+    bump(s.elimination_coins_sum, static_cast<uint64_t>(std::max(coins, 0)));
+}
+
+void GameStats::count_game(int turns, std::string_view winner_role) {
+    Shard &s = local();
+    bump(s.game_turns[turn_bucket(std::max(turns, 0))]);
+    bump(s.game_turns_sum, static_cast<uint64_t>(std::max(turns, 0)));
+    bump(s.wins[Snapshot::role_slot(winner_role)]);
+}
+
+GameStatsSnapshot GameStats::snapshot() {
+    Snapshot out;
+    for_each_shard([&](const Shard &s) {
+        for (size_t a = 0; a < Snapshot::ACTIONS; ++a) {
+            for (size_t r = 0; r < Snapshot::ROLES; ++r)
+                merge(out.actions[a][r], s.actions[a][r]);
+            merge(out.rejections[a], s.rejections[a]);
+        }
+        merge(out.elimination_coins, s.elimination_coins);
+        out.elimination_coins_sum += s.elimination_coins_sum.load(std::memory_order_relaxed);
+        merge(out.game_turns, s.game_turns);
+        out.game_turns_sum += s.game_turns_sum.load(std::memory_order_relaxed);
+        merge(out.wins, s.wins);
+    });
+    return out;
+}
+
+void GameStats::reset() {
+    for_each_shard([](Shard &s) {
+        for (size_t a = 0; a < Snapshot::ACTIONS; ++a) {
+            for (size_t r = 0; r < Snapshot::ROLES; ++r)
+                zero(s.actions[a][r]);
+            zero(s.rejections[a]);
+        }
+        zero(s.elimination_coins);
+        s.elimination_coins_sum.store(0, std::memory_order_relaxed);
+        zero(s.game_turns);
+        s.game_turns_sum.store(0, std::memory_order_relaxed);
+        zero(s.wins);
+    });
+}
+
+bool GameStats::dump(const std::string &path) {
+    std::ofstream out(path);
+    if (!out)
+        return false;
+    auto ends_with = [&](std::string_view suffix) {
+        return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    const Snapshot snap = snapshot();
+    if (ends_with(".prom") || ends_with(".txt"))
+        snap.write_prometheus(out);
+    else
+        snap.write_json(out);
+    return static_cast<bool>(out);
+}
+
+} // namespace coup
@@ -0,0 +1,36 @@
+// NameTable.cpp - Interned player names
+// Anksilae@gmail.com
+
+#include "NameTable.hpp"
+#include "Exceptions.hpp"
+
+namespace coup {
+
+NameTable::NameTable(std::pmr::memory_resource *memory) : names(memory) {}
+
+/**
+ * @brief Finds `name` or appends it.
+ */
+PlayerId NameTable::intern(std::string_view name) {
+    PlayerId id = find(name);
+    if (id != NO_PLAYER)
+        return id;
+    if (names.size() == MAX_PLAYERS)
+        throw InvalidActionException("Too many names in one game (MAX_PLAYERS is " + std::to_string(MAX_PLAYERS) + ").");
+    if (names.empty())
+        names.reserve(MAX_PLAYERS);
+    names.emplace_back(name);
+    return static_cast<PlayerId>(names.size() - 1);
+}
+
+/**
+ * @brief Linear search; games know a handful of names, so this beats hashing.
+ */
+PlayerId NameTable::find(std::string_view name) const {
+    for (size_t i = 0; i < names.size(); ++i)
+        if (names[i] == name)
+            return static_cast<PlayerId>(i);
+    return NO_PLAYER;
+}
+
+} // namespace coup
@@ -5,6 +5,7 @@
 #include "Player.hpp"
 #include "Game.hpp"
 #include "Exceptions.hpp"
+#include "Trace.hpp"
 #include <iostream>
 
 using namespace std;
@@ -25,7 +26,8 @@ namespace coup
 Player::Player(Game &game_ref, const string &name)
     : name(name), game(&game_ref)
 {
-    std::cout << "[Init] Player created: " << name << std::endl;
+    if (game_ref.logging())
+        std::cout << "[Init] Player created: " << name << std::endl;
 }
 
 // ============================
@@ -55,39 +57,219 @@ void Player::set_coins(int amount)
     coin_count = amount;
 }
 
+/**
+ * @brief Returns the masks holding the player's flags: the game's once seated, its own before.
+ */
+SeatFlags &Player::flags() { return seat_index == NO_SEAT ? own_flags : game->seat_flags; }
+const SeatFlags &Player::flags() const { return seat_index == NO_SEAT ? own_flags : game->seat_flags; }
+
+/**
+ * @brief Returns the player's bit in flags().
+ */
+uint64_t Player::flag_bit() const { return SeatFlags::bit(seat_index == NO_SEAT ? 0 : seat_index); }
+
 /**
  * @brief Checks if the player is currently active.
  */
-bool Player::is_active() const { return active; }
+bool Player::is_active() const { return flags().active & flag_bit(); }
 
 /**
  * @brief Marks the player as active or inactive.
  */
-void Player::set_active(bool status) { active = status; }
+void Player::set_active(bool status) {
+    if (status)
+        flags().active |= flag_bit();
+    else
+        flags().active &= ~flag_bit();
+}
 
 /**
  * @brief Returns whether the player is under sanction.
  */
-bool Player::is_sanctioned() const { return under_sanction; }
+bool Player::is_sanctioned() const { return flags().sanctioned & flag_bit(); }
 
 /**
  * @brief Returns whether the player is blocked from using arrest.
  */
-bool Player::is_arrest_disabled() const { return arrest_disabled; }
+bool Player::is_arrest_disabled() const { return flags().arrest_disabled & flag_bit(); }
 
 /**
  * @brief Enables the ability to arrest for the player.
  */
-void Player::enable_arrest() { arrest_disabled = false; }
+void Player::enable_arrest() { flags().arrest_disabled &= ~flag_bit(); }
 
 /**
  * @brief Disables the ability to arrest for the player.
  */
-void Player::disable_arrest() { arrest_disabled = true; }
+void Player::disable_arrest() { flags().arrest_disabled |= flag_bit(); }
+
+// ============================
+// 🔹 Checks
+// ============================
+
+namespace {
+
+const char *const UNDER_SANCTION = "You are under sanction and cannot use Gather/Tax this turn.";
+
+/**
+ * @brief The name an action other than the player's role's own is refused under.
+ */
+const char *ability_name(StatAction action) {
+    switch (action) {
+        case StatAction::Invest: return "invest";
+        case StatAction::UndoTax: return "undo_tax";
+        case StatAction::UndoBribe: return "undo_bribe";
+        case StatAction::UndoCoup: return "undo_coup";
+        case StatAction::PeekAndDisable: return "peek_and_disable";
+        default: return "an unknown action";
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Throws the exception class named by `reason`.
+ */
+void Refusal::raise() const {
+    switch (reason) {
+        case Rejection::NotYourTurn: throw NotYourTurnException();
+        case Rejection::GameAlreadyOver: throw GameAlreadyOverException();
+        case Rejection::PlayerNotFound: throw PlayerNotFoundException(player ? player->get_name() : string());
+        case Rejection::PlayerAlreadyDead: throw PlayerAlreadyDeadException(player->get_name());
+        case Rejection::CannotTargetYourself: throw CannotTargetYourselfException(text);
+        case Rejection::NotEnoughCoins: throw NotEnoughCoinsException(required, current);
+        case Rejection::MustCoup: throw MustCoupWith10CoinsException();
+        case Rejection::UndoNotAllowed: throw UndoNotAllowed(player->role(), text);
+        default: throw InvalidActionException(text);
+    }
+}
+
+/**
+ * @brief Refuses a player who is not in turn.
+ */
+Refusal Player::check_turn() const
+{
+    if (game->get_all_players_raw().empty())
+        return {Rejection::InvalidAction, "No players in game."};
+    if (game->turn_id() != player_id)
+        return {Rejection::NotYourTurn};
+    return {};
+}
+
+/**
+ * @brief Refuses any action once the game is over.
+ */
+Refusal Player::check_active() const
+{
+    if (game->is_game_over())
+        return {Rejection::GameAlreadyOver};
+    return {};
+}
+
+/**
+ * @brief Runs the checks of `action` against the game's rules.
+ */
+Refusal Player::check(StatAction action, const Player *target) const
+{
+    return game->with_rules([&](const auto &rules) { return check_rules(action, target, rules); });
+}
+
+/**
+ * @brief The checks of each action, in the order the rules apply them.
+ *
+ * The game-over check comes last: it is what the action used to hit when logging itself.
+ */
+template <typename Rules>
+Refusal Player::check_rules(StatAction action, const Player *target, const Rules &rules) const
+{
+    const bool targeted = action == StatAction::Arrest || action == StatAction::Sanction || action == StatAction::Coup;
+    if (targeted && !target)
+        return {Rejection::PlayerNotFound};
+    const Refusal must_coup = coin_count >= rules.forced_coup_at ? Refusal{Rejection::MustCoup} : Refusal{};
+
+    switch (action) {
+        case StatAction::Gather:
+        case StatAction::Tax:
+            if (Refusal r = check_turn())
+                return r;
+            if (is_sanctioned())
+                return {Rejection::InvalidAction, UNDER_SANCTION};
+            if (must_coup)
+                return must_coup;
+            return check_active();
+
+        case StatAction::Skip:
+            if (must_coup)
+                return must_coup;
+            if (Refusal r = check_active())
+                return r;
+            if (!game->get_player_by_id(player_id))
+                return {Rejection::PlayerNotFound};
+            return {};
+
+        case StatAction::Bribe:
+            if (Refusal r = check_turn())
+                return r;
+            if (must_coup)
+                return must_coup;
+            if (coin_count < rules.bribe_cost)
+                return {Rejection::NotEnoughCoins, "", nullptr, rules.bribe_cost, coin_count};
+            return check_active();
+
+        case StatAction::Arrest:
+            if (Refusal r = check_turn())
+                return r;
+            if (must_coup)
+                return must_coup;
+            if (target->get_name() == name)
+                return {Rejection::CannotTargetYourself, "arrest"};
+            if (!target->is_active())
+                return {Rejection::PlayerAlreadyDead, "", target};
+            if (target->coins() == 0 || (target->role() == "Merchant" && target->coins() < 2))
+                return {Rejection::InvalidAction, "Target doesn't have enough coins to be arrested."};
+            if (is_arrest_disabled())
+                return {Rejection::InvalidAction, "You are blocked from using arrest this turn."};
+            if (game->arrested_same_target(target->id()))
+                return {Rejection::InvalidAction, "Cannot arrest the same player twice in a row."};
+            return check_active();
+
+        case StatAction::Sanction: {
+            if (Refusal r = check_turn())
+                return r;
+            if (must_coup)
+                return must_coup;
+            int cost = rules.sanction_cost;
+            if (coin_count >= cost && target->role() == "Judge")
+                cost += rules.judge_sanction_extra;
+            if (coin_count < cost)
+                return {Rejection::NotEnoughCoins, "", nullptr, cost, coin_count};
+            return check_active();
+        }
+
+        case StatAction::Coup:
+            if (Refusal r = check_turn())
+                return r;
+            if (coin_count < rules.coup_cost)
+                return {Rejection::NotEnoughCoins, "", nullptr, rules.coup_cost, coin_count};
+            if (Refusal r = check_active())
+                return r;
+            if (!game->get_player_by_id(target->id()))
+                return {Rejection::PlayerNotFound, "", target};
+            return {};
+
+        default: // the abilities of the roles, which override check() for their own
+            return {Rejection::UndoNotAllowed, ability_name(action), this};
+    }
+}
 
 // ============================
 // 🔹 Primary Actions
 // ============================
+//
+// Each action runs through act(): check() first, then the body with the effects. Bodies
+// that depend on the rules are generic lambdas run through Game::with_rules, so they are
+// compiled once with the standard costs folded in and once reading a run-time RulesConfig.
+// Trace spans split an action into "validate" (check()) and "execute" (the body).
 
 /**
  * @brief Player gathers 1 coin.
@@ -96,14 +278,12 @@ void Player::disable_arrest() { arrest_disabled = true; }
  */
 void Player::gather()
 {
-    if (game->turn() != name)
-        throw NotYourTurnException();
-    if (under_sanction)
-        throw InvalidActionException("You are under sanction and cannot use Gather/Tax this turn.");
-    ensure_coup_required();
-    set_coins(coins() + 1);
-    game->perform_action("gather", name);
-    game->next_turn();
+    COUP_TRACE_SPAN("Player::gather");
+    act(StatAction::Gather, nullptr, [&] {
+        game->with_rules([this](const auto &rules) { set_coins(coin_count + rules.gather_income); });
+        game->perform_action("gather", player_id);
+        game->next_turn();
+    });
 }
 
 /**
@@ -111,9 +291,11 @@ void Player::gather()
  */
 void Player::skip_turn()
 {
-    ensure_coup_required();
-    game->perform_action("Skip Turn", name);
-    game->next_turn();
+    COUP_TRACE_SPAN("Player::skip_turn");
+    act(StatAction::Skip, nullptr, [&] {
+        game->perform_action("Skip Turn", player_id);
+        game->next_turn();
+    });
 }
 
 /**
@@ -123,30 +305,25 @@ void Player::skip_turn()
  */
 void Player::tax()
 {
-    if (game->turn() != name)
-        throw NotYourTurnException();
-    if (under_sanction)
-        throw InvalidActionException("You are under sanction and cannot use Gather/Tax this turn.");
-    ensure_coup_required();
-    set_coins(coins() + 2);
-    game->perform_action("tax", name);
-    game->next_turn();
+    COUP_TRACE_SPAN("Player::tax");
+    act(StatAction::Tax, nullptr, [&] {
+        game->with_rules([this](const auto &rules) { set_coins(coin_count + rules.tax_income); });
+        game->perform_action("tax", player_id);
+        game->next_turn();
+    });
 }
 
 /**
- * @brief Player performs a bribe (costs 4 coins).
+ * @brief Player performs a bribe (costs RulesConfig::bribe_cost, 4 by default).
  * @throws NotYourTurnException or NotEnoughCoinsException.
  */
 void Player::bribe()
 {
-    if (game->turn() != name)
-        throw NotYourTurnException();
-    ensure_coup_required();
-    const int cost = 4;
-    if (coins() < cost)
-        throw NotEnoughCoinsException(cost, coins());
-    set_coins(coins() - cost);
-    game->perform_action("bribe", name);
+    COUP_TRACE_SPAN("Player::bribe");
+    act(StatAction::Bribe, nullptr, [&] {
+        game->with_rules([this](const auto &rules) { set_coins(coin_count - rules.bribe_cost); });
+        game->perform_action("bribe", player_id);
+    });
 }
 
 // ============================
@@ -160,65 +337,48 @@ void Player::bribe()
  */
 void Player::arrest(Player &target)
 {
-    if (game->turn() != name)
-        throw NotYourTurnException();
-    ensure_coup_required();
-
-    if (target.get_name() == name)
-        throw CannotTargetYourselfException("arrest");
-    if (!target.is_active())
-        throw PlayerAlreadyDeadException(target.get_name());
-    if (target.coins() == 0 || (target.role() == "Merchant" && target.coins() < 2))
-        throw InvalidActionException("Target doesn't have enough coins (" + std::to_string(target.coins()) + ").");
-    if (game->is_arrest_blocked(name))
-        throw InvalidActionException("You are blocked from using arrest this turn.");
-    if (game->arrested_same_target(target.get_name()))
-        throw InvalidActionException("Cannot arrest the same player twice in a row.");
-
-    target.on_arrest();
-    if (target.role() == "Merchant")
-    {
-        target.set_coins(target.coins() - 2);
-    }
-    else
-    {
-        target.set_coins(target.coins() - 1);
-        set_coins(coins() + 1);
-    }
-
-    game->set_last_arrest_target(target.get_name());
-    game->perform_action("arrest", name, target.get_name());
-    game->next_turn();
+    COUP_TRACE_SPAN("Player::arrest");
+    act(StatAction::Arrest, &target, [&] {
+        {
+            COUP_TRACE_SPAN("on_arrest");
+            target.on_arrest();
+        }
+        if (target.role() == "Merchant")
+        {
+            target.set_coins(target.coins() - 2);
+        }
+        else
+        {
+            target.set_coins(target.coins() - 1);
+            set_coins(coins() + 1);
+        }
+
+        game->set_last_arrest_target(target.id());
+        game->perform_action("arrest", player_id, target.id());
+        game->next_turn();
+    });
 }
 
 /**
- * @brief Player sanctions a target (costs 3 or 4 coins depending on target).
+ * @brief Player sanctions a target (costs RulesConfig::sanction_cost, plus judge_sanction_extra on a Judge).
  * @param target The player to sanction.
  * @throws NotYourTurnException or NotEnoughCoinsException.
  */
 void Player::sanction(Player &target)
 {
-    if (game->turn() != name)
-        throw NotYourTurnException();
-    ensure_coup_required();
-
-    const int cost = 3;
-    if (coins() < cost)
-        throw NotEnoughCoinsException(cost, coins());
-
-    target.on_sanction();
-    int total_cost = cost;
-
-    if (target.role() == "Judge")
-    {
-        if (coins() < cost + 1)
-            throw NotEnoughCoinsException(cost + 1, coins());
-        total_cost += 1;
-    }
-
-    set_coins(coins() - total_cost);
-    game->perform_action("sanction", name, target.get_name());
-    game->next_turn();
+    COUP_TRACE_SPAN("Player::sanction");
+    act(StatAction::Sanction, &target, [&] {
+        const int cost = game->with_rules([&target](const auto &rules) {
+            return rules.sanction_cost + (target.role() == "Judge" ? rules.judge_sanction_extra : 0);
+        });
+        {
+            COUP_TRACE_SPAN("on_sanction");
+            target.on_sanction();
+        }
+        set_coins(coin_count - cost);
+        game->perform_action("sanction", player_id, target.id());
+        game->next_turn();
+    });
 }
 
 /**
@@ -228,17 +388,14 @@ void Player::sanction(Player &target)
  */
 void Player::coup(const Player &target)
 {
-    if (game->turn() != name)
-        throw NotYourTurnException();
-    const int cost = 7;
-    if (coins() < cost)
-        throw NotEnoughCoinsException(cost, coins());
-
-    game->remove_player(target.get_name());
-    set_coins(coins() - cost);
-    game->perform_action("coup", name, target.get_name());
-    game->add_to_coup(this->get_name(), target.get_name());
-    game->next_turn();
+    COUP_TRACE_SPAN("Player::coup");
+    act(StatAction::Coup, &target, [&] {
+        game->add_to_coup(player_id, target.id()); // first, so the elimination waits for it to be final
+        game->remove_player(target.id());
+        game->with_rules([this](const auto &rules) { set_coins(coin_count - rules.coup_cost); });
+        game->perform_action("coup", player_id, target.id());
+        game->next_turn();
+    });
 }
 
 // ============================
@@ -247,14 +404,11 @@ void Player::coup(const Player &target)
 
 /**
  * @brief Ensures a player is not bypassing a required coup.
- * @throws MustCoupWith10CoinsException if coins >= 10.
+ * @throws MustCoupWith10CoinsException if coins >= RulesConfig::forced_coup_at (10 by default).
  */
 void Player::ensure_coup_required() const
 {
-    if (coins() >= 10)
-    {
-        throw MustCoupWith10CoinsException();
-    }
+    game->with_rules([this](const auto &rules) { ensure_coup_required(rules); });
 }
 
 // ============================
@@ -269,12 +423,12 @@ void Player::on_arrest() {}
 /**
  * @brief Removes sanction status from player.
  */
-void Player::unsanction() { under_sanction = false; }
+void Player::unsanction() { flags().sanctioned &= ~flag_bit(); }
 
 /**
  * @brief Applies sanction status to player.
  */
-void Player::on_sanction() { under_sanction = true; }
+void Player::on_sanction() { flags().sanctioned |= flag_bit(); }
 
 /**
  * @brief Called at the start of a player's turn.
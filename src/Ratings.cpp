@@ -0,0 +1,152 @@
+// Ratings.cpp - Elo and TrueSkill ratings of multiplayer games
+// Anksilae@gmail.com
+
+#include "Ratings.hpp"
+#include "Exceptions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace coup {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+void check_game(size_t competitors, const std::vector<size_t> &who, const std::vector<int> &ranks) {
+    if (who.size() != ranks.size())
+        throw InvalidActionException("A game needs one rank per seat.");
+    for (size_t c : who)
+        if (c >= competitors)
+            throw InvalidActionException("Unknown competitor in a rated game.");
+}
+
+/**
+ * @brief Standard normal density.
+ */
+double pdf(double t) {
+    return std::exp(-0.5 * t * t) / std::sqrt(2 * PI);
+}
+
+/**
+ * @brief Standard normal distribution function.
+ */
+double cdf(double t) {
+    return 0.5 * std::erfc(-t / std::sqrt(2.0));
+}
+
+/**
+ * @brief Mean correction of a win by a performance margin of `t` standard deviations.
+ */
+double v_win(double t) {
+    const double denom = cdf(t);
+    return denom > 1e-300 ? pdf(t) / denom : -t;
+}
+
+} // namespace
+
+// ======================
+// Elo
+// ======================
+
+EloRatings::EloRatings(size_t competitors, double k, double initial)
+    : k_factor(k), ratings(competitors, initial), points(competitors, 0.0), pairs(competitors, 0) {}
+
+void EloRatings::update(const std::vector<size_t> &who, const std::vector<int> &ranks) {
+    check_game(ratings.size(), who, ranks);
+    if (who.size() < 2)
+        return;
+
+    const double k = k_factor / static_cast<double>(who.size() - 1);
+    std::vector<double> delta(who.size(), 0.0);
+    for (size_t a = 0; a < who.size(); ++a) {
+        for (size_t b = a + 1; b < who.size(); ++b) {
+            if (who[a] == who[b])
+                continue;
+            const double expected = 1.0 / (1.0 + std::pow(10.0, (ratings[who[b]] - ratings[who[a]]) / 400.0));
+            const double actual = ranks[a] < ranks[b] ? 1.0 : ranks[a] == ranks[b] ? 0.5 : 0.0;
+            delta[a] += k * (actual - expected);
+            delta[b] -= k * (actual - expected);
+            points[who[a]] += actual;
+            points[who[b]] += 1.0 - actual;
+            ++pairs[who[a]];
+            ++pairs[who[b]];
+        }
+    }
+    for (size_t s = 0; s < who.size(); ++s)
+        ratings[who[s]] += delta[s];
+}
+
+double EloRatings::score(size_t competitor) const {
+    return pairs[competitor] ? points[competitor] / static_cast<double>(pairs[competitor]) : 0.5;
+}
+
+double EloRatings::interval(size_t competitor) const {
+    // Elo difference d = 400 log10(p / (1 - p)); its standard error follows from the
+    // binomial error of the score p by the delta method
+    const double p = score(competitor);
+    const double n = static_cast<double>(pairs[competitor]);
+    if (n == 0 || p <= 0.0 || p >= 1.0)
+        return std::numeric_limits<double>::infinity();
+    return 1.96 * 400.0 / (std::log(10.0) * std::sqrt(n * p * (1 - p)));
+}
+
+// ======================
+// TrueSkill
+// ======================
+
+TrueSkillRatings::TrueSkillRatings(size_t competitors, double mu, double sigma, double beta, double tau)
+    : beta2(beta * beta), tau2(tau * tau), means(competitors, mu), variances(competitors, sigma * sigma) {}
+
+double TrueSkillRatings::sigma(size_t competitor) const {
+    return std::sqrt(variances[competitor]);
+}
+
+void TrueSkillRatings::update(const std::vector<size_t> &who, const std::vector<int> &ranks) {
+    check_game(means.size(), who, ranks);
+    const size_t seats = who.size();
+
+    // Competitors of the game, each once; slot[s] is the entry of seat s
+    involved.assign(who.begin(), who.end());
+    std::sort(involved.begin(), involved.end());
+    involved.erase(std::unique(involved.begin(), involved.end()), involved.end());
+    slot.resize(seats);
+    for (size_t s = 0; s < seats; ++s)
+        slot[s] = std::lower_bound(involved.begin(), involved.end(), who[s]) - involved.begin();
+    for (size_t c : involved)
+        variances[c] += tau2;
+
+    // Distinct places in order; every seat of one is compared with every seat of the next
+    places.assign(ranks.begin(), ranks.end());
+    std::sort(places.begin(), places.end());
+    places.erase(std::unique(places.begin(), places.end()), places.end());
+
+    mean_delta.assign(involved.size(), 0.0);
+    variance_scale.assign(involved.size(), 1.0);
+    for (size_t p = 0; p + 1 < places.size(); ++p) {
+        for (size_t a = 0; a < seats; ++a) {
+            if (ranks[a] != places[p])
+                continue;
+            for (size_t b = 0; b < seats; ++b) {
+                if (ranks[b] != places[p + 1] || who[a] == who[b])
+                    continue;
+                const size_t winner = who[a];
+                const size_t loser = who[b];
+                const double c = std::sqrt(2 * beta2 + variances[winner] + variances[loser]);
+                const double t = (means[winner] - means[loser]) / c;
+                const double v = v_win(t);
+                const double w = v * (v + t);
+                mean_delta[slot[a]] += variances[winner] / c * v;
+                mean_delta[slot[b]] -= variances[loser] / c * v;
+                variance_scale[slot[a]] *= std::max(1e-4, 1 - variances[winner] / (c * c) * w);
+                variance_scale[slot[b]] *= std::max(1e-4, 1 - variances[loser] / (c * c) * w);
+            }
+        }
+    }
+    for (size_t c = 0; c < involved.size(); ++c) {
+        means[involved[c]] += mean_delta[c];
+        variances[involved[c]] *= variance_scale[c];
+    }
+}
+
+} // namespace coup
@@ -0,0 +1,324 @@
+// ReactionScheduler.cpp - Non-blocking reaction windows for out-of-turn abilities
+// Anksilae@gmail.com
+
+#include "ReactionScheduler.hpp"
+#include "Exceptions.hpp"
+#include "Game.hpp"
+#include "General.hpp"
+#include "Governor.hpp"
+#include "Judge.hpp"
+#include "Spy.hpp"
+#include <algorithm>
+
+namespace coup {
+
+namespace {
+
+/**
+ * @brief Applies one reaction through the responder's role.
+ * @throws Whatever the ability throws.
+ */
+void apply(Game &game, const ReactionOffer &offer, PlayerId target_id) {
+    Player *responder = game.get_player_by_id(offer.responder);
+    Player *target = game.get_player_by_id(target_id);
+    if (!responder || !target)
+        throw InvalidActionException("Reaction names an unknown player.");
+
+    switch (offer.kind) {
+        case ReactionKind::UndoCoup: dynamic_cast<General &>(*responder).undo_coup(*target); break;
+        case ReactionKind::UndoBribe: dynamic_cast<Judge &>(*responder).undo_bribe(*target); break;
+        case ReactionKind::UndoTax: dynamic_cast<Governor &>(*responder).undo_tax(*target); break;
+        case ReactionKind::PeekAndDisable: dynamic_cast<Spy &>(*responder).peek_and_disable(*target); break;
+    }
+}
+
+} // namespace
+
+const char *to_string(ReactionKind kind) {
+    switch (kind) {
+        case ReactionKind::UndoCoup: return "undo_coup";
+        case ReactionKind::UndoBribe: return "undo_bribe";
+        case ReactionKind::UndoTax: return "undo_tax";
+        case ReactionKind::PeekAndDisable: return "peek_and_disable";
+    }
+    return "unknown";
+}
+
+ReactionScheduler::ReactionScheduler(Clock::duration human_deadline) : deadline_after(human_deadline) {}
+
+void ReactionScheduler::set_bot(const Game &game, PlayerId player, BotResponder responder) {
+    if (player >= MAX_PLAYERS)
+        throw InvalidActionException("Bot needs a player id.");
+    games[&game].bots[player] = std::move(responder);
+}
+
+void ReactionScheduler::forget(const Game &game) {
+    for (uint32_t slot = 0; slot < windows.size(); ++slot) {
+        Window &w = windows[slot];
+        if (w.open && w.game == &game)
+            close((uint64_t{w.generation} << 32) | slot, w, nullptr);
+    }
+    games.erase(&game);
+}
+
+// ======================
+// Opening Windows
+// ======================
+
+uint64_t ReactionScheduler::open(Game &game, PlayerId actor, Clock::time_point now) {
+    const std::string_view action = game.last_action_of(actor);
+    PlayerId target = NO_PLAYER;
+    if (action == "coup") {
+        const auto &attackers = game.get_coup_attackers();
+        for (PlayerId t = 0; t < attackers.size(); ++t)
+            if (attackers[t] == actor)
+                target = t;
+    }
+    return open(game, actor, action, target, now);
+}
+
+uint64_t ReactionScheduler::open(Game &game, PlayerId actor, std::string_view action, PlayerId target,
+                                 Clock::time_point now) {
+    // Offers in seat order from the seat after the actor: ties of one ability go to the earliest
+    const auto &seats = game.get_all_players_raw();
+    size_t start = 0;
+    for (size_t s = 0; s < seats.size(); ++s)
+        if (seats[s]->id() == actor)
+            start = s + 1;
+
+    std::vector<ReactionOffer> offers;
+    const int undo_coup_cost = game.rules().general_undo_cost;
+    for (size_t i = 0; i < seats.size(); ++i) {
+        Player *p = seats[(start + i) % seats.size()];
+        if (p->id() == actor)
+            continue;
+        const PlayerId id = p->id();
+
+        if (dynamic_cast<Governor *>(p)) {
+            if (action == "tax" && p->is_active() && !game.used_this_round(Game::RoundAbility::UndoTax) &&
+                game.can_undo_action(actor, "tax"))
+                offers.push_back({id, ReactionKind::UndoTax, actor});
+        } else if (dynamic_cast<Judge *>(p)) {
+            if (action == "bribe" && p->is_active() && !game.used_this_round(Game::RoundAbility::UndoBribe) &&
+                game.can_undo_action(actor, "bribe"))
+                offers.push_back({id, ReactionKind::UndoBribe, actor});
+        } else if (dynamic_cast<General *>(p)) {
+            // A General may undo a coup on itself, so the target need not be alive
+            if (action == "coup" && target != NO_PLAYER && (p->is_active() || id == target) &&
+                p->coins() >= undo_coup_cost && game.is_coup_pending_on(target) &&
+                !game.used_this_round(Game::RoundAbility::UndoCoup))
+                offers.push_back({id, ReactionKind::UndoCoup, target});
+        } else if (dynamic_cast<Spy *>(p)) {
+            if (p->is_active() && !game.used_this_round(Game::RoundAbility::PeekDisable))
+                offers.push_back({id, ReactionKind::PeekAndDisable, NO_PLAYER});
+        }
+    }
+    if (offers.empty())
+        return NO_WINDOW;
+
+    GameEntry &entry = games[&game];
+    const bool all_bots = std::all_of(offers.begin(), offers.end(),
+                                      [&](const ReactionOffer &offer) { return bool(entry.bots[offer.responder]); });
+
+    uint32_t slot;
+    if (!free_slots.empty()) {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(windows.size());
+        windows.emplace_back();
+    }
+    Window &w = windows[slot];
+    ++w.generation;
+    w.open = true;
+    w.queued = false;
+    w.timed = !all_bots;
+    w.game = &game;
+    w.actor = actor;
+    w.action.assign(action);
+    w.offers = std::move(offers);
+    w.answers.assign(w.offers.size(), Answer{});
+    w.unanswered = w.offers.size();
+
+    const uint64_t id = (uint64_t{w.generation} << 32) | slot;
+    ++entry.open_windows;
+    ++open_count;
+    if (w.timed)
+        deadlines.emplace(now + deadline_after, id); // bots answer on the next poll: no deadline needed
+    mark_ready(id, w);
+    return id;
+}
+
+// ======================
+// Answers
+// ======================
+
+ReactionScheduler::Window *ReactionScheduler::find(uint64_t window) {
+    const uint32_t slot = static_cast<uint32_t>(window);
+    if (slot >= windows.size() || windows[slot].generation != window >> 32 || !windows[slot].open)
+        return nullptr;
+    return &windows[slot];
+}
+
+const ReactionScheduler::Window *ReactionScheduler::find(uint64_t window) const {
+    return const_cast<ReactionScheduler *>(this)->find(window);
+}
+
+void ReactionScheduler::mark_ready(uint64_t id, Window &w) {
+    if (!w.queued) {
+        w.queued = true;
+        ready.push_back(id);
+    }
+}
+
+void ReactionScheduler::answer(Window &w, size_t offer, PlayerId target) {
+    if (w.answers[offer].answered)
+        return;
+    w.answers[offer] = {true, target};
+    --w.unanswered;
+}
+
+void ReactionScheduler::react(uint64_t window, PlayerId responder, ReactionKind kind, PlayerId target) {
+    Window *w = find(window);
+    if (!w)
+        throw InvalidActionException("Reaction window is closed.");
+    for (size_t i = 0; i < w->offers.size(); ++i) {
+        const ReactionOffer &offer = w->offers[i];
+        if (offer.responder != responder || offer.kind != kind)
+            continue;
+        if (w->answers[i].answered)
+            throw InvalidActionException(std::string(to_string(kind)) + " was already answered.");
+        if (offer.target != NO_PLAYER)
+            target = offer.target;
+        if (target == NO_PLAYER)
+            throw InvalidActionException(std::string(to_string(kind)) + " needs a target.");
+        answer(*w, i, target);
+        mark_ready(window, *w);
+        return;
+    }
+    throw InvalidActionException(std::string("No ") + to_string(kind) + " offer for this player.");
+}
+
+void ReactionScheduler::pass(uint64_t window, PlayerId responder) {
+    Window *w = find(window);
+    if (!w)
+        throw InvalidActionException("Reaction window is closed.");
+    for (size_t i = 0; i < w->offers.size(); ++i)
+        if (w->offers[i].responder == responder)
+            answer(*w, i, NO_PLAYER);
+    mark_ready(window, *w);
+}
+
+// ======================
+// Resolution
+// ======================
+
+size_t ReactionScheduler::poll(std::vector<ResolvedWindow> &resolved, Clock::time_point now) {
+    const size_t before = resolved.size();
+
+    std::vector<uint64_t> batch;
+    batch.swap(ready);
+    for (uint64_t id : batch) {
+        Window *w = find(id);
+        if (!w)
+            continue;
+        w->queued = false;
+
+        auto entry = games.find(w->game);
+        if (entry != games.end()) {
+            for (size_t i = 0; i < w->offers.size(); ++i) {
+                const ReactionOffer &offer = w->offers[i];
+                const BotResponder &bot = entry->second.bots[offer.responder];
+                if (w->answers[i].answered || !bot)
+                    continue;
+                const PlayerId choice = bot(*w->game, offer);
+                answer(*w, i, choice == NO_PLAYER || offer.target == NO_PLAYER ? choice : offer.target);
+            }
+        }
+        if (w->unanswered == 0) {
+            close(id, *w, &resolved);
+        } else if (!w->timed) {
+            w->timed = true; // a bot was dropped after the window opened: its player gets the deadline
+            deadlines.emplace(now + deadline_after, id);
+        }
+    }
+
+    while (!deadlines.empty() && deadlines.top().first <= now) {
+        const uint64_t id = deadlines.top().second;
+        deadlines.pop();
+        if (Window *w = find(id))
+            close(id, *w, &resolved);
+    }
+    return resolved.size() - before;
+}
+
+void ReactionScheduler::close(uint64_t id, Window &w, std::vector<ResolvedWindow> *resolved) {
+    if (resolved) {
+        ResolvedWindow out;
+        out.id = id;
+        out.game = w.game;
+        out.actor = w.actor;
+        out.action = w.action;
+
+        // Chosen reactions by priority (stable, so seat order breaks ties), then the rest
+        std::vector<size_t> order(w.offers.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            const bool ra = w.answers[a].target != NO_PLAYER;
+            const bool rb = w.answers[b].target != NO_PLAYER;
+            if (ra != rb)
+                return ra;
+            return ra && w.offers[a].kind < w.offers[b].kind;
+        });
+
+        for (size_t i : order) {
+            ReactionOutcome outcome;
+            outcome.offer = w.offers[i];
+            outcome.answered = w.answers[i].answered;
+            outcome.target = w.answers[i].target;
+            outcome.reacted = outcome.target != NO_PLAYER;
+            if (outcome.reacted) {
+                try {
+                    apply(*w.game, outcome.offer, outcome.target);
+                    outcome.applied = true;
+                } catch (const CoupException &e) {
+                    outcome.error = e.what();
+                }
+            }
+            out.outcomes.push_back(std::move(outcome));
+        }
+        resolved->push_back(std::move(out));
+    }
+
+    auto entry = games.find(w.game);
+    if (entry != games.end())
+        --entry->second.open_windows;
+    --open_count;
+    w.open = false;
+    w.queued = false;
+    w.offers.clear();
+    w.answers.clear();
+    free_slots.push_back(static_cast<uint32_t>(&w - windows.data()));
+}
+
+// ======================
+// Queries
+// ======================
+
+const std::vector<ReactionOffer> &ReactionScheduler::offers(uint64_t window) const {
+    static const std::vector<ReactionOffer> none;
+    const Window *w = find(window);
+    return w ? w->offers : none;
+}
+
+bool ReactionScheduler::is_open(uint64_t window) const {
+    return find(window) != nullptr;
+}
+
+bool ReactionScheduler::has_open_window(const Game &game) const {
+    auto entry = games.find(&game);
+    return entry != games.end() && entry->second.open_windows > 0;
+}
+
+} // namespace coup
@@ -0,0 +1,79 @@
+// RulesConfig.cpp - Configurable costs and thresholds
+// Anksilae@gmail.com
+
+#include "RulesConfig.hpp"
+#include "Exceptions.hpp"
+#include <utility>
+
+namespace coup {
+
+namespace {
+
+/**
+ * @brief Every value of a RulesConfig with its name, in declaration order.
+ */
+const std::pair<const char *, int RulesConfig::*> FIELDS[] = {
+    {"gather_income", &RulesConfig::gather_income},
+    {"tax_income", &RulesConfig::tax_income},
+    {"governor_tax", &RulesConfig::governor_tax},
+    {"bribe_cost", &RulesConfig::bribe_cost},
+    {"sanction_cost", &RulesConfig::sanction_cost},
+    {"judge_sanction_extra", &RulesConfig::judge_sanction_extra},
+    {"coup_cost", &RulesConfig::coup_cost},
+    {"forced_coup_at", &RulesConfig::forced_coup_at},
+    {"invest_cost", &RulesConfig::invest_cost},
+    {"invest_return", &RulesConfig::invest_return},
+    {"general_undo_cost", &RulesConfig::general_undo_cost},
+    {"merchant_bonus_at", &RulesConfig::merchant_bonus_at},
+    {"merchant_bonus", &RulesConfig::merchant_bonus},
+};
+
+static_assert(sizeof(RulesConfig) == sizeof(FIELDS) / sizeof(FIELDS[0]) * sizeof(int),
+              "FIELDS must list every RulesConfig value");
+
+int RulesConfig::*member(const std::string &name) {
+    for (const auto &field : FIELDS)
+        if (name == field.first)
+            return field.second;
+    throw InvalidActionException("Unknown rule: " + name);
+}
+
+} // namespace
+
+/**
+ * @brief Rejects negative values and a forced coup the player could not pay for.
+ */
+void RulesConfig::validate() const {
+    for (const auto &field : FIELDS)
+        if (this->*field.second < 0)
+            throw InvalidActionException(std::string("Rule ") + field.first + " cannot be negative.");
+    if (forced_coup_at < coup_cost)
+        throw InvalidActionException("forced_coup_at must be at least coup_cost.");
+}
+
+void RulesConfig::set(const std::string &name, int value) {
+    this->*member(name) = value;
+}
+
+int RulesConfig::get(const std::string &name) const {
+    return this->*member(name);
+}
+
+const std::vector<std::string> &RulesConfig::fields() {
+    static const std::vector<std::string> names = [] {
+        std::vector<std::string> out;
+        for (const auto &field : FIELDS)
+            out.emplace_back(field.first);
+        return out;
+    }();
+    return names;
+}
+
+bool RulesConfig::operator==(const RulesConfig &other) const {
+    for (const auto &field : FIELDS)
+        if (this->*field.second != other.*field.second)
+            return false;
+    return true;
+}
+
+} // namespace coup
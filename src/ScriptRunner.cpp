@@ -0,0 +1,192 @@
+// ScriptRunner.cpp - Headless games played from a line protocol
+// Anksilae@gmail.com
+
+#include "ScriptRunner.hpp"
+#include "Exceptions.hpp"
+#include "General.hpp"
+#include "Governor.hpp"
+#include "Judge.hpp"
+#include "Spy.hpp"
+#include "TurnDriver.hpp"
+#include <sstream>
+
+namespace coup {
+
+namespace {
+
+bool skipped(const std::string &line) {
+    size_t first = line.find_first_not_of(" \t\r");
+    return first == std::string::npos || line[first] == '#';
+}
+
+/**
+ * @brief Reads the next word of a command, rejecting the line if it is missing.
+ */
+std::string word(std::istream &words, const char *what) {
+    std::string w;
+    if (!(words >> w))
+        throw InvalidActionException(std::string("Missing ") + what + ".");
+    return w;
+}
+
+void expect_end(std::istream &words) {
+    std::string extra;
+    if (words >> extra)
+        throw InvalidActionException("Unexpected \"" + extra + "\".");
+}
+
+template <typename Role>
+Role &as_role(Player &player, const char *role) {
+    auto *r = dynamic_cast<Role *>(&player);
+    if (!r)
+        throw InvalidActionException(player.get_name() + " is not a " + role + ".");
+    return *r;
+}
+
+} // namespace
+
+ScriptRunner::ScriptRunner(const RulesConfig &rules, GameLog log) : current(arena, rules, log) {}
+
+void ScriptRunner::new_game() {
+    current.reset();
+}
+
+void ScriptRunner::execute(const std::string &line) {
+    std::istringstream words(line);
+    const std::string command = word(words, "command");
+
+    if (command == "add") {
+        const std::string name = word(words, "player name");
+        const std::string role = word(words, "role");
+        expect_end(words);
+        current.add_player(name, role);
+    } else if (command == "new") {
+        expect_end(words);
+        new_game();
+    } else if (command == "show") {
+        expect_end(words);
+        if (reply)
+            show(*reply);
+    } else if (command == "expect") {
+        run_expect(words);
+    } else if (command == "undo_tax" || command == "undo_bribe" || command == "undo_coup" || command == "peek") {
+        Player &actor = *current.get_player_by_name(word(words, "player"));
+        Player &target = *current.get_player_by_name(word(words, "target"));
+        expect_end(words);
+        run_ability(command, actor, target);
+    } else {
+        Player &actor = *current.get_player_by_name(word(words, "player"));
+        std::string action = command;
+        for (std::string rest; words >> rest;)
+            action.append(" ").append(rest);
+        apply_action(current, actor, TurnAction::parse(action));
+    }
+}
+
+void ScriptRunner::run_ability(const std::string &ability, Player &actor, Player &target) {
+    if (ability == "undo_tax")
+        as_role<Governor>(actor, "Governor").undo_tax(target);
+    else if (ability == "undo_bribe")
+        as_role<Judge>(actor, "Judge").undo_bribe(target);
+    else if (ability == "undo_coup")
+        as_role<General>(actor, "General").undo_coup(target);
+    else
+        as_role<Spy>(actor, "Spy").peek_and_disable(target);
+}
+
+const PlayerView &ScriptRunner::view_of(const std::string &name) {
+    GameEngine::capture(current, view);
+    for (const PlayerView &p : view.players)
+        if (p.name == name)
+            return p;
+    throw PlayerNotFoundException(name);
+}
+
+void ScriptRunner::run_expect(std::istream &words) {
+    const std::string what = word(words, "expectation");
+    std::string name = word(words, "player name");
+    std::string actual;
+
+    if (what == "coins") {
+        const std::string coins = word(words, "coin count");
+        expect_end(words);
+        const int have = view_of(name).coins;
+        if (std::to_string(have) == coins)
+            return;
+        actual = name + " has " + std::to_string(have) + " coins";
+        name.append(" ").append(coins);
+    } else {
+        expect_end(words);
+        if (what == "alive" || what == "dead") {
+            const bool alive = view_of(name).active;
+            if (alive == (what == "alive"))
+                return;
+            actual = name + (alive ? " is alive" : " is dead");
+        } else if (what == "turn" || what == "winner") {
+            GameEngine::capture(current, view);
+            if (what == "turn") {
+                const PlayerView *p = view.game_over ? nullptr : view.current_player();
+                if (p && p->name == name)
+                    return;
+                actual = p ? "it is " + p->name + "'s turn" : "nobody is in turn";
+            } else {
+                if (view.game_over && view.winner == name)
+                    return;
+                actual = view.game_over ? "the winner is " + view.winner : "the game is not over";
+            }
+        } else {
+            throw InvalidActionException("Unknown expectation \"" + what + "\".");
+        }
+    }
+    throw InvalidActionException("Expected " + what + " " + name + ", but " + actual + ".");
+}
+
+void ScriptRunner::show(std::ostream &out) {
+    GameEngine::capture(current, view);
+    if (view.game_over)
+        out << "winner " << view.winner << '\n';
+    else if (const PlayerView *p = view.current_player())
+        out << "turn " << p->name << '\n';
+    for (const PlayerView &p : view.players)
+        out << "player " << p.name << ' ' << p.role << ' ' << p.coins << (p.active ? " alive" : " dead")
+            << (p.sanctioned ? " sanctioned" : "") << '\n';
+}
+
+ScriptResult ScriptRunner::run(std::istream &in, bool stop_on_error) {
+    ScriptResult result;
+    std::string line;
+    for (size_t number = 1; std::getline(in, line); ++number) {
+        if (skipped(line))
+            continue;
+        ++result.commands;
+        try {
+            execute(line);
+            if (reply)
+                *reply << "ok\n";
+        } catch (const CoupException &e) {
+            if (reply)
+                *reply << "error: " << e.what() << '\n';
+            if (result.errors++ == 0) {
+                result.error_line = number;
+                result.error = e.what();
+            }
+            if (stop_on_error)
+                break;
+        }
+    }
+    if (reply)
+        reply->flush();
+
+    GameEngine::capture(current, view);
+    if (view.game_over)
+        result.winner = view.winner;
+    return result;
+}
+
+ScriptResult ScriptRunner::run_script(const std::string &script, bool stop_on_error) {
+    new_game();
+    std::istringstream in(script);
+    return run(in, stop_on_error);
+}
+
+} // namespace coup
@@ -0,0 +1,109 @@
+// Timeline.cpp - Persistent per-turn history of a game with structural sharing
+// Anksilae@gmail.com
+
+#include "Timeline.hpp"
+#include "Game.hpp"
+#include <algorithm>
+
+namespace coup {
+
+namespace {
+
+bool same(const PlayerView &a, const PlayerView &b) {
+    return a.name == b.name && a.role == b.role && a.coins == b.coins && a.active == b.active &&
+           a.sanctioned == b.sanctioned && a.arrest_disabled == b.arrest_disabled &&
+           a.last_action == b.last_action && a.can_still_undo == b.can_still_undo;
+}
+
+} // namespace
+
+void TimelineState::materialize(GameSnapshot &out) const {
+    out.version = snapshot_version;
+    out.turn = turn;
+    out.players.resize(players.size());
+    for (size_t i = 0; i < players.size(); ++i)
+        out.players[i] = *players[i];
+    out.current = current;
+    out.game_over = game_over;
+    out.winner = winner;
+    out.last_action = last_action;
+    out.coup_pending_list = *coup_pending_list;
+    out.forced_coup_at = forced_coup_at;
+}
+
+// ======================
+// Recording
+// ======================
+
+size_t Timeline::record(const GameSnapshot &snap) {
+    if (!states.empty() && snap.turn < states.back().turn)
+        clear();
+
+    TimelineState next;
+    next.snapshot_version = snap.version;
+    next.turn = snap.turn;
+    next.current = snap.current;
+    next.game_over = snap.game_over;
+    next.winner = snap.winner;
+    next.last_action = snap.last_action;
+    next.forced_coup_at = snap.forced_coup_at;
+
+    // Reuse the previous version's node for every seat (and the coup list) that did not change
+    const TimelineState *prev = states.empty() ? nullptr : &states.back();
+    next.players.reserve(snap.players.size());
+    for (size_t i = 0; i < snap.players.size(); ++i) {
+        if (prev && i < prev->players.size() && same(*prev->players[i], snap.players[i]))
+            next.players.push_back(prev->players[i]);
+        else
+            next.players.push_back(std::make_shared<const PlayerView>(snap.players[i]));
+    }
+    if (prev && *prev->coup_pending_list == snap.coup_pending_list)
+        next.coup_pending_list = prev->coup_pending_list;
+    else
+        next.coup_pending_list = std::make_shared<const TimelineState::CoupList>(snap.coup_pending_list);
+
+    const size_t index = states.size();
+    states.push_back(std::move(next));
+
+    // Turns skipped since the last version keep pointing at it
+    const size_t slot = static_cast<size_t>(snap.turn - first_turn());
+    const size_t fill = turn_end.empty() ? index : turn_end.back();
+    if (turn_end.size() <= slot)
+        turn_end.resize(slot + 1, fill);
+    turn_end[slot] = index;
+    return index;
+}
+
+size_t Timeline::record(const Game &game) {
+    GameEngine::capture(game, scratch);
+    scratch.version = states.empty() ? 1 : states.back().snapshot_version + 1;
+    return record(scratch);
+}
+
+void Timeline::clear() {
+    states.clear();
+    turn_end.clear();
+}
+
+// ======================
+// Queries
+// ======================
+
+size_t Timeline::version_at_turn(int turn) const {
+    if (states.empty() || turn < first_turn())
+        return NO_VERSION;
+    const size_t slot = std::min(static_cast<size_t>(turn - first_turn()), turn_end.size() - 1);
+    return turn_end[slot];
+}
+
+size_t Timeline::shared_players(size_t a, size_t b) const {
+    const TimelineState &x = at(a);
+    const TimelineState &y = at(b);
+    size_t shared = 0;
+    for (size_t i = 0; i < std::min(x.players.size(), y.players.size()); ++i)
+        if (x.players[i] == y.players[i])
+            ++shared;
+    return shared;
+}
+
+} // namespace coup
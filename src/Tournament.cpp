@@ -0,0 +1,307 @@
+// Tournament.cpp - Rated tournaments of bot policies on a thread pool
+// Anksilae@gmail.com
+
+#include "Tournament.hpp"
+#include "Exceptions.hpp"
+#include "Game.hpp"
+#include "GameArena.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace coup {
+
+namespace {
+
+constexpr size_t CHUNK_GAMES = 64; ///< Games a worker plays per work item
+
+/**
+ * @brief A run of consecutive games of one round, played by one worker.
+ */
+struct Chunk {
+    size_t round;
+    size_t first_game;
+    size_t games;
+};
+
+/**
+ * @brief Adds to `table` every multiset of `left` more policies from `from` on.
+ */
+void multisets(size_t policies, size_t left, size_t from, std::vector<size_t> &table,
+               std::vector<std::vector<size_t>> &out) {
+    if (left == 0) {
+        if (table.front() != table.back())
+            out.push_back(table);
+        return;
+    }
+    for (size_t p = from; p < policies; ++p) {
+        table.push_back(p);
+        multisets(policies, left - 1, p, table, out);
+        table.pop_back();
+    }
+}
+
+} // namespace
+
+const std::array<const char *, 6> Tournament::ROLES = {"Governor", "Spy", "Judge", "Baron", "General", "Merchant"};
+
+PolicySpec PolicySpec::parse(const std::string &text) {
+    PolicySpec spec;
+    std::string kind = text;
+    const size_t eq = text.find('=');
+    if (eq != std::string::npos) {
+        spec.name = text.substr(0, eq);
+        kind = text.substr(eq + 1);
+    }
+
+    const size_t colon = kind.find(':');
+    const std::string base = kind.substr(0, colon);
+    if (base == "random") {
+        spec.strength = BotStrength::Random;
+    } else if (base == "greedy") {
+        spec.strength = BotStrength::Greedy;
+    } else if (base == "search") {
+        spec.strength = BotStrength::Search;
+    } else {
+        throw InvalidActionException("Unknown policy: " + text);
+    }
+
+    if (colon != std::string::npos) {
+        const std::string budget = kind.substr(colon + 1);
+        char *end = nullptr;
+        const long ms = std::strtol(budget.c_str(), &end, 10);
+        if (spec.strength != BotStrength::Search || budget.empty() || *end != '\0' || ms <= 0)
+            throw InvalidActionException("Bad think budget in policy: " + text);
+        spec.think_budget_ms = static_cast<int>(ms);
+    }
+    if (spec.name.empty())
+        spec.name = kind;
+    return spec;
+}
+
+Tournament::Tournament(TournamentConfig config)
+    : settings(std::move(config)),
+      elo_ratings(settings.policies.size()),
+      trueskill_ratings(settings.policies.size()),
+      played(settings.policies.size(), 0),
+      won(settings.policies.size(), 0) {
+    if (settings.policies.size() < 2)
+        throw InvalidActionException("A tournament needs at least two policies.");
+    if (settings.seats < 2 || settings.seats > MAX_PLAYERS)
+        throw InvalidActionException("Tables seat 2 to " + std::to_string(MAX_PLAYERS) + " players.");
+    for (size_t p = 0; p < settings.policies.size(); ++p)
+        for (size_t q = 0; q < p; ++q)
+            if (settings.policies[p].name == settings.policies[q].name)
+                throw InvalidActionException("Two policies are named " + settings.policies[p].name + ".");
+    settings.rules.validate();
+    settings.threads = std::max(1u, settings.threads);
+}
+
+std::vector<std::vector<size_t>> Tournament::round_robin_tables(size_t policies, size_t seats) {
+    std::vector<std::vector<size_t>> tables;
+    std::vector<size_t> table;
+    multisets(policies, seats, 0, table, tables);
+    return tables;
+}
+
+std::vector<std::vector<size_t>> Tournament::swiss_tables(const std::vector<size_t> &standings, size_t seats) {
+    std::vector<std::vector<size_t>> tables;
+    for (size_t first = 0; first < standings.size(); first += seats) {
+        std::vector<size_t> table;
+        for (size_t s = 0; s < seats; ++s)
+            table.push_back(standings[(first + s) % standings.size()]);
+        tables.push_back(table);
+    }
+    return tables;
+}
+
+std::vector<size_t> Tournament::standings() const {
+    std::vector<size_t> order(settings.policies.size());
+    for (size_t p = 0; p < order.size(); ++p)
+        order[p] = p;
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return trueskill_ratings.conservative(a) > trueskill_ratings.conservative(b);
+    });
+    return order;
+}
+
+MatchResult Tournament::play_match(const std::vector<size_t> &policy, const std::vector<size_t> &role,
+                                   uint32_t seed) const {
+    MatchResult result;
+    result.seats = policy.size();
+
+    Game game(GameArena::this_thread(), settings.rules, GameLog::Quiet);
+    std::vector<Bot> bots;
+    bots.reserve(policy.size());
+    for (size_t s = 0; s < policy.size(); ++s) {
+        const PolicySpec &spec = settings.policies[policy[s]];
+        game.add_player("P" + std::to_string(s), ROLES[role[s]]);
+        bots.emplace_back(spec.strength, seed * MAX_PLAYERS + static_cast<unsigned>(s), spec.think_budget_ms);
+        result.policy[s] = static_cast<uint16_t>(policy[s]);
+        result.role[s] = static_cast<uint8_t>(role[s]);
+    }
+
+    // Places are handed out from the back as players are eliminated; survivors share place 0
+    int alive = static_cast<int>(policy.size());
+    try {
+        while (!game.is_game_over() && result.turns < settings.max_turns) {
+            const uint64_t before = game.flags().active;
+            bots[game.get_current_turn_index()].play_turn(game, game.turn());
+            ++result.turns;
+            for (uint64_t gone = before & ~game.flags().active; gone; gone &= gone - 1)
+                result.rank[SeatFlags::first(gone)] = --alive;
+        }
+    } catch (const CoupException &) {
+        // No legal move under these rules: the game ends undecided
+    }
+
+    if (game.is_game_over())
+        result.winner = SeatFlags::first(game.flags().active);
+    return result;
+}
+
+void Tournament::record(const MatchResult &result) {
+    std::vector<size_t> who(result.policy.begin(), result.policy.begin() + result.seats);
+    // Rated on who won: the winner beats every other seat, the others tie
+    std::vector<int> ranks(result.seats);
+    for (size_t s = 0; s < result.seats; ++s)
+        ranks[s] = static_cast<int>(s) == result.winner ? 0 : 1;
+    elo_ratings.update(who, ranks);
+    trueskill_ratings.update(who, ranks);
+    for (size_t p : who)
+        ++played[p];
+    if (result.winner >= 0)
+        ++won[result.policy[result.winner]];
+}
+
+void Tournament::run(const ResultSink &sink) {
+    const size_t rounds = settings.pairing == Pairing::Swiss
+                              ? std::max<size_t>(1, std::min(settings.swiss_rounds, settings.games))
+                              : 1;
+    std::vector<size_t> round_start(rounds + 1);
+    for (size_t r = 0; r <= rounds; ++r)
+        round_start[r] = settings.games * r / rounds;
+
+    std::vector<Chunk> chunks;
+    for (size_t r = 0; r < rounds; ++r)
+        for (size_t g = round_start[r]; g < round_start[r + 1]; g += CHUNK_GAMES)
+            chunks.push_back({r, g, std::min(CHUNK_GAMES, round_start[r + 1] - g)});
+    if (chunks.empty())
+        return;
+
+    // Tables of round r are published once every game before it has been recorded
+    std::vector<std::vector<std::vector<size_t>>> tables(rounds);
+    tables[0] = settings.pairing == Pairing::Swiss ? swiss_tables(standings(), settings.seats)
+                                                   : round_robin_tables(settings.policies.size(), settings.seats);
+    size_t published = 0;
+
+    std::vector<std::vector<MatchResult>> finished(chunks.size());
+    std::vector<bool> ready(chunks.size(), false);
+    size_t next_record = 0;
+    std::mutex lock;
+    std::condition_variable round_ready;
+    std::exception_ptr failure;
+    std::atomic<size_t> next_chunk{0};
+
+    auto worker = [&] {
+        for (size_t c; (c = next_chunk.fetch_add(1)) < chunks.size();) {
+            const Chunk &chunk = chunks[c];
+            try {
+                const std::vector<std::vector<size_t>> *round_tables;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    round_ready.wait(guard, [&] { return published >= chunk.round || failure; });
+                    if (failure)
+                        return;
+                    round_tables = &tables[chunk.round];
+                }
+
+                std::vector<MatchResult> results;
+                results.reserve(chunk.games);
+                std::vector<size_t> policy(settings.seats);
+                std::vector<size_t> role(settings.seats);
+                for (size_t g = chunk.first_game; g < chunk.first_game + chunk.games; ++g) {
+                    // Table cycles fastest, then the policies' rotation over the seats, then the roles'
+                    const size_t local = g - round_start[chunk.round];
+                    const std::vector<size_t> &table = (*round_tables)[local % round_tables->size()];
+                    const size_t cycle = local / round_tables->size();
+                    const size_t rotation = cycle % settings.seats;
+                    const size_t role_offset = cycle / settings.seats % ROLES.size();
+                    for (size_t s = 0; s < settings.seats; ++s) {
+                        policy[s] = table[(s + rotation) % settings.seats];
+                        role[s] = (s + role_offset) % ROLES.size();
+                    }
+                    results.push_back(play_match(policy, role, settings.seed + static_cast<uint32_t>(g)));
+                    results.back().game = g;
+                    results.back().round = chunk.round;
+                }
+
+                std::lock_guard<std::mutex> guard(lock);
+                finished[c] = std::move(results);
+                ready[c] = true;
+                while (next_record < chunks.size() && ready[next_record]) {
+                    for (const MatchResult &result : finished[next_record]) {
+                        record(result);
+                        if (sink)
+                            sink(result);
+                    }
+                    std::vector<MatchResult>().swap(finished[next_record]);
+                    const size_t round = chunks[next_record++].round;
+                    const bool round_done = next_record == chunks.size() || chunks[next_record].round != round;
+                    if (round_done && round + 1 < rounds) {
+                        tables[round + 1] = swiss_tables(standings(), settings.seats);
+                        published = round + 1;
+                        round_ready.notify_all();
+                    }
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(lock);
+                if (!failure)
+                    failure = std::current_exception();
+                round_ready.notify_all();
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < settings.threads; ++t)
+        threads.emplace_back(worker);
+    worker();
+    for (auto &t : threads)
+        t.join();
+    if (failure)
+        std::rethrow_exception(failure);
+}
+
+void Tournament::write_header(std::ostream &out) const {
+    out << "game,round";
+    for (size_t s = 0; s < settings.seats; ++s)
+        out << ",policy" << s << ",role" << s;
+    out << ",winner,turns\n";
+}
+
+void Tournament::write_result(std::ostream &out, const MatchResult &result) const {
+    out << result.game << ',' << result.round;
+    for (size_t s = 0; s < result.seats; ++s)
+        out << ',' << settings.policies[result.policy[s]].name << ',' << ROLES[result.role[s]];
+    out << ',' << (result.winner >= 0 ? settings.policies[result.policy[result.winner]].name : "") << ','
+        << result.turns << '\n';
+}
+
+void Tournament::write_standings(std::ostream &out) const {
+    out << "policy,games,wins,win_rate,elo,elo_95,mu,sigma,conservative\n";
+    for (size_t p : standings()) {
+        const double games = static_cast<double>(played[p]);
+        out << settings.policies[p].name << ',' << played[p] << ',' << won[p] << ','
+            << (played[p] ? won[p] / games : 0.0) << ',' << elo_ratings.rating(p) << ','
+            << elo_ratings.interval(p) << ',' << trueskill_ratings.mu(p) << ',' << trueskill_ratings.sigma(p)
+            << ',' << trueskill_ratings.conservative(p) << '\n';
+    }
+}
+
+} // namespace coup
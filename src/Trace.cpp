@@ -0,0 +1,176 @@
+// Trace.cpp - Per-thread span rings and their Chrome trace-event export
+// Anksilae@gmail.com
+
+#include "Trace.hpp"
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace coup {
+
+namespace {
+
+/**
+ * @brief One span; fields are atomics so an export may read a ring while its thread writes.
+ */
+struct Slot {
+    std::atomic<const char *> name{nullptr};
+    std::atomic<uint64_t> begin{0};
+    std::atomic<uint64_t> end{0};
+};
+
+struct Ring {
+    uint32_t tid = 0;
+    std::atomic<uint64_t> head{0};  ///< Events ever written (written by the owning thread only)
+    std::atomic<uint64_t> start{0}; ///< Events before this one were cleared (head itself never goes back)
+    Slot slots[Tracer::RING_EVENTS];
+
+    /**
+     * @brief Index of the oldest event kept: the ring holds the last RING_EVENTS, since the last clear().
+     */
+    uint64_t first(uint64_t written) const {
+        const uint64_t cleared = start.load(std::memory_order_acquire);
+        const uint64_t oldest = written > Tracer::RING_EVENTS ? written - Tracer::RING_EVENTS : 0;
+        return std::max(cleared, oldest);
+    }
+};
+
+struct Registry {
+    std::mutex lock;
+    std::vector<std::shared_ptr<Ring>> rings;
+};
+
+Registry &registry() {
+    static Registry r;
+    return r;
+}
+
+Ring &local() {
+    thread_local std::shared_ptr<Ring> mine = [] {
+        auto ring = std::make_shared<Ring>();
+        Registry &r = registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        ring->tid = static_cast<uint32_t>(r.rings.size() + 1);
+        r.rings.push_back(ring);
+        return ring;
+    }();
+    return *mine;
+}
+
+struct Event {
+    const char *name;
+    uint64_t begin;
+    uint64_t end;
+    uint32_t tid;
+};
+
+/**
+ * @brief Copies out the events kept in every ring.
+ */
+std::vector<Event> collect() {
+    std::vector<Event> out;
+    Registry &r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    for (const auto &ring : r.rings) {
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        for (uint64_t i = ring->first(head); i < head; ++i) {
+            const Slot &s = ring->slots[i % Tracer::RING_EVENTS];
+            const char *name = s.name.load(std::memory_order_relaxed);
+            if (name)
+                out.push_back({name, s.begin.load(std::memory_order_relaxed), s.end.load(std::memory_order_relaxed),
+                               ring->tid});
+        }
+    }
+    return out;
+}
+
+void write_escaped(std::ostream &out, const char *text) {
+    for (; *text; ++text) {
+        if (*text == '"' || *text == '\\')
+            out << '\\';
+        out << *text;
+    }
+}
+
+} // namespace
+
+double Tracer::ticks_per_us() {
+    static const double rate = [] {
+#if defined(__x86_64__) || defined(__i386__)
+        const auto wall_start = std::chrono::steady_clock::now();
+        const uint64_t tsc_start = now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const uint64_t ticks = now() - tsc_start;
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - wall_start).count();
+        return us > 0 ? ticks / us : 1.0;
+#else
+        return 1000.0; // now() counts nanoseconds
+#endif
+    }();
+    return rate;
+}
+
+void Tracer::record(const char *name, uint64_t begin, uint64_t end) {
+    Ring &ring = local();
+    const uint64_t head = ring.head.load(std::memory_order_relaxed);
+    Slot &s = ring.slots[head % RING_EVENTS];
+    s.name.store(name, std::memory_order_relaxed);
+    s.begin.store(begin, std::memory_order_relaxed);
+    s.end.store(end, std::memory_order_relaxed);
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+size_t Tracer::events() {
+    size_t n = 0;
+    Registry &r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    for (const auto &ring : r.rings) {
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        n += static_cast<size_t>(head - ring->first(head));
+    }
+    return n;
+}
+
+void Tracer::clear() {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    // Only the owning thread writes head, so clearing moves the start of the kept events up to it
+    for (const auto &ring : r.rings)
+        ring->start.store(ring->head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+void Tracer::write_chrome_json(std::ostream &out) {
+    std::vector<Event> events = collect();
+    uint64_t base = UINT64_MAX;
+    for (const Event &e : events)
+        base = std::min(base, e.begin);
+    const double rate = ticks_per_us();
+
+    const std::ios_base::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision(3);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    out << std::fixed;
+    for (size_t i = 0; i < events.size(); ++i) {
+        const Event &e = events[i];
+        out << (i ? ",\n" : "\n") << "{\"name\":\"";
+        write_escaped(out, e.name);
+        out << "\",\"cat\":\"coup\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.tid << ",\"ts\":" << (e.begin - base) / rate
+            << ",\"dur\":" << (e.end >= e.begin ? e.end - e.begin : 0) / rate << '}';
+    }
+    out << "\n]}\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+bool Tracer::dump(const std::string &path) {
+    std::ofstream out(path);
+    if (!out)
+        return false;
+    write_chrome_json(out);
+    return static_cast<bool>(out);
+}
+
+} // namespace coup
@@ -0,0 +1,412 @@
+// TurnDriver.cpp - Resumable game tasks fed by bots, humans, or replays
+// Anksilae@gmail.com
+
+#include "TurnDriver.hpp"
+#include "Baron.hpp"
+#include "Exceptions.hpp"
+#include "Game.hpp"
+#include <algorithm>
+#include <sstream>
+
+namespace coup {
+
+namespace {
+
+struct KindName {
+    TurnAction::Kind kind;
+    const char *name;
+};
+
+constexpr KindName KIND_NAMES[] = {
+    {TurnAction::Kind::Gather, "gather"},     {TurnAction::Kind::Tax, "tax"},
+    {TurnAction::Kind::Bribe, "bribe"},       {TurnAction::Kind::Invest, "invest"},
+    {TurnAction::Kind::Arrest, "arrest"},     {TurnAction::Kind::Sanction, "sanction"},
+    {TurnAction::Kind::Coup, "coup"},         {TurnAction::Kind::Skip, "skip"},
+};
+
+Player &target_of(Game &game, const TurnAction &action) {
+    Player *target = game.get_player_by_name(action.target);
+    if (!target)
+        throw PlayerNotFoundException(action.target);
+    return *target;
+}
+
+} // namespace
+
+// ======================
+// TurnAction
+// ======================
+
+std::string TurnAction::describe() const {
+    for (const auto &k : KIND_NAMES)
+        if (k.kind == kind)
+            return needs_target() ? std::string(k.name) + " " + target : std::string(k.name);
+    return "unknown";
+}
+
+TurnAction TurnAction::parse(const std::string &text) {
+    std::istringstream in(text);
+    std::string word, target, extra;
+    in >> word >> target >> extra;
+    for (const auto &k : KIND_NAMES) {
+        if (word != k.name)
+            continue;
+        TurnAction action{k.kind, target};
+        if (action.needs_target() ? target.empty() || !extra.empty() : !target.empty())
+            break;
+        return action;
+    }
+    throw InvalidActionException("Cannot parse action \"" + text + "\".");
+}
+
+TurnAction TurnAction::from(const BotMove &move) {
+    switch (move.type) {
+        case BotMove::Type::Gather: return {Kind::Gather, ""};
+        case BotMove::Type::Tax: return {Kind::Tax, ""};
+        case BotMove::Type::Invest: return {Kind::Invest, ""};
+        case BotMove::Type::Arrest: return {Kind::Arrest, move.target};
+        case BotMove::Type::Sanction: return {Kind::Sanction, move.target};
+        case BotMove::Type::Coup: return {Kind::Coup, move.target};
+        case BotMove::Type::Skip: break;
+    }
+    return {Kind::Skip, ""};
+}
+
+void apply_action(Game &game, Player &actor, const TurnAction &action) {
+    switch (action.kind) {
+        case TurnAction::Kind::Gather: actor.gather(); break;
+        case TurnAction::Kind::Tax: actor.tax(); break;
+        case TurnAction::Kind::Bribe: actor.bribe(); break;
+        case TurnAction::Kind::Invest: {
+            auto *baron = dynamic_cast<Baron *>(&actor);
+            if (!baron)
+                throw InvalidActionException("Only a Baron can use Invest.");
+            baron->invest();
+            break;
+        }
+        case TurnAction::Kind::Arrest: actor.arrest(target_of(game, action)); break;
+        case TurnAction::Kind::Sanction: actor.sanction(target_of(game, action)); break;
+        case TurnAction::Kind::Coup: actor.coup(target_of(game, action)); break;
+        case TurnAction::Kind::Skip: actor.skip_turn(); break;
+    }
+}
+
+// ======================
+// Futures
+// ======================
+
+ActionFuture ActionFuture::ready(TurnAction action) {
+    ActionPromise promise;
+    promise.set(std::move(action));
+    return promise.future();
+}
+
+bool ActionFuture::is_ready() const {
+    std::lock_guard<std::mutex> guard(state->lock);
+    return state->action.has_value();
+}
+
+TurnAction ActionFuture::get() const {
+    std::lock_guard<std::mutex> guard(state->lock);
+    if (!state->action)
+        throw InvalidActionException("Action is not chosen yet.");
+    return *state->action;
+}
+
+void ActionFuture::then(std::function<void()> wake) {
+    {
+        std::lock_guard<std::mutex> guard(state->lock);
+        if (!state->action) {
+            state->wake = std::move(wake);
+            return;
+        }
+    }
+    wake();
+}
+
+ActionPromise::ActionPromise() : state(std::make_shared<ActionFuture::State>()) {}
+
+ActionFuture ActionPromise::future() const {
+    ActionFuture f;
+    f.state = state;
+    return f;
+}
+
+void ActionPromise::set(TurnAction action) {
+    std::function<void()> wake;
+    {
+        std::lock_guard<std::mutex> guard(state->lock);
+        if (state->action)
+            throw InvalidActionException("Action was already chosen.");
+        state->action = std::move(action);
+        wake.swap(state->wake);
+    }
+    if (wake)
+        wake();
+}
+
+bool ActionPromise::fulfilled() const {
+    std::lock_guard<std::mutex> guard(state->lock);
+    return state->action.has_value();
+}
+
+// ======================
+// Action Sources
+// ======================
+
+void ActionSource::accepted(const Player &, const TurnAction &) {}
+
+bool ActionSource::rejected(const Player &, const TurnAction &, const std::string &) {
+    return true;
+}
+
+WorkerPool::WorkerPool(unsigned threads) {
+    for (unsigned t = 0; t < std::max(1u, threads); ++t) {
+        workers.emplace_back([this] {
+            for (;;) {
+                std::function<void()> job;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    wake.wait(guard, [this] { return stopping || !jobs.empty(); });
+                    if (jobs.empty())
+                        return;
+                    job = std::move(jobs.front());
+                    jobs.pop_front();
+                }
+                job();
+            }
+        });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &w : workers)
+        w.join();
+}
+
+void WorkerPool::post(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        jobs.push_back(std::move(job));
+    }
+    wake.notify_one();
+}
+
+BotSource::BotSource(Bot bot, WorkerPool *pool) : bot(std::move(bot)), pool(pool) {}
+
+/**
+ * @brief The bot's choice, or its first candidate not refused this turn (skip if none is left).
+ */
+TurnAction BotSource::decide(const Game &game, const Player &self) {
+    auto is_refused = [this](const TurnAction &a) {
+        return std::find(refused.begin(), refused.end(), a) != refused.end();
+    };
+    TurnAction choice = TurnAction::from(bot.choose(game, self));
+    if (!is_refused(choice))
+        return choice;
+    for (const BotMove &m : Bot::candidates(game, self)) {
+        TurnAction a = TurnAction::from(m);
+        if (!is_refused(a))
+            return a;
+    }
+    return {TurnAction::Kind::Skip, ""};
+}
+
+ActionFuture BotSource::choose_action(const Game &game, const Player &self) {
+    if (!pool)
+        return ActionFuture::ready(decide(game, self));
+
+    ActionPromise promise;
+    pool->post([this, &game, &self, promise]() mutable { promise.set(decide(game, self)); });
+    return promise.future();
+}
+
+void BotSource::accepted(const Player &, const TurnAction &) {
+    refused.clear();
+}
+
+bool BotSource::rejected(const Player &, const TurnAction &action, const std::string &) {
+    refused.push_back(action);
+    return action.kind != TurnAction::Kind::Skip; // nothing is left once even skipping fails
+}
+
+ActionFuture ManualSource::choose_action(const Game &, const Player &) {
+    std::lock_guard<std::mutex> guard(lock);
+    pending.emplace();
+    return pending->future();
+}
+
+bool ManualSource::rejected(const Player &, const TurnAction &, const std::string &why) {
+    std::lock_guard<std::mutex> guard(lock);
+    error = why;
+    return true;
+}
+
+bool ManualSource::waiting() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return pending.has_value();
+}
+
+void ManualSource::submit(TurnAction action) {
+    ActionPromise promise;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!pending)
+            throw InvalidActionException("No action is awaited.");
+        promise = std::move(*pending);
+        pending.reset();
+        error.clear();
+    }
+    promise.set(std::move(action));
+}
+
+std::string ManualSource::last_error() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return error;
+}
+
+ReplaySource::ReplaySource(std::vector<std::string> lines) : lines(std::move(lines)) {}
+
+ReplaySource ReplaySource::from_stream(std::istream &in) {
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);)
+        lines.push_back(line);
+    return ReplaySource(std::move(lines));
+}
+
+ActionFuture ReplaySource::choose_action(const Game &, const Player &) {
+    while (next < lines.size()) {
+        const std::string &line = lines[next++];
+        const size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#')
+            continue;
+        return ActionFuture::ready(TurnAction::parse(line));
+    }
+    throw InvalidActionException("Replay has no more actions.");
+}
+
+bool ReplaySource::rejected(const Player &, const TurnAction &, const std::string &) {
+    return false;
+}
+
+// ======================
+// GameTask
+// ======================
+
+GameTask::GameTask(Game &game, std::vector<ActionSource *> sources, int max_actions)
+    : table(game), seats(std::move(sources)), max_actions(max_actions) {}
+
+/**
+ * @brief Plays actions until one is not ready yet; the turn loop of one game.
+ */
+GameTask::Status GameTask::resume() {
+    while (!done()) {
+        if (table.is_game_over() || played >= max_actions) {
+            current = Status::Finished;
+            break;
+        }
+
+        Player *self = nullptr;
+        try {
+            if (!awaited.valid()) {
+                awaited_seat = static_cast<size_t>(table.get_current_turn_index());
+                if (awaited_seat >= seats.size() || !seats[awaited_seat])
+                    throw InvalidActionException("No action source for seat " + std::to_string(awaited_seat) + ".");
+                self = table.get_all_players_raw()[awaited_seat];
+                awaited = seats[awaited_seat]->choose_action(table, *self);
+            }
+            if (!awaited.is_ready()) {
+                current = Status::Waiting;
+                if (executor)
+                    awaited.then([this] { executor->wake(*this); });
+                break;
+            }
+        } catch (const CoupException &e) {
+            failure = e.what();
+            current = Status::Failed;
+            break;
+        }
+
+        self = table.get_all_players_raw()[awaited_seat];
+        ActionSource &source = *seats[awaited_seat];
+        const TurnAction action = awaited.get();
+        awaited = ActionFuture{};
+        current = Status::Ready;
+        try {
+            apply_action(table, *self, action);
+        } catch (const CoupException &e) {
+            if (!source.rejected(*self, action, e.what())) {
+                failure = self->get_name() + ": " + action.describe() + ": " + e.what();
+                current = Status::Failed;
+            }
+            continue;
+        }
+        ++played;
+        source.accepted(*self, action);
+    }
+    return current;
+}
+
+// ======================
+// TurnExecutor
+// ======================
+
+void TurnExecutor::spawn(GameTask &task) {
+    task.executor = this;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        ++live;
+        ready.push_back(&task);
+    }
+    woken.notify_one();
+}
+
+void TurnExecutor::wake(GameTask &task) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        ready.push_back(&task);
+    }
+    woken.notify_one();
+}
+
+size_t TurnExecutor::run_ready() {
+    std::deque<GameTask *> batch;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        batch.swap(ready);
+    }
+    size_t finished = 0;
+    for (GameTask *task : batch) {
+        const bool was_done = task->done();
+        task->resume();
+        if (!was_done && task->done())
+            ++finished;
+    }
+    if (finished) {
+        std::lock_guard<std::mutex> guard(lock);
+        live -= finished;
+    }
+    return batch.size();
+}
+
+void TurnExecutor::run() {
+    for (;;) {
+        run_ready();
+        std::unique_lock<std::mutex> guard(lock);
+        if (live == 0)
+            return;
+        woken.wait(guard, [this] { return !ready.empty(); });
+    }
+}
+
+size_t TurnExecutor::active() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return live;
+}
+
+} // namespace coup
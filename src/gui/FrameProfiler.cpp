@@ -0,0 +1,108 @@
+// Anksilae@gmail.com
+// FrameProfiler.cpp
+
+#include "FrameProfiler.hpp"
+#include <fstream>
+
+namespace coup {
+
+namespace {
+
+double elapsed_ms(std::chrono::steady_clock::time_point from)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - from).count();
+}
+
+} // namespace
+
+/**
+ * @brief Starts timing a section.
+ */
+FrameProfiler::Scope::Scope(FrameProfiler &profiler, ProfileSection section)
+    : profiler(profiler), section(section), start(std::chrono::steady_clock::now())
+{
+}
+
+/**
+ * @brief Adds the elapsed time to the section of the frame being recorded.
+ */
+FrameProfiler::Scope::~Scope()
+{
+    profiler.current.section_ms[static_cast<size_t>(section)] += elapsed_ms(start);
+}
+
+/**
+ * @brief Allocates the ring buffer once; recording frames never allocates.
+ */
+FrameProfiler::FrameProfiler(size_t capacity)
+    : history(capacity > 0 ? capacity : 1), frame_start(std::chrono::steady_clock::now())
+{
+}
+
+/**
+ * @brief Starts a new frame.
+ */
+void FrameProfiler::begin_frame()
+{
+    current = Sample{};
+    frame_start = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Finishes the current frame and pushes it into the history.
+ */
+void FrameProfiler::end_frame()
+{
+    current.frame_ms = elapsed_ms(frame_start);
+    history[head] = current;
+    head = (head + 1) % history.size();
+    if (count < history.size())
+        ++count;
+}
+
+/**
+ * @brief Returns a stored frame by age. Callers must check size() first.
+ */
+const FrameProfiler::Sample &FrameProfiler::recent(size_t age) const
+{
+    return history[(head + history.size() - 1 - age) % history.size()];
+}
+
+/**
+ * @brief Average FPS computed from the mean frame time of the last frames.
+ */
+double FrameProfiler::average_fps(size_t frames) const
+{
+    size_t n = frames < count ? frames : count;
+    if (n == 0)
+        return 0.0;
+
+    double total_ms = 0;
+    for (size_t i = 0; i < n; ++i)
+        total_ms += recent(i).frame_ms;
+    return total_ms > 0 ? 1000.0 * static_cast<double>(n) / total_ms : 0.0;
+}
+
+/**
+ * @brief Writes one CSV row per stored frame, oldest first.
+ */
+bool FrameProfiler::export_csv(const std::string &path) const
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+
+    out << "frame,frame_ms,handle_events_ms,render_ms,special_panel_ms,target_buttons_ms,"
+           "draw_calls,texts_created,game_queries\n";
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Sample &s = recent(count - 1 - i);
+        out << i << ',' << s.frame_ms;
+        for (double ms : s.section_ms)
+            out << ',' << ms;
+        out << ',' << s.draw_calls << ',' << s.texts_created << ',' << s.game_queries << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+} // namespace coup
@@ -1,12 +1,6 @@
 // Anksilae@gmail.com
 
 #include "GUI.hpp"
-#include "Governor.hpp"
-#include "Spy.hpp"
-#include "Judge.hpp"
-#include "Baron.hpp"
-#include "General.hpp"
-#include "Merchant.hpp"
 #include "Exceptions.hpp"
 #include <iostream>
 #include <SFML/Graphics.hpp>
@@ -17,12 +11,18 @@ namespace coup
 
     /**
      * @brief Constructs the GUI object, initializes the game window, font, and input box.
+     *
+     * The game is handed to a GameEngine running on its own thread; from here on the GUI
+     * only submits commands and reads published snapshots.
      * 
      * @param game Reference to the game object managed by this GUI.
      */
-    GUI::GUI(Game &game) : game(game), window(sf::VideoMode(1024, 720), "Coup Game")
+    GUI::GUI(Game &game)
+        : engine(game), window(sf::VideoMode(1024, 720), "Coup Game"), hits(WINDOW_WIDTH, WINDOW_HEIGHT)
     {
         state = GUIState::Setup;
+        snapshot = &engine.snapshot();
+        window.setFramerateLimit(60);
 
         if (!font.loadFromFile("assets/OpenSans.ttf"))
         {
@@ -39,14 +39,25 @@ namespace coup
 
     /**
      * @brief Runs the main GUI loop, handling events and rendering the screen repeatedly while the window is open.
+     *
+     * Each frame first picks up finished command results, then the newest engine snapshot
+     * (published before those results), so events, bots and drawing in that frame see one
+     * consistent game state that already includes every reported command.
      */
     void GUI::run()
     {
         while (window.isOpen())
         {
+            profiler.begin_frame();
+            applyCommandResults();
+            snapshot = &engine.snapshot();
+            recordTimeline();
+            updateBots();
             handleEvents();
             render();
+            profiler.end_frame();
         }
+        engine.stop();
     }
 
     /**
@@ -54,6 +65,7 @@ namespace coup
      */
     void GUI::handleEvents()
     {
+        FrameProfiler::Scope scope(profiler, ProfileSection::HandleEvents);
         sf::Event event;
 
         while (window.pollEvent(event))
@@ -66,6 +78,33 @@ namespace coup
                     return;
                 }
 
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3)
+                {
+                    profiler.toggle_overlay();
+                    continue;
+                }
+
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F12)
+                {
+                    if (profiler.export_csv("frame_profile.csv"))
+                        info_message = "Frame profile saved to frame_profile.csv";
+                    else
+                        error_message = "Could not write frame_profile.csv";
+                    continue;
+                }
+
+                if (state == GUIState::Playing && event.type == sf::Event::KeyPressed)
+                {
+                    const int from = scrub_turn.value_or(timeline.last_turn());
+                    if (event.key.code == sf::Keyboard::Left)
+                        scrubTo(std::max(from - 1, timeline.first_turn()));
+                    else if (event.key.code == sf::Keyboard::Right && scrub_turn)
+                        scrubTo(*scrub_turn + 1);
+                    else if (event.key.code == sf::Keyboard::End)
+                        scrubTo(std::nullopt);
+                    continue;
+                }
+
                 if (event.type == sf::Event::MouseButtonPressed)
                 {
                     error_message.clear(); // מנקה שגיאות קודמות בלחיצה
@@ -77,30 +116,40 @@ namespace coup
                 }
                 else if (state == GUIState::Playing && event.type == sf::Event::MouseButtonPressed)
                 {
-                    sf::Vector2i mouse = sf::Mouse::getPosition(window);
+                    // Resolve the click once against the widgets drawn in the last frame
+                    HitRegistry::Hit hit = hits.hit(sf::Mouse::getPosition(window));
+
+                    if (handleTimelineButtons(hit))
+                        continue;
 
                     // 🟢 לחצן "New Game" או סיום משחק
-                    if (handleGlobalButtons(mouse))
+                    if (handleGlobalButtons(hit))
                         return;
 
-                    auto current = game.get_player_by_name(game.turn());
+                    // Looking back at an earlier turn: the game itself does not react
+                    if (scrub_turn)
+                        continue;
+
+                    const PlayerView *current = view().current_player();
+                    if (!current)
+                        throw InvalidActionException("No players in game.");
 
                     // 🟢 כפתורים מיוחדים (Spy, Judge וכו’)
-                    if (handleSpecialButtonClick(mouse, current))
+                    if (handleSpecialButtonClick(hit, *current))
                         return;
 
                     // 🟢 שלב ראשון – לחיצה על יעד
-                    bool clicked_target = handleTargetActionClick(mouse, current);
+                    bool clicked_target = handleTargetActionClick(hit, *current);
 
                     // 🟢 שלב שני – לחיצה על פעולה רגילה
-                    bool clicked_basic = handleBasicActionClick(mouse, current);
+                    bool clicked_basic = handleBasicActionClick(hit, *current);
 
                     // 🟡 שלב שלישי – אם לא נלחץ יעד ולא פעולה, נניח שהוא לחץ על מקום ריק
-                    if (pending_target_action != PendingTargetAction::None &&
+                    if (pending_target &&
                         !clicked_target && !clicked_basic)
                     {
                         std::cerr << "[INFO] Target action canceled due to click outside buttons.\n";
-                        pending_target_action = PendingTargetAction::None;
+                        pending_target.reset();
                         info_message.clear();
                     }
                 }
@@ -108,7 +157,7 @@ namespace coup
             catch (const std::exception &e)
             {
                 handle_gui_exception(e);
-                pending_target_action = PendingTargetAction::None;
+                pending_target.reset();
             }
         }
     }
@@ -119,7 +168,9 @@ namespace coup
      */
     void GUI::render()
     {
+        FrameProfiler::Scope scope(profiler, ProfileSection::Render);
         window.clear(sf::Color(30, 30, 30));
+        hits.clear();
 
         try
         {
@@ -129,7 +180,7 @@ namespace coup
             }
             else if (state == GUIState::Playing)
             {
-                if (game.is_game_over() && pending_target_action == PendingTargetAction::None)
+                if (view().game_over && !pending_target)
                 {
                     int window_width = window.getSize().x;
                     int window_height = window.getSize().y;
@@ -141,27 +192,30 @@ namespace coup
                     int button_y = (window_height - button_height) / 2;
 
                     auto newGameBtn = createButton(button_x, button_y, button_width, button_height, sf::Color(100, 200, 100));
-                    window.draw(newGameBtn);
-                    window.draw(newGameBtn);
+                    drawItem(newGameBtn);
+                    drawItem(newGameBtn);
                     sf::FloatRect button_bounds = newGameBtn.getGlobalBounds();
                     float text_x = button_bounds.left + (button_bounds.width - 80) / 2;
                     float text_y = button_bounds.top + (button_bounds.height - 20) / 2;
 
                     drawText("Start New Game", text_x-35, text_y, 20);
-                    persistent_new_game_button = newGameBtn.getGlobalBounds();
+                    hits.add(WidgetKind::NewGame, 0, button_bounds);
 
-                    try
+                    const std::string &winner = view().winner;
+                    if (!winner.empty())
                     {
-                        sf::Text winner_text("WINNER IS : " + game.winner() + " GAME OVER !", font, 22);
+                        sf::Text winner_text("WINNER IS : " + winner + " GAME OVER !", font, 22);
+                        profiler.count_text();
                         sf::FloatRect winner_text_rect = winner_text.getLocalBounds();
                         float winner_text_x = (window_width - winner_text_rect.width) / 2;
                         float winner_text_y = button_y - 60;
 
-                        drawText("WINNER IS : " + game.winner() + " GAME OVER !", winner_text_x, winner_text_y, 22, sf::Color::Yellow);
+                        drawText("WINNER IS : " + winner + " GAME OVER !", winner_text_x, winner_text_y, 22, sf::Color::Yellow);
                     }
-                    catch (const std::exception &e)
+                    else
                     {
                         sf::Text winner_text("GAME OVER - Error getting winner", font, 22);
+                        profiler.count_text();
                         sf::FloatRect winner_text_rect = winner_text.getLocalBounds();
                         float winner_text_x = (window_width - winner_text_rect.width) / 2;
                         float winner_text_y = button_y - 60;
@@ -175,20 +229,27 @@ namespace coup
                         box.setOutlineColor(sf::Color::Red);
                         box.setOutlineThickness(2);
                         box.setPosition(30, 450);
-                        window.draw(box);
+                        drawItem(box);
                         drawText("Error:", 40, 460, 20, sf::Color::White);
                         drawText(error_message, 40, 490, 18, sf::Color(255, 180, 180));
                     }
 
+                    drawTimelineBar();
+                    if (profiler.overlay_visible())
+                        drawProfilerOverlay();
                     window.display();
                     return;
                 }
 
-                std::string current_turn = game.turn();
-                std::shared_ptr<Player> player = game.get_player_by_name(current_turn);
+                const PlayerView *player = view().current_player();
+                if (!player)
+                    throw InvalidActionException("No players in game.");
 
-                drawPlayerPanel(player);
-                drawActionButtons(player);
+                drawPlayerPanel(*player);
+                if (isBot(player->name))
+                    drawBotStatus(*player);
+                else
+                    drawActionButtons(*player);
                 drawSpecialButtonsPanel();
                 drawTurnInfo();
 
@@ -199,7 +260,10 @@ namespace coup
                 int btn_x = window.getSize().x - button_width - margin;
                 int btn_y = window.getSize().y - button_height - margin;
 
-                auto alive_players = game.players();
+                std::vector<const PlayerView *> alive_players;
+                for (const auto &p : view().players)
+                    if (p.active)
+                        alive_players.push_back(&p);
                 int row_height = 26;
                 int box_width = 260;
                 int padding = 10;
@@ -217,19 +281,19 @@ namespace coup
                 sf::RectangleShape redBox(sf::Vector2f(rect_size, rect_size));
                 redBox.setPosition(legend_x + spacing - 15, legend_y -7);
                 redBox.setFillColor(sf::Color::Red);
-                window.draw(redBox);
+                drawItem(redBox);
                 drawText("= Disabled Arrest", legend_x + spacing, legend_y - 10, 14, sf::Color::White);
 
                 sf::RectangleShape blueBox(sf::Vector2f(rect_size, rect_size));
                 blueBox.setPosition(legend_x + spacing - 15, legend_y + 8);
                 blueBox.setFillColor(sf::Color::Blue);
-                window.draw(blueBox);
+                drawItem(blueBox);
                 drawText("= Sanctioned", legend_x + spacing, legend_y + 5, 14, sf::Color::White);
 
                 sf::RectangleShape yellowBox(sf::Vector2f(rect_size, rect_size));
                 yellowBox.setPosition(legend_x + spacing - 15, legend_y +23);
                 yellowBox.setFillColor(sf::Color::Yellow);
-                window.draw(yellowBox);
+                drawItem(yellowBox);
                 drawText("= Both", legend_x + spacing, legend_y + 20, 14, sf::Color::White);
 
                 sf::RectangleShape bg(sf::Vector2f(box_width, list_height));
@@ -237,20 +301,19 @@ namespace coup
                 bg.setFillColor(sf::Color(40, 40, 80, 220));
                 bg.setOutlineColor(sf::Color::White);
                 bg.setOutlineThickness(2);
-                window.draw(bg);
+                drawItem(bg);
 
                 int text_x = box_x + 10;
                 int text_y = box_y + padding;
-                for (const std::string &name : alive_players)
+                for (const PlayerView *p : alive_players)
                 {
-                    auto p = game.get_player_by_name(name);
-                    std::string label = name + " (" + p->role() + ")";
+                    std::string label = p->name + " (" + p->role + ")";
                     sf::Color color = sf::Color::White;
-                    if (p->is_arrest_disabled() && p->is_sanctioned())
+                    if (p->arrest_disabled && p->sanctioned)
                         color = sf::Color::Yellow;
-                    else if (p->is_arrest_disabled())
+                    else if (p->arrest_disabled)
                         color = sf::Color::Red;
-                    else if (p->is_sanctioned())
+                    else if (p->sanctioned)
                         color = sf::Color::Blue;
 
                     drawText(label, text_x, text_y, 16, color);
@@ -263,17 +326,19 @@ namespace coup
                     button_width,
                     button_height,
                     sf::Color(100, 200, 100));
-                window.draw(newGameBtn);
+                drawItem(newGameBtn);
 
                 sf::FloatRect newGameBounds = newGameBtn.getGlobalBounds();
                 float center_x = newGameBounds.left + (newGameBounds.width - 80) / 2;
                 float center_y = newGameBounds.top + 10;
                 drawText("New Game", center_x, center_y, 16, sf::Color::Black);
 
-                persistent_new_game_button = newGameBtn.getGlobalBounds();
+                hits.add(WidgetKind::NewGame, 0, newGameBounds);
             }
 
             drawTurnInfo();
+            if (state == GUIState::Playing)
+                drawTimelineBar();
         }
         catch (const std::exception &e)
         {
@@ -283,11 +348,13 @@ namespace coup
             box.setOutlineColor(sf::Color::Red);
             box.setOutlineThickness(2);
             box.setPosition(30, 450);
-            window.draw(box);
+            drawItem(box);
             drawText("Error:", 40, 460, 20, sf::Color::White);
             drawText(error_message, 40, 490, 18, sf::Color(255, 180, 180));
         }
 
+        if (profiler.overlay_visible())
+            drawProfilerOverlay();
         window.display();
     }
 
@@ -4,6 +4,7 @@
 #include "GUI.hpp"
 #include <SFML/Graphics.hpp>
 #include <algorithm>
+#include <cstdio>
 
 namespace coup {
 
@@ -14,7 +15,7 @@ namespace coup {
 void GUI::drawSetupScreen()
 {
     drawText("Enter Name:", 30, 30);
-    window.draw(input_box);
+    drawItem(input_box);
     drawText(name_input, input_box.getPosition().x + 5, input_box.getPosition().y + 5);
     drawText("Select Role:", 30, 80);
 
@@ -23,25 +24,51 @@ void GUI::drawSetupScreen()
     {
         sf::Color color = (selected_role == roles[i]) ? sf::Color(72, 118, 255) : sf::Color(100, 149, 237);
         sf::RectangleShape btn = createButton(30 + i * 120, 120, 100, 40, color);
-        window.draw(btn);
+        drawItem(btn);
         drawText(roles[i], 35 + i * 120, 125, 16);
+        hits.add(WidgetKind::RoleButton, static_cast<int>(i), btn.getGlobalBounds());
     }
 
-    window.draw(createButton(30, 180, 200, 40, sf::Color(0, 200, 100)));
+    sf::RectangleShape addBtn = createButton(30, 180, 200, 40, sf::Color(0, 200, 100));
+    drawItem(addBtn);
     drawText("Add Player", 50, 185);
+    hits.add(WidgetKind::AddPlayer, 0, addBtn.getGlobalBounds());
 
-    if (game.players().size() >= 2)
+    sf::RectangleShape botBtn = createButton(250, 180, 200, 40, sf::Color(0, 160, 160));
+    drawItem(botBtn);
+    drawText("Add Bot", 270, 185);
+    hits.add(WidgetKind::AddBot, 0, botBtn.getGlobalBounds());
+
+    sf::RectangleShape levelBtn = createButton(470, 180, 170, 40, sf::Color(70, 70, 120));
+    drawItem(levelBtn);
+    drawText("Bot: " + to_string(bot_strength), 480, 188, 18);
+    hits.add(WidgetKind::BotLevel, 0, levelBtn.getGlobalBounds());
+
+    sf::RectangleShape delayBtn = createButton(660, 180, 170, 40, sf::Color(70, 70, 120));
+    drawItem(delayBtn);
+    drawText("Delay: " + std::to_string(bot_delay_ms) + " ms", 670, 188, 18);
+    hits.add(WidgetKind::BotDelay, 0, delayBtn.getGlobalBounds());
+
+    if (view().alive_count() >= 2)
     {
-        window.draw(createButton(30, 240, 200, 40, sf::Color(255, 215, 0)));
+        sf::RectangleShape startBtn = createButton(30, 240, 200, 40, sf::Color(255, 215, 0));
+        drawItem(startBtn);
         drawText("Start Game", 50, 245);
+        hits.add(WidgetKind::StartGame, 0, startBtn.getGlobalBounds());
     }
 
     drawText("Players:", 30, 300);
-    auto names = game.players();
-    for (size_t i = 0; i < names.size(); ++i)
+    size_t row = 0;
+    for (const auto &p : view().players)
     {
-        auto p = game.get_player_by_name(names[i]);
-        drawText("- " + p->get_name() + " (" + p->role() + ")", 50, 330 + i * 25);
+        if (!p.active)
+            continue;
+        std::string line = "- " + p.name + " (" + p.role + ")";
+        auto bot = bots.find(p.name);
+        if (bot != bots.end())
+            line += " [Bot: " + to_string(bot->second->strength()) + "]";
+        drawText(line, 50, 330 + row * 25);
+        ++row;
     }
 
     if (!error_message.empty())
@@ -51,7 +78,7 @@ void GUI::drawSetupScreen()
         box.setOutlineColor(sf::Color::Red);
         box.setOutlineThickness(2);
         box.setPosition(30, 500);
-        window.draw(box);
+        drawItem(box);
         drawText("Error:", 40, 510, 20, sf::Color::White);
         drawText(error_message, 40, 540, 18, sf::Color(255, 180, 180));
     }
@@ -62,14 +89,14 @@ void GUI::drawSetupScreen()
  * 
  * @param player The current player whose details are displayed.
  */
-void GUI::drawPlayerPanel(const std::shared_ptr<Player> player)
+void GUI::drawPlayerPanel(const PlayerView &player)
 {
     sf::RectangleShape bg(sf::Vector2f(600, 40));
     bg.setPosition(WINDOW_WIDTH - 600 - 30, 30);
     bg.setFillColor(sf::Color(30, 30, 30));
-    window.draw(bg);
+    drawItem(bg);
 
-    drawText("Player: " + player->get_name() + " (" + player->role() + ") - Coins: " + std::to_string(player->coins()), 30, 30);
+    drawText("Player: " + player.name + " (" + player.role + ") - Coins: " + std::to_string(player.coins), 30, 30);
 }
 
 /**
@@ -78,9 +105,9 @@ void GUI::drawPlayerPanel(const std::shared_ptr<Player> player)
  * 
  * @param player The current player whose available actions are rendered.
  */
-void GUI::drawActionButtons(const std::shared_ptr<Player> player)
+void GUI::drawActionButtons(const PlayerView &player)
 {
-    action_buttons_bounds.clear();
+    action_labels.clear();
 
     std::vector<std::string> basic = {"Gather", "Tax", "Bribe", "Skip Turn"};
     int btn_width = 100;
@@ -96,20 +123,22 @@ void GUI::drawActionButtons(const std::shared_ptr<Player> player)
         sf::RectangleShape btn = createButton(x, start_y, btn_width, btn_height,
                                               basic[i] == "Skip Turn" ? sf::Color(100, 100, 255) : sf::Color(70, 130, 180));
         btn.setPosition(x, start_y);
-        window.draw(btn);
+        drawItem(btn);
         drawText(basic[i], x + 10, start_y + 8, 16);
-        action_buttons_bounds.push_back({btn.getGlobalBounds(), basic[i]});
+        hits.add(WidgetKind::ActionButton, static_cast<int>(action_labels.size()), btn.getGlobalBounds());
+        action_labels.push_back(basic[i]);
     }
 
-    if (player->role() == "Baron")
+    if (player.role == "Baron")
     {
         int i = static_cast<int>(basic.size());
         int x = start_x + i * spacing;
         sf::RectangleShape btn = createButton(x, start_y, btn_width, btn_height, sf::Color(255, 180, 90));
         btn.setPosition(x, start_y);
-        window.draw(btn);
+        drawItem(btn);
         drawText("Invest", x + 10, start_y + 8, 16);
-        action_buttons_bounds.push_back({btn.getGlobalBounds(), "Invest"});
+        hits.add(WidgetKind::ActionButton, static_cast<int>(action_labels.size()), btn.getGlobalBounds());
+        action_labels.push_back("Invest");
     }
 
     std::vector<std::string> target = {"Arrest", "Sanction", "Coup"};
@@ -120,19 +149,39 @@ void GUI::drawActionButtons(const std::shared_ptr<Player> player)
 
         sf::RectangleShape btn = createButton(x, y, btn_width, btn_height, sf::Color(200, 120, 80));
         btn.setPosition(x, y);
-        window.draw(btn);
+        drawItem(btn);
         drawText(target[i], x + 10, y + 8, 16);
-        action_buttons_bounds.push_back({btn.getGlobalBounds(), target[i]});
+        hits.add(WidgetKind::ActionButton, static_cast<int>(action_labels.size()), btn.getGlobalBounds());
+        action_labels.push_back(target[i]);
     }
 
     drawTargetSelectionButtons();
 }
 
+/**
+ * @brief Draws the status of a bot whose turn it is, in place of the action buttons.
+ * 
+ * @param player The bot-controlled player in turn.
+ */
+void GUI::drawBotStatus(const PlayerView &player)
+{
+    std::string strength = to_string(bots[player.name]->strength());
+    drawText(player.name + " (" + strength + " bot) is thinking...", 30, 200, 22, sf::Color(0, 200, 200));
+
+    if (last_bot_latency_ms >= 0)
+    {
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "Last bot move: %.1f ms", last_bot_latency_ms);
+        drawText(buf, 30, 235, 16, sf::Color(180, 180, 180));
+    }
+}
+
 /**
  * @brief Draws the panel of special action buttons for out-of-turn interactions based on role abilities.
  */
 void GUI::drawSpecialButtonsPanel()
 {
+    FrameProfiler::Scope scope(profiler, ProfileSection::SpecialButtonsPanel);
     special_buttons_positions.clear();
     size_t y = 20;
     int padding_x = 8;
@@ -143,10 +192,11 @@ void GUI::drawSpecialButtonsPanel()
     int button_height = 28;
 
     int max_label_width = 0;
-    for (const auto &p : game.get_all_players_raw())
+    const GameSnapshot &snap = view();
+    for (const auto &p : snap.players)
     {
-        std::string label = p->get_name() + " (" + p->role() + ")";
-        if ((p->is_active() || p->role() == "General"))
+        std::string label = p.name + " (" + p.role + ")";
+        if ((p.active || p.role == "General"))
         {
             int label_px = label.size() * 8;
             max_label_width = std::max(max_label_width, label_px);
@@ -159,18 +209,19 @@ void GUI::drawSpecialButtonsPanel()
     drawText("Out Of Turn Actions", box_x, y, 18, sf::Color(180, 180, 255));
     y += 30;
 
-    for (const auto &p : game.get_all_players_raw())
+    for (const auto &p : snap.players)
     {
-        std::string name = p->get_name();
-        std::string role = p->role();
+        const std::string &name = p.name;
+        const std::string &role = p.role;
         std::string label = name + " (" + role + ")";
-        bool include = p->is_active();
+        bool include = p.active;
 
         if (!include && role == "General")
         {
-            for (const auto &entry : game.get_coup_pending_list())
+            for (const auto &entry : snap.coup_pending_list)
             {
-                if (entry.second == name && game.can_still_undo(entry.first))
+                const PlayerView *attacker = snap.find(entry.first);
+                if (entry.second == name && attacker && attacker->can_still_undo)
                 {
                     include = true;
                     break;
@@ -178,7 +229,7 @@ void GUI::drawSpecialButtonsPanel()
             }
         }
 
-        if (!include)
+        if (!include || isBot(name))
             continue;
 
         std::string action_text;
@@ -194,16 +245,17 @@ void GUI::drawSpecialButtonsPanel()
             box.setFillColor(sf::Color(30, 30, 30));
             box.setOutlineColor(sf::Color::White);
             box.setOutlineThickness(1.0f);
-            window.draw(box);
+            drawItem(box);
 
             drawText(label, box_x + padding_x, y + padding_y, text_size);
 
             int btn_x = box_x + box_width - button_width - padding_x;
             sf::RectangleShape btn = createButton(btn_x, y + padding_y, button_width, button_height, sf::Color(120, 120, 255));
-            window.draw(btn);
+            drawItem(btn);
             drawText(action_text, btn_x + 5, y + padding_y + 6, 12);
 
-            special_buttons_positions.push_back({btn.getGlobalBounds(), name, role});
+            hits.add(WidgetKind::SpecialButton, static_cast<int>(special_buttons_positions.size()), btn.getGlobalBounds());
+            special_buttons_positions.push_back({name, role});
             y += button_height + padding_y + 10;
         }
     }
@@ -214,19 +266,19 @@ void GUI::drawSpecialButtonsPanel()
  */
 void GUI::drawTargetSelectionButtons()
 {
-    if (pending_target_action == PendingTargetAction::None)
+    if (!pending_target)
         return;
+    FrameProfiler::Scope scope(profiler, ProfileSection::TargetSelectionButtons);
 
-    std::string current_name = game.turn();
-    std::vector<std::string> all = game.players();
+    const GameSnapshot &snap = view();
+    const PlayerView *current = snap.current_player();
 
-    current_target_names.clear();
-    target_button_bounds.clear();
+    current_targets.clear();
 
-    for (const auto &name : all)
+    for (size_t seat = 0; seat < snap.players.size(); ++seat)
     {
-        if (name != current_name)
-            current_target_names.push_back(name);
+        if (snap.players[seat].active && &snap.players[seat] != current)
+            current_targets.push_back(seat);
     }
 
     int btn_width = 140;
@@ -236,19 +288,18 @@ void GUI::drawTargetSelectionButtons()
 
     drawText("Targets:", start_x, start_y - 25, 16, sf::Color(180, 180, 255));
 
-    for (size_t i = 0; i < current_target_names.size(); ++i)
+    for (size_t i = 0; i < current_targets.size(); ++i)
     {
-        const std::string &name = current_target_names[i];
+        const PlayerView &target = snap.players[current_targets[i]];
         int x = start_x + static_cast<int>(i) * (btn_width + 12);
 
         sf::RectangleShape btn = createButton(x, start_y, btn_width, btn_height, sf::Color(160, 80, 80));
-        window.draw(btn);
+        drawItem(btn);
 
-        auto player = game.get_player_by_name(name);
-        std::string label = name + " (" + player->role() + ")";
+        std::string label = target.name + " (" + target.role + ")";
         drawText(label, x + 10, start_y + 8, 14, sf::Color::White);
 
-        target_button_bounds.push_back(btn.getGlobalBounds());
+        hits.add(WidgetKind::TargetButton, static_cast<int>(i), btn.getGlobalBounds());
     }
 }
 
@@ -271,7 +322,7 @@ void GUI::drawTurnInfo()
         box.setOutlineColor(sf::Color::Red);
         box.setOutlineThickness(2);
         box.setPosition(box_x, box_y);
-        window.draw(box);
+        drawItem(box);
 
         drawText("Error:", box_x + padding_left, box_y + padding_top, 20, sf::Color::White);
         drawText(error_message, box_x + padding_left, box_y + padding_top + 30, 18, sf::Color(255, 180, 180));
@@ -283,13 +334,40 @@ void GUI::drawTurnInfo()
         box.setOutlineColor(sf::Color::Yellow);
         box.setOutlineThickness(2);
         box.setPosition(box_x, box_y);
-        window.draw(box);
+        drawItem(box);
 
         drawText("Action:", box_x + padding_left, box_y + padding_top, 20, sf::Color::White);
         drawText(info_message, box_x + padding_left, box_y + padding_top + 30, 18, sf::Color(255, 255, 180));
     }
 }
 
+/**
+ * @brief Draws the turn scrubber under the game: back, forward, and live buttons with the turn shown.
+ */
+void GUI::drawTimelineBar()
+{
+    if (timeline.empty())
+        return;
+
+    const char *labels[] = {"<", ">", "Live"};
+    const float widths[] = {36, 36, 60};
+    float x = 30;
+    float y = window.getSize().y - 45;
+    for (int i = 0; i < 3; ++i)
+    {
+        const bool enabled = i == 0 ? scrub_turn.value_or(timeline.last_turn()) > timeline.first_turn() : scrub_turn.has_value();
+        auto btn = createButton(x, y, widths[i], 28, enabled ? sf::Color(90, 90, 160) : sf::Color(60, 60, 60));
+        drawItem(btn);
+        drawText(labels[i], x + 10, y + 3, 16);
+        hits.add(WidgetKind::TimelineButton, i, btn.getGlobalBounds());
+        x += widths[i] + 8;
+    }
+
+    const int shown = scrub_turn.value_or(timeline.last_turn());
+    drawText("Turn " + std::to_string(shown) + " / " + std::to_string(timeline.last_turn()) + (scrub_turn ? "" : " (live)"),
+             x + 8, y + 4, 16, scrub_turn ? sf::Color(255, 200, 120) : sf::Color(180, 180, 180));
+}
+
 /**
  * @brief Utility function to draw text on the screen.
  * 
@@ -302,9 +380,100 @@ void GUI::drawTurnInfo()
 void GUI::drawText(const std::string &str, float x, float y, unsigned size, sf::Color color)
 {
     sf::Text text(str, font, size);
+    profiler.count_text();
     text.setPosition(x, y);
     text.setFillColor(color);
-    window.draw(text);
+    drawItem(text);
+}
+
+/**
+ * @brief Draws an item on the window and counts the draw call for the profiler.
+ *
+ * @param item The shape, text or vertex array to draw.
+ */
+void GUI::drawItem(const sf::Drawable &item)
+{
+    profiler.count_draw();
+    window.draw(item);
+}
+
+/**
+ * @brief Returns the game snapshot of the current frame, counting the read for the profiler.
+ */
+const GameSnapshot &GUI::view()
+{
+    profiler.count_query();
+    return *snapshot;
+}
+
+/**
+ * @brief Draws the profiler overlay: last frame statistics and a frame-time histogram.
+ *
+ * Uses window.draw directly so the overlay does not inflate the counters it displays.
+ * Each histogram bar is one frame (newest on the right); the line marks 16.7 ms (60 FPS).
+ */
+void GUI::drawProfilerOverlay()
+{
+    if (profiler.size() == 0)
+        return;
+
+    const int history = 120;
+    const float box_width = 280;
+    const float box_height = 170;
+    const float box_x = static_cast<float>(window.getSize().x) - box_width - 30;
+    const float box_y = 270;
+    const float graph_height = 50;
+    const float ms_per_px = 0.5f;
+
+    sf::RectangleShape bg(sf::Vector2f(box_width, box_height));
+    bg.setPosition(box_x, box_y);
+    bg.setFillColor(sf::Color(0, 0, 0, 200));
+    bg.setOutlineColor(sf::Color(120, 255, 120));
+    bg.setOutlineThickness(1.0f);
+    window.draw(bg);
+
+    const FrameProfiler::Sample &last = profiler.recent(0);
+    const auto section = [&last](ProfileSection s) { return last.section_ms[static_cast<size_t>(s)]; };
+
+    char lines[4][96];
+    std::snprintf(lines[0], sizeof(lines[0]), "Frame %.2f ms  (%.0f FPS)", last.frame_ms, profiler.average_fps());
+    std::snprintf(lines[1], sizeof(lines[1]), "Events %.2f  Render %.2f ms",
+                  section(ProfileSection::HandleEvents), section(ProfileSection::Render));
+    std::snprintf(lines[2], sizeof(lines[2]), "Special %.2f  Targets %.2f ms",
+                  section(ProfileSection::SpecialButtonsPanel), section(ProfileSection::TargetSelectionButtons));
+    std::snprintf(lines[3], sizeof(lines[3]), "Draws %u  Texts %u  Queries %u",
+                  last.draw_calls, last.texts_created, last.game_queries);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        sf::Text text(lines[i], font, 13);
+        text.setPosition(box_x + 8, box_y + 6 + i * 18);
+        text.setFillColor(sf::Color(180, 255, 180));
+        window.draw(text);
+    }
+
+    const float base_y = box_y + box_height - 8;
+    const float bar_width = (box_width - 16) / history;
+    sf::VertexArray bars(sf::Quads);
+    size_t frames = std::min<size_t>(history, profiler.size());
+    for (size_t age = 0; age < frames; ++age)
+    {
+        double ms = profiler.recent(age).frame_ms;
+        float h = std::min(graph_height, static_cast<float>(ms) / ms_per_px);
+        float x = box_x + 8 + (history - 1 - static_cast<float>(age)) * bar_width;
+        sf::Color color = ms > 33.4 ? sf::Color::Red : ms > 16.7 ? sf::Color::Yellow : sf::Color(120, 255, 120);
+        bars.append(sf::Vertex(sf::Vector2f(x, base_y), color));
+        bars.append(sf::Vertex(sf::Vector2f(x + bar_width, base_y), color));
+        bars.append(sf::Vertex(sf::Vector2f(x + bar_width, base_y - h), color));
+        bars.append(sf::Vertex(sf::Vector2f(x, base_y - h), color));
+    }
+    window.draw(bars);
+
+    float target_y = base_y - std::min(graph_height, 16.7f / ms_per_px);
+    sf::VertexArray target_line(sf::Lines);
+    target_line.append(sf::Vertex(sf::Vector2f(box_x + 8, target_y), sf::Color::White));
+    target_line.append(sf::Vertex(sf::Vector2f(box_x + box_width - 8, target_y), sf::Color::White));
+    window.draw(target_line);
 }
 
 } // namespace coup
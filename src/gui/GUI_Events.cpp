@@ -7,12 +7,32 @@
 #include "Governor.hpp"
 #include "Spy.hpp"
 #include "Judge.hpp"
-#include "Baron.hpp"
 #include "General.hpp"
 #include "Merchant.hpp"
 
 namespace coup
 {
+    namespace
+    {
+        /**
+         * @brief Action buttons by label; Arrest, Sanction and Coup then wait for a target click.
+         */
+        const std::pair<const char *, TurnAction::Kind> ACTION_BUTTONS[] = {
+            {"Gather", TurnAction::Kind::Gather},     {"Tax", TurnAction::Kind::Tax},
+            {"Bribe", TurnAction::Kind::Bribe},       {"Invest", TurnAction::Kind::Invest},
+            {"Skip Turn", TurnAction::Kind::Skip},    {"Arrest", TurnAction::Kind::Arrest},
+            {"Sanction", TurnAction::Kind::Sanction}, {"Coup", TurnAction::Kind::Coup},
+        };
+
+        /**
+         * @brief Prompt shown while a target action waits for its target.
+         */
+        std::string target_prompt(TurnAction::Kind kind)
+        {
+            return "Choose a player to " + TurnAction{kind, ""}.describe() + ":";
+        }
+    } // namespace
+
     /**
      * @brief Handles user input during the setup phase.
      *
@@ -34,22 +54,17 @@ namespace coup
 
         if (event.type == sf::Event::MouseButtonPressed)
         {
-            sf::Vector2i mouse = sf::Mouse::getPosition(window);
+            HitRegistry::Hit hit = hits.hit(sf::Mouse::getPosition(window));
             std::vector<std::string> roles = {"Governor", "Spy", "Judge", "Baron", "General", "Merchant"};
 
-            for (size_t i = 0; i < roles.size(); ++i)
+            if (hit.kind == WidgetKind::RoleButton && hit.index < static_cast<int>(roles.size()))
             {
-                sf::RectangleShape roleBtn = createButton(30 + i * 120, 120, 100, 40, sf::Color(100, 149, 237));
-                if (isMouseOver(roleBtn, mouse))
-                {
-                    selected_role = roles[i];
-                    error_message.clear();
-                    info_message.clear();
-                }
+                selected_role = roles[hit.index];
+                error_message.clear();
+                info_message.clear();
             }
 
-            sf::RectangleShape addBtn = createButton(30, 180, 200, 40, sf::Color(0, 200, 100));
-            if (isMouseOver(addBtn, mouse))
+            if (hit.kind == WidgetKind::AddPlayer)
             {
                 if (!name_input.empty() && !selected_role.empty())
                 {
@@ -61,8 +76,31 @@ namespace coup
                 }
             }
 
-            sf::RectangleShape startBtn = createButton(30, 240, 200, 40, sf::Color(255, 215, 0));
-            if (isMouseOver(startBtn, mouse) && game.players().size() >= 2)
+            if (hit.kind == WidgetKind::AddBot)
+            {
+                if (selected_role.empty())
+                    error_message = "Select a role for the bot.";
+                else if (tryAddBot(selected_role))
+                    selected_role.clear();
+            }
+
+            if (hit.kind == WidgetKind::BotLevel)
+            {
+                bot_strength = (bot_strength == BotStrength::Random)   ? BotStrength::Greedy
+                               : (bot_strength == BotStrength::Greedy) ? BotStrength::Search
+                                                                       : BotStrength::Random;
+            }
+
+            if (hit.kind == WidgetKind::BotDelay)
+            {
+                const int delays[] = {0, 250, 500, 1000, 2000};
+                size_t i = 0;
+                while (i < 5 && delays[i] != bot_delay_ms)
+                    ++i;
+                bot_delay_ms = delays[(i + 1) % 5];
+            }
+
+            if (hit.kind == WidgetKind::StartGame && view().alive_count() >= 2)
             {
                 state = GUIState::Playing;
                 error_message.clear();
@@ -75,42 +113,35 @@ namespace coup
      * @brief Handles clicks on global GUI buttons such as "New Game".
      *
      * If the new game button is clicked, the game is reset and returns to setup state.
+     * Both the in-game and the game-over button are registered as WidgetKind::NewGame
+     * by render(), so the clickable area always matches what was drawn.
      *
-     * @param mouse The mouse click position.
+     * @param hit The widget under the mouse click.
      * @return true if a global button was clicked and handled.
      * @return false otherwise.
      */
-    bool GUI::handleGlobalButtons(const sf::Vector2i &mouse)
+    bool GUI::handleGlobalButtons(const HitRegistry::Hit &hit)
     {
-        if (persistent_new_game_button.contains(static_cast<float>(mouse.x), static_cast<float>(mouse.y)))
+        if (hit.kind == WidgetKind::NewGame)
         {
-            game.reset();
+            engine.submit([](Game &g) { g.reset(); });
+            bots.clear();
+            pending_bots.clear();
+            bot_command = 0;
             name_input.clear();
             selected_role.clear();
             error_message.clear();
             info_message.clear();
-            pending_target_action = PendingTargetAction::None;
+            pending_target.reset();
+            timeline.clear();
+            scrub_turn.reset();
             state = GUIState::Setup;
             return true;
         }
 
-        if (game.is_game_over())
+        if (view().game_over)
         {
-            sf::RectangleShape newGameBtn = createButton(250, 300, 300, 50, sf::Color(100, 200, 100));
-            if (isMouseOver(newGameBtn, mouse))
-            {
-                game.reset();
-                name_input.clear();
-                selected_role.clear();
-                error_message.clear();
-                info_message.clear();
-                pending_target_action = PendingTargetAction::None;
-                state = GUIState::Setup;
-            }
-            else
-            {
-                error_message = "Game is over. Click 'New Game' to start again.";
-            }
+            error_message = "Game is over. Click 'New Game' to start again.";
             return true;
         }
 
@@ -119,307 +150,341 @@ namespace coup
     /**
      * @brief Handles clicks on special out-of-turn role buttons (e.g., Spy Peek, Undo Tax).
      *
-     * Validates role and triggers appropriate role-specific actions. Shows popups when required.
+     * Candidate targets are read from the frame's snapshot and chosen in a popup; the ability
+     * itself is submitted to the engine, and its outcome arrives through applyCommandResults().
      *
-     * @param mouse Mouse click position.
+     * @param hit The widget under the mouse click.
      * @param current The current player.
      * @return true if a special button was clicked and handled.
      * @return false otherwise.
      */
 
-    bool GUI::handleSpecialButtonClick(const sf::Vector2i &mouse, std::shared_ptr<Player> current)
+    bool GUI::handleSpecialButtonClick(const HitRegistry::Hit &hit, const PlayerView &current)
     {
-        for (const auto &[bounds, target_name, role] : special_buttons_positions)
+        if (hit.kind != WidgetKind::SpecialButton || hit.index >= static_cast<int>(special_buttons_positions.size()))
+            return false;
+
+        const std::string target_name = special_buttons_positions[hit.index].player_name;
+        const std::string role = special_buttons_positions[hit.index].role;
+        const GameSnapshot &snap = view();
+        const std::string current_name = current.name;
+        const int original_coins = current.coins;
+
+        // The player in turn may not use an ability while a coup is forced on them
+        if (target_name == current_name && current.coins >= snap.forced_coup_at)
         {
-            if (bounds.contains(static_cast<float>(mouse.x), static_cast<float>(mouse.y)))
-            {
-                try
-                {
+            handle_gui_exception(MustCoupWith10CoinsException());
+            return true;
+        }
 
-                    auto target = game.get_player_by_name(target_name);
-                    int original_coins = current->coins();
+        if (role == "Governor")
+        {
+            std::vector<PlayerView> tax_targets;
+            for (const auto &p : snap.players)
+            {
+                if (p.last_action == "tax" && p.can_still_undo && p.name != target_name && p.active)
+                    tax_targets.push_back(p);
+            }
 
-                    if (role == "Governor")
-                    {
-                        if (target_name == current->get_name())
-                        {
-                            target->ensure_coup_required();
-                        }
-                        auto *gov_real = dynamic_cast<Governor *>(target.get());
+            if (!tax_targets.empty())
+            {
+                const PlayerView *selected = show_selection_popup(tax_targets, "Choose Player to undo tax for:", sf::Color(70, 70, 200));
+                if (selected)
+                {
+                    engine.submit([target_name, original_coins, victim = selected->name](Game &g) {
+                        auto *gov_real = dynamic_cast<Governor *>(g.get_player_by_name(target_name));
                         if (!gov_real)
                             throw std::runtime_error("Player is not a Governor");
                         gov_real->set_coins(original_coins);
-                        std::vector<std::shared_ptr<Player>> tax_targets;
-                        const auto &last_actions = game.get_last_actions();
-
-                        for (const auto &[player_name, action] : last_actions)
-                        {
-                            if (action == "tax" && game.can_still_undo(player_name) && player_name != target_name)
-                            {
-                                auto p = game.get_player_by_name(player_name);
-                                if (p && p->is_active())
-                                    tax_targets.push_back(p);
-                            }
-                        }
-
-                        if (!tax_targets.empty())
-                        {
-                            auto selected = show_selection_popup(tax_targets, "Choose Player to undo tax for:", sf::Color(70, 70, 200));
-                            if (selected)
-                                gov_real->undo_tax(*selected);
-                            else
-                                info_message = "No target selected.";
-                        }
-                        else
-                            error_message = "No tax targets available.";
-                    }
+                        gov_real->undo_tax(*g.get_player_by_name(victim));
+                    });
+                }
+                else
+                    info_message = "No target selected.";
+            }
+            else
+                error_message = "No tax targets available.";
+        }
 
-                    else if (role == "Judge")
-                    {
-                        if (target_name == current->get_name())
-                        {
-                            target->ensure_coup_required();
-                        }
-                        auto *judge_real = dynamic_cast<Judge *>(target.get());
-                        if (!judge_real)
-                            throw std::runtime_error("Player is not a Judge");
-                        judge_real->set_coins(original_coins);
-                        auto turn_player_ptr = game.get_player_by_name(game.turn());
-                        judge_real->undo_bribe(*turn_player_ptr);
-                        current->set_coins(judge_real->coins());
-                    }
+        else if (role == "Judge")
+        {
+            engine.submit([target_name, current_name, original_coins](Game &g) {
+                auto *judge_real = dynamic_cast<Judge *>(g.get_player_by_name(target_name));
+                if (!judge_real)
+                    throw std::runtime_error("Player is not a Judge");
+                judge_real->set_coins(original_coins);
+                auto turn_player_ptr = g.get_player_by_name(current_name);
+                judge_real->undo_bribe(*turn_player_ptr);
+                turn_player_ptr->set_coins(judge_real->coins());
+            });
+        }
 
-                    else if (role == "General")
-                    {
-                        if (target_name == current->get_name())
-                        {
-                            target->ensure_coup_required();
-                        }
-                        auto *general_real = dynamic_cast<General *>(target.get());
+        else if (role == "General")
+        {
+            std::vector<PlayerView> coup_targets;
+            for (const auto &[attacker, victim] : snap.coup_pending_list)
+            {
+                const PlayerView *p = snap.find(victim);
+                const PlayerView *a = snap.find(attacker);
+                if (p && !p->active && a && a->can_still_undo)
+                    coup_targets.push_back(*p);
+            }
+
+            if (!coup_targets.empty())
+            {
+                const PlayerView *selected = show_selection_popup(coup_targets, "Choose Player to revive from coup", sf::Color(180, 50, 50));
+                if (selected)
+                {
+                    engine.submit([target_name, original_coins, victim = selected->name](Game &g) {
+                        auto *general_real = dynamic_cast<General *>(g.get_player_by_name(target_name));
                         if (!general_real)
                             throw std::runtime_error("Player is not a General");
                         general_real->set_coins(original_coins);
-                        std::vector<std::shared_ptr<Player>> coup_targets;
-
-                        for (const auto &[attacker, victim] : game.get_coup_pending_list())
-                        {
-                            auto p = game.get_player_by_name(victim);
-                            if (p && !p->is_active() && game.can_still_undo(attacker))
-                                coup_targets.push_back(p);
-                        }
-
-                        if (!coup_targets.empty())
-                        {
-                            auto selected = show_selection_popup(coup_targets, "Choose Player to revive from coup", sf::Color(180, 50, 50));
-                            if (selected)
-                                general_real->undo_coup(*selected);
-                            else
-                                info_message = "No target selected.";
-                        }
-                        else
-                            error_message = "No coup targets available.";
-                    }
-
-                    else if (role == "Spy")
-                    {
-                        if (target_name == current->get_name())
-                        {
-                            target->ensure_coup_required();
-                        }
-                        auto *spy_real = dynamic_cast<Spy *>(target.get());
-                        if (!spy_real)
-                            throw std::runtime_error("Player is not a Spy");
-                        spy_real->set_coins(original_coins);
-                        std::vector<std::shared_ptr<Player>> targets;
-                        for (const auto &name : game.players())
-                        {
-                            if (name != target_name)
-                                targets.push_back(game.get_player_by_name(name));
-                        }
-
-                        auto selected = show_selection_popup(targets, "Choose Player to Peek&Disable arrest for", sf::Color(70, 70, 200));
-                        if (selected)
-                        {
-                            spy_real->peek_and_disable(*selected);
-                            show_peek_result_popup(selected->role(), selected->coins());
-                        }
-                        else
-                            info_message = "No target selected.";
-                    }
-
-                    info_message = game.get_last_action();
-                }
-                catch (const std::exception &e)
-                {
-                    handle_gui_exception(e);
-                    info_message.clear();
+                        general_real->undo_coup(*g.get_player_by_name(victim));
+                    });
                 }
+                else
+                    info_message = "No target selected.";
+            }
+            else
+                error_message = "No coup targets available.";
+        }
+
+        else if (role == "Spy")
+        {
+            std::vector<PlayerView> targets;
+            for (const auto &p : snap.players)
+            {
+                if (p.active && p.name != target_name)
+                    targets.push_back(p);
+            }
 
-                return true;
+            const PlayerView *selected = show_selection_popup(targets, "Choose Player to Peek&Disable arrest for", sf::Color(70, 70, 200));
+            if (selected)
+            {
+                peek_target = *selected;
+                peek_command = engine.submit([target_name, original_coins, victim = selected->name](Game &g) {
+                    auto *spy_real = dynamic_cast<Spy *>(g.get_player_by_name(target_name));
+                    if (!spy_real)
+                        throw std::runtime_error("Player is not a Spy");
+                    spy_real->set_coins(original_coins);
+                    spy_real->peek_and_disable(*g.get_player_by_name(victim));
+                });
             }
+            else
+                info_message = "No target selected.";
         }
-        return false;
+
+        return true;
     }
 
     /**
      * @brief Handles clicks on target players during a pending target action (Arrest, Sanction, Coup).
      *
-     * If the user selects a valid target, the action is performed.
+     * If the user selects a target, the action is submitted to the engine. The pending action
+     * stays selected until the engine reports success, so a rejected target can be corrected.
      *
-     * @param mouse Mouse click position.
+     * @param hit The widget under the mouse click.
      * @param current The current player initiating the target action.
-     * @return true if a valid target was clicked and the action was executed.
+     * @return true if a target was clicked and the action was submitted.
      * @return false otherwise.
      */
 
-    bool GUI::handleTargetActionClick(const sf::Vector2i &mouse, std::shared_ptr<Player> current)
+    bool GUI::handleTargetActionClick(const HitRegistry::Hit &hit, const PlayerView &current)
     {
-        if (pending_target_action == PendingTargetAction::None)
+        if (!pending_target)
+            return false;
+        if (hit.kind != WidgetKind::TargetButton || hit.index >= static_cast<int>(current_targets.size()))
             return false;
 
-        for (size_t i = 0; i < target_button_bounds.size(); ++i)
-        {
-            if (target_button_bounds[i].contains(static_cast<float>(mouse.x), static_cast<float>(mouse.y)))
-            {
-                const std::string &selected_name = current_target_names[i];
-                auto target = game.get_player_by_name(selected_name);
-
-                try
-                {
-                    if (pending_target_action == PendingTargetAction::Arrest)
-                        current->arrest(*target);
-                    else if (pending_target_action == PendingTargetAction::Sanction)
-                        current->sanction(*target);
-                    else if (pending_target_action == PendingTargetAction::Coup)
-                        current->coup(*target);
-
-                    info_message = game.get_last_action();
-                    error_message.clear();
-                    pending_target_action = PendingTargetAction::None;
-                    return true;
-                }
-                catch (const std::exception &e)
-                {
-                    std::string msg = e.what();
-                    std::cerr << "[GUI Exception] " << msg << std::endl;
-
-                    // ✅ אם זו חריגת Coup (האם צריך לבצע Coup)
-                    if (msg.find("must perform a coup") != std::string::npos)
-                    {
-                        error_message = msg;
-                        pending_target_action = PendingTargetAction::Coup;
-                        info_message = "Choose a player to coup:";
-
-                        // ⬅️ הכנס את כפתורי היעדים באופן ישיר
-                        current_target_names.clear();
-                        target_button_bounds.clear();
-                        for (const auto &name : game.players())
-                        {
-                            if (name != current->get_name())
-                            {
-                                current_target_names.push_back(name); // הוסף את השחקנים המועמדים ל־Coup
-                            }
-                        }
-
-                        // ⬇️ עכשיו צייר את כפתורי היעדים
-                        drawActionButtons(current); // צייר את הכפתורים עם היעדים
-                        render();                   // רנדר את המסך מחדש
-                        return true;                // אל תחזור מיד מ־catch, כי התפריט לא ייפתח אחרת
-                    }
-                    else
-                    {
-                        error_message = msg;
-                        info_message = (pending_target_action == PendingTargetAction::Arrest)
-                                           ? "Choose a player to arrest:"
-                                       : (pending_target_action == PendingTargetAction::Sanction)
-                                           ? "Choose a player to sanction:"
-                                           : "Choose a player to coup:";
-                    }
-
-                    // ❌ שים לב, רק אם לא הייתה חריגה של Coup תחזור ותחזיר false
-                    return false;
-                }
-            }
-        }
-        return false;
+        const TurnAction action{*pending_target, view().players.at(current_targets[hit.index]).name};
+        target_command = engine.submit([action, actor = current.name](Game &g) {
+            apply_action(g, *g.get_player_by_name(actor), action);
+        });
+        error_message.clear();
+        return true;
     }
     /**
      * @brief Handles clicks on basic action buttons like Gather, Tax, Bribe, Invest, or Skip Turn.
      *
-     * Executes the corresponding action for the current player.
+     * Submits the corresponding action for the current player, or arms a target action.
      *
-     * @param mouse Mouse click position.
+     * @param hit The widget under the mouse click.
      * @param current The current player taking action.
      * @return true if an action button was clicked and handled.
      * @return false otherwise.
      */
 
-    bool GUI::handleBasicActionClick(const sf::Vector2i &mouse, std::shared_ptr<Player> current)
+    bool GUI::handleBasicActionClick(const HitRegistry::Hit &hit, const PlayerView &current)
     {
-        for (const auto &pair : action_buttons_bounds)
+        if (hit.kind != WidgetKind::ActionButton || hit.index >= static_cast<int>(action_labels.size()))
+            return false;
+
+        const std::string &label = action_labels[hit.index];
+        for (const auto &[text, kind] : ACTION_BUTTONS)
         {
-            if (pair.first.contains(static_cast<float>(mouse.x), static_cast<float>(mouse.y)))
+            if (label != text)
+                continue;
+            const TurnAction action{kind, ""};
+            if (action.needs_target())
             {
-                try
-                {
-                    if (pair.second == "Gather")
-                    {
-                        current->gather();
-                    }
-                    else if (pair.second == "Tax")
-                    {
-                        current->tax();
-                    }
-                    else if (pair.second == "Bribe")
-                    {
-                        current->bribe();
-                    }
-                    else if (pair.second == "Invest")
-                    {
-                        auto *baron = dynamic_cast<Baron *>(current.get());
-                        if (!baron)
-                            throw InvalidActionException("Only a Baron can use Invest.");
-                        baron->invest();
-                    }
-                    else if (pair.second == "Skip Turn")
-                    {
-                        current->skip_turn();
-                    }
-                    else if (pair.second == "Arrest")
-                    {
-                        pending_target_action = PendingTargetAction::Arrest;
-                        info_message = "Choose a player to arrest:";
-                    }
-                    else if (pair.second == "Sanction")
-                    {
-                        pending_target_action = PendingTargetAction::Sanction;
-                        info_message = "Choose a player to sanction:";
-                    }
-                    else if (pair.second == "Coup")
-                    {
-                        pending_target_action = PendingTargetAction::Coup;
-                        info_message = "Choose a player to coup:";
-                    }
+                pending_target = kind;
+                info_message = target_prompt(kind);
+            }
+            else
+            {
+                engine.submit([action, actor = current.name](Game &g) {
+                    apply_action(g, *g.get_player_by_name(actor), action);
+                });
+            }
+            break;
+        }
 
-                    error_message.clear();
+        error_message.clear();
+        return true;
+    }
 
-                    // רק אם זו לא פעולה שדורשת מטרה
-                    if (pair.second != "Coup" && pair.second != "Sanction" && pair.second != "Arrest" && pair.second != "Skip Turn")
-                    {
-                        info_message = game.get_last_action();
-                        render();
-                    }
-                }
-                catch (const std::exception &e)
+    /**
+     * @brief Applies the results of commands the engine finished since the last frame.
+     *
+     * Successful actions show the game's new last action; failures are shown like GUI
+     * exceptions (a forced coup switches to coup target selection). A bot takes over its
+     * player once the add succeeds and is dropped if it fails. A failed target action
+     * keeps its target selection open with the matching prompt.
+     */
+    void GUI::applyCommandResults()
+    {
+        CommandResult result;
+        while (engine.poll_result(result))
+        {
+            if (result.id == bot_command)
+            {
+                last_bot_latency_ms = std::chrono::duration<double, std::milli>(
+                                          std::chrono::steady_clock::now() - bot_submitted_at).count();
+                bot_command = 0;
+            }
+
+            auto added_bot = pending_bots.find(result.id);
+            if (added_bot != pending_bots.end())
+            {
+                if (result.ok)
+                    bots[added_bot->second.name] = std::move(added_bot->second.bot);
+                pending_bots.erase(added_bot);
+            }
+
+            if (!result.ok)
+            {
+                const std::optional<TurnAction::Kind> previous = pending_target;
+                handle_gui_error(result.message);
+                if (result.id == target_command)
                 {
-                    handle_gui_exception(e);
-                    info_message.clear();
+                    if (!pending_target)
+                        pending_target = previous;
+                    if (pending_target)
+                        info_message = target_prompt(*pending_target);
                 }
-
-                return true;
+                continue;
             }
+
+            if (result.id == target_command)
+                pending_target.reset();
+            if (!result.message.empty() && state == GUIState::Playing)
+                info_message = result.message;
+            if (result.id == peek_command)
+                show_peek_result_popup(peek_target.role, peek_target.coins);
         }
-        return false;
+    }
+
+    /**
+     * @brief Starts the move of the bot in turn once the configured delay has passed.
+     *
+     * The delay restarts whenever a new snapshot shows a bot in turn. The move itself
+     * (thinking included) runs on the engine thread; only one bot move is in flight at a time.
+     */
+    void GUI::updateBots()
+    {
+        if (state != GUIState::Playing || bot_command != 0 || scrub_turn || view().game_over)
+            return;
+
+        const PlayerView *current = view().current_player();
+        if (!current || !isBot(current->name))
+            return;
+
+        auto now = std::chrono::steady_clock::now();
+        if (bot_turn_version != view().version)
+        {
+            bot_turn_version = view().version;
+            bot_turn_since = now;
+        }
+        if (now - bot_turn_since < std::chrono::milliseconds(bot_delay_ms))
+            return;
+
+        std::shared_ptr<Bot> bot = bots[current->name];
+        bot_submitted_at = now;
+        bot_command = engine.submit([bot, name = current->name](Game &g) { bot->play_turn(g, name); });
+    }
+
+    /**
+     * @brief Handles clicks on the turn scrubber: one turn back, one turn forward, or back to the live game.
+     *
+     * @param hit The widget under the mouse click.
+     * @return true if a scrubber button was clicked.
+     */
+    bool GUI::handleTimelineButtons(const HitRegistry::Hit &hit)
+    {
+        if (hit.kind != WidgetKind::TimelineButton || timeline.empty())
+            return false;
+
+        const int from = scrub_turn.value_or(timeline.last_turn());
+        if (hit.index == 0)
+            scrubTo(std::max(from - 1, timeline.first_turn()));
+        else if (hit.index == 1 && scrub_turn)
+            scrubTo(*scrub_turn + 1);
+        else if (hit.index == 2)
+            scrubTo(std::nullopt);
+        return true;
+    }
+
+    /**
+     * @brief Adds the frame's snapshot to the timeline if the engine published a new one.
+     *
+     * While an earlier turn is shown, the frame keeps drawing that turn's version.
+     */
+    void GUI::recordTimeline()
+    {
+        if (state == GUIState::Playing && snapshot->version != recorded_version)
+        {
+            timeline.record(*snapshot);
+            recorded_version = snapshot->version;
+        }
+        if (scrub_turn)
+            snapshot = &scrubbed;
+    }
+
+    /**
+     * @brief Shows the state at the end of `turn`, or the live game again.
+     *
+     * Turns at or after the newest recorded one are the live game. Pending target
+     * selection is dropped, since its targets belong to the live game.
+     *
+     * @param turn The turn to look at (empty: back to the live game).
+     */
+    void GUI::scrubTo(std::optional<int> turn)
+    {
+        pending_target.reset();
+        if (!turn || timeline.empty() || *turn >= timeline.last_turn())
+        {
+            scrub_turn.reset();
+            snapshot = &engine.snapshot();
+            info_message.clear();
+            return;
+        }
+
+        scrub_turn = std::max(*turn, timeline.first_turn());
+        timeline.at(timeline.version_at_turn(*scrub_turn)).materialize(scrubbed);
+        snapshot = &scrubbed;
+        info_message = "Viewing turn " + std::to_string(*scrub_turn) + " of " + std::to_string(timeline.last_turn()) +
+                       " (Left/Right to scrub, End for the live game)";
     }
 
 } // namespace coup
@@ -3,6 +3,7 @@
 #include "GUI.hpp"
 #include <SFML/Graphics.hpp>
 #include <iostream>
+#include <random>
 #include "Exceptions.hpp"
 
 namespace coup {
@@ -10,24 +11,59 @@ namespace coup {
 /**
  * @brief Attempts to create and add a player to the game.
  * 
- * Displays error messages if the name is duplicate or other exceptions occur.
+ * Names already shown in the snapshot are rejected immediately; otherwise the player is
+ * added by the engine, and any other failure is reported through applyCommandResults().
  * 
  * @param name The name of the player to add.
  * @param role The role selected for the player.
- * @return true if the player was successfully added.
+ * @return true if the player was submitted for adding.
  * @return false if an error occurred.
  */
 bool GUI::tryCreateAndAddPlayer(const std::string &name, const std::string &role) {
-    try {
-        game.add_player(name, role);
-        error_message.clear();
-        return true;
-    } catch (const DuplicatePlayerNameException &e) {
-        error_message = e.what();
-    } catch (const std::exception &e) {
-        error_message = "Failed to add player: " + std::string(e.what());
+    if (view().find(name)) {
+        error_message = DuplicatePlayerNameException(name).what();
+        return false;
     }
-    return false;
+    engine.submit([name, role](Game &g) { g.add_player(name, role); });
+    error_message.clear();
+    return true;
+}
+
+/**
+ * @brief Adds a bot-controlled player with the selected role and bot strength.
+ * 
+ * The bot is named "Bot1", "Bot2", ... (first free name). It only controls the player once
+ * the engine reports the player added (see applyCommandResults()); if the engine rejects
+ * the player, the bot is dropped.
+ * 
+ * @param role The role selected for the bot.
+ * @return true if the bot was submitted for adding.
+ */
+bool GUI::tryAddBot(const std::string &role) {
+    auto taken = [this](const std::string &name) {
+        if (view().find(name) || bots.count(name))
+            return true;
+        for (const auto &pending : pending_bots)
+            if (pending.second.name == name)
+                return true;
+        return false;
+    };
+    int n = 1;
+    std::string name = "Bot1";
+    while (taken(name))
+        name = "Bot" + std::to_string(++n);
+
+    const uint64_t id = engine.submit([name, role](Game &g) { g.add_player(name, role); });
+    pending_bots[id] = {name, std::make_shared<Bot>(bot_strength, std::random_device{}())};
+    error_message.clear();
+    return true;
+}
+
+/**
+ * @brief Returns true if the named player is controlled by a bot.
+ */
+bool GUI::isBot(const std::string &name) const {
+    return bots.count(name) != 0;
 }
 
 /**
@@ -38,17 +74,25 @@ bool GUI::tryCreateAndAddPlayer(const std::string &name, const std::string &role
  * @param e The exception that was thrown.
  */
 void GUI::handle_gui_exception(const std::exception &e) {
-    std::string msg = e.what();
+    handle_gui_error(e.what());
+}
+
+/**
+ * @brief Displays an error raised in the GUI or reported by the engine.
+ * 
+ * A forced coup switches the GUI into coup target selection.
+ * 
+ * @param msg The error text.
+ */
+void GUI::handle_gui_error(const std::string &msg) {
     std::cerr << "[GUI Exception] " << msg << std::endl;
     error_message = msg;
     info_message.clear();
     if (msg.find("must perform a coup") != std::string::npos) {
-        pending_target_action = PendingTargetAction::Coup;
+        pending_target = TurnAction::Kind::Coup;
     } else {
-        pending_target_action = PendingTargetAction::None;
+        pending_target.reset();
     }
-
-    render();
 }
 
 /**
@@ -70,21 +114,6 @@ sf::RectangleShape GUI::createButton(float x, float y, float w, float h, const s
     return rect;
 }
 
-/**
- * @brief Checks whether a mouse position is over a given rectangle (button).
- * 
- * @param rect The rectangle to check.
- * @param mousePos The current position of the mouse.
- * @return true if the mouse is over the rectangle.
- * @return false otherwise.
- */
-bool GUI::isMouseOver(const sf::RectangleShape &rect, sf::Vector2i mousePos) {
-    sf::Vector2f pos = rect.getPosition();
-    sf::Vector2f size = rect.getSize();
-    return mousePos.x >= pos.x && mousePos.x <= pos.x + size.x &&
-           mousePos.y >= pos.y && mousePos.y <= pos.y + size.y;
-}
-
 /**
  * @brief Shows a popup window with a list of players to select from.
  * 
@@ -93,10 +122,10 @@ bool GUI::isMouseOver(const sf::RectangleShape &rect, sf::Vector2i mousePos) {
  * @param targets List of player targets to choose from.
  * @param title The window title.
  * @param button_color The color of the selection buttons.
- * @return std::shared_ptr<Player> The selected player, or nullptr if none selected.
+ * @return The selected entry of targets, or nullptr if none selected.
  */
-std::shared_ptr<coup::Player> GUI::show_selection_popup(
-    const std::vector<std::shared_ptr<coup::Player>> &targets,
+const PlayerView *GUI::show_selection_popup(
+    const std::vector<PlayerView> &targets,
     const std::string &title,
     const sf::Color &button_color)
 {
@@ -127,7 +156,7 @@ std::shared_ptr<coup::Player> GUI::show_selection_popup(
         txt.setFont(popup_font);
         txt.setCharacterSize(18);
         txt.setFillColor(sf::Color::White);
-        txt.setString(targets[i]->get_name() + " (" + targets[i]->role() + ")");
+        txt.setString(targets[i].name + " (" + targets[i].role + ")");
         txt.setPosition(btn.getPosition().x + 10, btn.getPosition().y + 7);
         labels.push_back(txt);
     }
@@ -151,7 +180,7 @@ std::shared_ptr<coup::Player> GUI::show_selection_popup(
                     if (buttons[i].getGlobalBounds().contains(mpos))
                     {
                         popup.close();
-                        return targets[i]; // ✅ יחזור עם הבחירה
+                        return &targets[i]; // ✅ יחזור עם הבחירה
                     }
                 }
             }
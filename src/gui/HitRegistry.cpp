@@ -0,0 +1,77 @@
+// Anksilae@gmail.com
+// HitRegistry.cpp
+
+#include "HitRegistry.hpp"
+#include <algorithm>
+
+namespace coup {
+
+/**
+ * @brief Creates a grid of cell_size x cell_size cells that covers the given area.
+ */
+HitRegistry::HitRegistry(unsigned width, unsigned height, unsigned cell_size)
+    : cell_size(cell_size),
+      cols((width + cell_size - 1) / cell_size),
+      rows((height + cell_size - 1) / cell_size),
+      cells(static_cast<size_t>(cols) * rows)
+{
+}
+
+/**
+ * @brief Clears all registered widgets while keeping the allocated cell storage.
+ */
+void HitRegistry::clear()
+{
+    entries.clear();
+    for (auto &cell : cells)
+        cell.clear();
+}
+
+/**
+ * @brief Registers a widget in every grid cell its bounds overlap.
+ *
+ * Parts of the widget outside the covered area are ignored.
+ */
+void HitRegistry::add(WidgetKind kind, int index, const sf::FloatRect &bounds)
+{
+    const auto id = static_cast<std::uint16_t>(entries.size());
+    entries.push_back({kind, index, bounds});
+
+    const int cs = static_cast<int>(cell_size);
+    int c0 = std::max(0, static_cast<int>(bounds.left) / cs);
+    int r0 = std::max(0, static_cast<int>(bounds.top) / cs);
+    int c1 = std::min(static_cast<int>(cols) - 1, static_cast<int>(bounds.left + bounds.width) / cs);
+    int r1 = std::min(static_cast<int>(rows) - 1, static_cast<int>(bounds.top + bounds.height) / cs);
+
+    for (int r = r0; r <= r1; ++r)
+        for (int c = c0; c <= c1; ++c)
+            cells[cell_index(c, r)].push_back(id);
+}
+
+/**
+ * @brief Looks up the cell under the point and tests only the widgets stored there.
+ *
+ * @param pos Mouse position in window coordinates.
+ * @return The top-most widget containing the point, or a Hit with WidgetKind::None.
+ */
+HitRegistry::Hit HitRegistry::hit(sf::Vector2i pos) const
+{
+    if (pos.x < 0 || pos.y < 0)
+        return {};
+
+    int c = pos.x / static_cast<int>(cell_size);
+    int r = pos.y / static_cast<int>(cell_size);
+    if (c >= static_cast<int>(cols) || r >= static_cast<int>(rows))
+        return {};
+
+    const auto &cell = cells[cell_index(c, r)];
+    for (auto it = cell.rbegin(); it != cell.rend(); ++it)
+    {
+        const Entry &e = entries[*it];
+        if (e.bounds.contains(static_cast<float>(pos.x), static_cast<float>(pos.y)))
+            return {e.kind, e.index};
+    }
+    return {};
+}
+
+} // namespace coup
@@ -3,6 +3,7 @@
 #include "Baron.hpp"
 #include "Exceptions.hpp"
 #include "Game.hpp"
+#include "Trace.hpp"
 #include <iostream>
 
 namespace coup {
@@ -23,29 +24,45 @@ std::string Baron::role() const {
     return "Baron";
 }
 
+/**
+ * @brief Checks invest: in turn, not forced to coup and holding RulesConfig::invest_cost.
+ */
+Refusal Baron::check(StatAction action, const Player *target) const {
+    if (action != StatAction::Invest)
+        return Player::check(action, target);
+    if (Refusal r = check_turn())
+        return r;
+    return game->with_rules([this](const auto &rules) -> Refusal {
+        if (coin_count >= rules.forced_coup_at)
+            return {Rejection::MustCoup};
+        if (coin_count < rules.invest_cost)
+            return {Rejection::NotEnoughCoins, "", nullptr, rules.invest_cost, coin_count};
+        return check_active();
+    });
+}
+
 /**
  * @brief Performs the Baron's unique "invest" action.
  * 
- * Adds 3 coins to the player if they have at least 3 coins (net +3 gain).
+ * Pays RulesConfig::invest_cost and receives invest_return (3 and 6 by default: net +3);
+ * the player must hold the cost.
  * 
  * @throws NotYourTurnException if not the player's turn.
  * @throws MustCoupWith10CoinsException if coup is required.
- * @throws NotEnoughCoinsException if the player has less than 3 coins.
+ * @throws NotEnoughCoinsException if the player has less than the cost.
  */
 void Baron::invest() {
-    if (game->turn() != name) {
-        throw NotYourTurnException();
-    }
-    ensure_coup_required();
-
-    if (coin_count < 3) {
-        throw NotEnoughCoinsException(3, coin_count); 
-    }
-
-    coin_count += 3;
-    game->perform_action("invest", name);
-    std::cout << "[Baron] " << name << " invested 3 coins and gained 6. Total: " << coin_count << std::endl;
-    game->next_turn();
+    COUP_TRACE_SPAN("Baron::invest");
+    act(StatAction::Invest, nullptr, [&] {
+        game->with_rules([this](const auto &rules) { coin_count += rules.invest_return - rules.invest_cost; });
+        game->perform_action("invest", player_id);
+        if (game->logging()) {
+            const RulesConfig &rules = game->rules();
+            std::cout << "[Baron] " << name << " invested " << rules.invest_cost << " coins and gained " << rules.invest_return
+                      << ". Total: " << coin_count << std::endl;
+        }
+        game->next_turn();
+    });
 }
 
 /**
@@ -53,8 +70,10 @@ void Baron::invest() {
  */
 void Baron::on_sanction() {
     set_coins(coins() + 1);
-    under_sanction = true;
-    std::cout << "[Baron] " << name << " received 1 coin compensation after sanction. Total: " << coin_count << std::endl;
+    Player::on_sanction();
+    if (game->logging()) {
+        std::cout << "[Baron] " << name << " received 1 coin compensation after sanction. Total: " << coin_count << std::endl;
+    }
 }
 
 } // namespace coup
@@ -3,6 +3,7 @@
 #include "General.hpp"
 #include "Exceptions.hpp"
 #include "Game.hpp"
+#include "Trace.hpp"
 
 namespace coup {
 
@@ -22,31 +23,43 @@ std::string General::role() const {
     return "General";
 }
 
+/**
+ * @brief Checks undo_coup: RulesConfig::general_undo_cost in hand, a pending coup on the
+ * target and no coup undone this round.
+ */
+Refusal General::check(StatAction action, const Player *target) const {
+    if (action != StatAction::UndoCoup)
+        return Player::check(action, target);
+    if (!target)
+        return {Rejection::PlayerNotFound};
+    const int cost = game->with_rules([](const auto &rules) { return rules.general_undo_cost; });
+    if (coin_count < cost)
+        return {Rejection::NotEnoughCoins, "", nullptr, cost, coin_count};
+    if (Refusal r = check_active())
+        return r;
+    if (!game->is_coup_pending_on(target->id()))
+        return {Rejection::InvalidAction, "No coup to block on this target."};
+    if (game->used_this_round(Game::RoundAbility::UndoCoup))
+        return {Rejection::InvalidAction, "Coup already undone this round."};
+    return {};
+}
+
 /**
  * @brief Allows the General to undo a coup on a target player.
  * 
- * Costs 5 coins. Only one undo_coup is allowed per round.
+ * Costs RulesConfig::general_undo_cost (5 by default). Only one undo_coup is allowed per round.
  * 
  * @param target The player whose coup is to be undone.
- * @throws NotEnoughCoinsException if the player has less than 5 coins.
+ * @throws NotEnoughCoinsException if the player cannot pay the cost.
  * @throws InvalidActionException if no coup is pending or already undone this round.
  */
 void General::undo_coup(Player& target) {
-    if (coin_count < 5) {
-        throw NotEnoughCoinsException(5, coin_count);
-    }
-
-    if (!game->is_coup_pending_on(target.get_name())) {
-        throw InvalidActionException("No coup to block on this target.");
-    }
-
-    if (game->undo_coup == true) {
-        throw InvalidActionException("Coup already undone this round.");
-    }
-
-    coin_count -= 5;
-    game->cancel_coup(target.get_name());
-    game->undo_coup = true;
+    COUP_TRACE_SPAN("General::undo_coup");
+    act(StatAction::UndoCoup, &target, [&] {
+        coin_count -= game->with_rules([](const auto &rules) { return rules.general_undo_cost; });
+        game->cancel_coup(target.id());
+        game->mark_used(Game::RoundAbility::UndoCoup);
+    });
 }
 
 /**
@@ -3,10 +3,23 @@
 #include "Governor.hpp"
 #include "Game.hpp"
 #include "Exceptions.hpp"
+#include "Trace.hpp"
 #include <iostream>
 
 namespace coup {
 
+namespace {
+
+/**
+ * @brief Coins an undone tax takes back from `target`: what its tax gave.
+ */
+int undo_amount(const Game &game, const Player &target) {
+    const bool governor = target.role() == "Governor";
+    return game.with_rules([governor](const auto &rules) { return governor ? rules.governor_tax : rules.tax_income; });
+}
+
+} // namespace
+
 /**
  * @brief Constructs a Governor role player and registers it to the game.
  * 
@@ -24,23 +37,39 @@ std::string Governor::role() const {
 }
 
 /**
- * @brief Performs the Governor's version of tax (3 coins).
+ * @brief Checks undo_tax: the target's last action was a tax it can still pay back, not the
+ * Governor's own, and no tax was undone this round.
+ */
+Refusal Governor::check(StatAction action, const Player *target) const {
+    if (action != StatAction::UndoTax)
+        return Player::check(action, target);
+    if (!target)
+        return {Rejection::PlayerNotFound};
+    if (!game->can_undo_action(target->id(), "tax"))
+        return {Rejection::UndoNotAllowed, "undo_tax", this};
+    if (game->used_this_round(Game::RoundAbility::UndoTax))
+        return {Rejection::InvalidAction, "Tax already undone this round."};
+    if (target->get_name() == name)
+        return {Rejection::CannotTargetYourself, "undo tax"};
+    const int amount = undo_amount(*game, *target);
+    if (target->coins() < amount)
+        return {Rejection::NotEnoughCoins, "", nullptr, amount, target->coins()};
+    return {};
+}
+
+/**
+ * @brief Performs the Governor's version of tax (RulesConfig::governor_tax coins).
  * 
  * @throws NotYourTurnException if not in turn.
  * @throws InvalidActionException if under sanction or coup is required.
  */
 void Governor::tax() {
-    if (game->turn() != name) {
-        throw NotYourTurnException();
-    }
-    if (under_sanction) {
-        throw InvalidActionException("You are under sanction and cannot use Gather/Tax this turn.");
-    }
-    ensure_coup_required();
-
-    coin_count += 3;
-    game->perform_action("tax", name);
-    game->next_turn();
+    COUP_TRACE_SPAN("Governor::tax");
+    act(StatAction::Tax, nullptr, [&] {
+        game->with_rules([this](const auto &rules) { coin_count += rules.governor_tax; });
+        game->perform_action("tax", player_id);
+        game->next_turn();
+    });
 }
 
 /**
@@ -54,31 +83,18 @@ void Governor::tax() {
  * @throws CannotTargetYourselfException if trying to undo own tax.
  */
 void Governor::undo_tax(Player& target) {
-    if (!game->can_undo_action(target.get_name(), "tax")) {
-        throw UndoNotAllowed(role(), "undo_tax");
-    }
-    if (game->undo_tax) {
-        throw InvalidActionException("Tax already undone this round.");
-    }
-    if (target.get_name() == name) {
-        throw CannotTargetYourselfException("undo tax");
-    }
-
-    int undo_amount = 2;
-    if (target.role() == "Governor") {
-        undo_amount = 3;
-    }
-
-    if (target.coins() < undo_amount) {
-        throw NotEnoughCoinsException(undo_amount, target.coins());
-    }
-
-    target.set_coins(target.coins() - undo_amount);
-    std::cout << "[Governor] " << name << " undoes tax from " << target.get_name()
-              << ", returning " << undo_amount << " coins." << std::endl;
+    COUP_TRACE_SPAN("Governor::undo_tax");
+    act(StatAction::UndoTax, &target, [&] {
+        const int amount = undo_amount(*game, target);
+        target.set_coins(target.coins() - amount);
+        if (game->logging()) {
+            std::cout << "[Governor] " << name << " undoes tax from " << target.get_name()
+                      << ", returning " << amount << " coins." << std::endl;
+        }
 
-    game->cancel_last_action(target.get_name());
-    game->undo_tax = true;
+        game->cancel_last_action(target.id());
+        game->mark_used(Game::RoundAbility::UndoTax);
+    });
 }
 
 } // namespace coup
@@ -4,6 +4,7 @@
 #include "Exceptions.hpp"
 #include "Game.hpp"
 #include "Player.hpp"
+#include "Trace.hpp"
 #include <iostream>
 
 namespace coup {
@@ -24,6 +25,28 @@ std::string Judge::role() const {
     return "Judge";
 }
 
+/**
+ * @brief Checks undo_bribe: the target's last action was a bribe, not the Judge's own, and no
+ * bribe was undone this round.
+ */
+Refusal Judge::check(StatAction action, const Player *target) const {
+    if (action != StatAction::UndoBribe)
+        return Player::check(action, target);
+    if (!target)
+        return {Rejection::PlayerNotFound};
+    if (!game->can_undo_action(target->id(), "bribe"))
+        return {Rejection::UndoNotAllowed, "undo_bribe", this};
+    if (game->used_this_round(Game::RoundAbility::UndoBribe))
+        return {Rejection::InvalidAction, "Bribe already undone this round."};
+    if (target->get_name() == name)
+        return {Rejection::CannotTargetYourself, "undo bribe"};
+    if (Refusal r = check_active())
+        return r;
+    if (!game->get_player_by_id(player_id))
+        return {Rejection::PlayerNotFound};
+    return {};
+}
+
 /**
  * @brief Undoes a bribe action performed by another player.
  * 
@@ -35,20 +58,13 @@ std::string Judge::role() const {
  * @throws CannotTargetYourselfException if trying to undo own bribe.
  */
 void Judge::undo_bribe(Player& target) {
-    if (!game->can_undo_action(target.get_name(), "bribe")) {
-        throw UndoNotAllowed(role(), "undo_bribe");
-    }
-    if (game->undo_bribe) {
-        throw InvalidActionException("Bribe already undone this round.");
-    }
-    if (target.get_name() == name) {
-        throw CannotTargetYourselfException("undo bribe");        
-    }
-
-    game->perform_action("undo_bribe", name, target.get_name());
-    game->cancel_last_action(target.get_name());
-    game->next_turn();
-    game->undo_bribe = true;
+    COUP_TRACE_SPAN("Judge::undo_bribe");
+    act(StatAction::UndoBribe, &target, [&] {
+        game->perform_action("undo_bribe", player_id, target.id());
+        game->cancel_last_action(target.id());
+        game->next_turn();
+        game->mark_used(Game::RoundAbility::UndoBribe);
+    });
 }
 
 } // namespace coup
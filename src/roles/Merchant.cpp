@@ -24,14 +24,20 @@ std::string Merchant::role() const {
 }
 
 /**
- * @brief At the start of the Merchant's turn, gains 1 bonus coin if they have at least 3 coins.
+ * @brief At the start of the Merchant's turn, gains RulesConfig::merchant_bonus coins if they hold at
+ * least merchant_bonus_at (1 coin from 3 by default).
  * 
  * This is a passive ability specific to the Merchant role.
  */
 void Merchant::on_turn_start() {
-    if (coins() >= 3) {
-        set_coins(coins() + 1);
-        std::cout << "[Merchant] " << name << " gained 1 bonus coin at start of turn. Total: " << coins() << std::endl;
+    const int bonus = game->with_rules([this](const auto &rules) {
+        return coin_count >= rules.merchant_bonus_at ? rules.merchant_bonus : 0;
+    });
+    if (bonus > 0) {
+        set_coins(coins() + bonus);
+        if (game->logging()) {
+            std::cout << "[Merchant] " << name << " gained " << bonus << " bonus coin at start of turn. Total: " << coins() << std::endl;
+        }
     }
 }
 
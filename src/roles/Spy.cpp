@@ -3,6 +3,7 @@
 #include "Spy.hpp"
 #include "Game.hpp"
 #include "Exceptions.hpp"
+#include "Trace.hpp"
 #include <iostream>
 
 namespace coup {
@@ -23,6 +24,32 @@ std::string Spy::role() const {
     return "Spy";
 }
 
+/**
+ * @brief Checks peek_and_disable: a live target other than the Spy, whose arrest is not
+ * blocked yet, and no peek this round.
+ */
+Refusal Spy::check(StatAction action, const Player *target) const {
+    if (action != StatAction::PeekAndDisable)
+        return Player::check(action, target);
+    if (!target)
+        return {Rejection::PlayerNotFound};
+    if (!target->is_active())
+        return {Rejection::PlayerAlreadyDead, "", target};
+    if (game->used_this_round(Game::RoundAbility::PeekDisable))
+        return {Rejection::InvalidAction, "You can only use peek_and_disable once per round."};
+    if (target->get_name() == name)
+        return {Rejection::CannotTargetYourself, "peek_and_disable"};
+    if (!game->get_player_by_id(target->id()))
+        return {Rejection::PlayerNotFound, "", target};
+    if (target->is_arrest_disabled())
+        return {Rejection::InvalidAction, "Arrest is already blocked for this player."};
+    if (Refusal r = check_active())
+        return r;
+    if (!game->get_player_by_id(player_id))
+        return {Rejection::PlayerNotFound};
+    return {};
+}
+
 /**
  * @brief Allows the Spy to peek at a target’s coins and role, and block their ability to arrest.
  * 
@@ -35,32 +62,25 @@ std::string Spy::role() const {
  * @throws CannotTargetYourselfException if targeting self.
  */
 void Spy::peek_and_disable(Player& target) {
-    if (!target.is_active()) {
-        throw PlayerAlreadyDeadException(target.get_name());
-    }
-    if (game->peek_disable == true) {
-        throw InvalidActionException("You can only use peek_and_disable once per round.");
-    }
-    if (target.get_name() == name) {
-        throw CannotTargetYourselfException("peek_and_disable");
-    }
-
-    peeked_coins = target.coins();
-    peeked_role = target.role();
-    peeked_name = target.get_name();
-
-    std::cout << "[Spy] " << name << " peeked at " << target.get_name() 
-              << "'s coins: " << peeked_coins 
-              << " and role: " << peeked_role << std::endl;
+    COUP_TRACE_SPAN("Spy::peek_and_disable");
+    act(StatAction::PeekAndDisable, &target, [&] {
+        peeked_coins = target.coins();
+        peeked_role = target.role();
+        peeked_name = target.get_name();
 
-    if (game->is_arrest_blocked(target.get_name())) {
-        throw InvalidActionException("Arrest is already blocked for this player.");
-    }
+        if (game->logging()) {
+            std::cout << "[Spy] " << name << " peeked at " << target.get_name() 
+                      << "'s coins: " << peeked_coins 
+                      << " and role: " << peeked_role << std::endl;
+        }
 
-    game->block_arrest_for(target.get_name());
-    std::cout << "[Spy] " << name << " has disabled arrest for " << target.get_name() << std::endl;
-    game->perform_action("peek_and_disable", name, target.get_name());
-    game->peek_disable = true;
+        game->block_arrest_for(target.id());
+        if (game->logging()) {
+            std::cout << "[Spy] " << name << " has disabled arrest for " << target.get_name() << std::endl;
+        }
+        game->perform_action("peek_and_disable", player_id, target.id());
+        game->mark_used(Game::RoundAbility::PeekDisable);
+    });
 }
 
 } // namespace coup
@@ -0,0 +1,216 @@
+// test_alloc.cpp - Heap allocations of steady-state turns
+// Anksilae@gmail.com
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define ALLOC_COUNTER_IMPLEMENT
+#include "doctest.h"
+#include "AllocCounter.hpp"
+#include "Game.hpp"
+#include "GameArena.hpp"
+#include "Governor.hpp"
+#include "Spy.hpp"
+#include "Judge.hpp"
+#include "Baron.hpp"
+#include "General.hpp"
+#include "Merchant.hpp"
+#include "Exceptions.hpp"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coup;
+
+// Adds Player0 (Governor) ... Player5 (Merchant).
+static std::vector<Player *> seat_players(Game &g) {
+    const char *roles[] = {"Governor", "Spy", "Judge", "Baron", "General", "Merchant"};
+    std::vector<Player *> players;
+    for (int i = 0; i < 6; ++i)
+        players.push_back(g.add_player("Player" + std::to_string(i), roles[i]));
+    return players;
+}
+
+// Runs setup + action once to warm up per-player buffers, then returns the allocations
+// of a second action from the same setup.
+template <typename Setup, typename Action>
+static uint64_t steady_allocations(Setup setup, Action action) {
+    setup();
+    action();
+    setup();
+    return count_allocations(action);
+}
+
+// Next active player after `self` (wrapping).
+static Player *next_active(const std::vector<Player *> &players, size_t self) {
+    for (size_t k = 1; k < players.size(); ++k) {
+        Player *p = players[(self + k) % players.size()];
+        if (p->is_active())
+            return p;
+    }
+    return nullptr;
+}
+
+// Plays one turn of a fixed policy that only chooses legal moves (so nothing throws).
+static void scripted_turn(Game &g, const std::vector<Player *> &players, int turn) {
+    size_t index = static_cast<size_t>(g.get_current_turn_index());
+    Player &me = *players[index];
+    Player &target = *next_active(players, index);
+
+    if (me.coins() >= 7)
+        me.coup(target);
+    else if (turn % 4 == 1 && target.coins() >= 2 && !me.is_arrest_disabled() && !g.arrested_same_target(target.get_name()))
+        me.arrest(target);
+    else if (turn % 4 == 2 && me.coins() >= 4)
+        me.sanction(target);
+    else if (me.role() == "Baron" && me.coins() >= 3)
+        static_cast<Baron &>(me).invest();
+    else if (me.is_sanctioned())
+        me.skip_turn();
+    else if (turn % 2 == 0)
+        me.tax();
+    else
+        me.gather();
+}
+
+TEST_CASE("AllocScope counts the calling thread's allocations") {
+    AllocScope scope;
+    auto v = std::make_unique<std::vector<int>>(100);
+    CHECK(scope.allocations() == 2);
+
+    std::thread other([] { std::vector<int> w(100); });
+    other.join();
+    CHECK(scope.allocations() <= 3); // the thread's state may be allocated here, its vector is not
+
+    v.reset();
+    CHECK(scope.deallocations() >= 2);
+}
+
+TEST_CASE("Turn actions do not allocate in steady state") {
+    Game g;
+    auto p = seat_players(g);
+    auto at_turn = [&](int index, int coins) {
+        g.set_current_turn_index(index);
+        p[index]->set_coins(coins);
+    };
+
+    CHECK(steady_allocations([&] { at_turn(0, 0); }, [&] { g.next_turn(); }) == 0);
+    CHECK(steady_allocations([&] { at_turn(1, 0); }, [&] { p[1]->gather(); }) == 0);
+    CHECK(steady_allocations([&] { at_turn(1, 0); }, [&] { p[1]->tax(); }) == 0);
+    CHECK(steady_allocations([&] { at_turn(0, 0); }, [&] { p[0]->tax(); }) == 0);
+    CHECK(steady_allocations([&] { at_turn(1, 4); }, [&] { p[1]->bribe(); }) == 0);
+    CHECK(steady_allocations([&] { at_turn(1, 0); }, [&] { p[1]->skip_turn(); }) == 0);
+    CHECK(steady_allocations(
+              [&] {
+                  at_turn(1, 0);
+                  p[2]->set_coins(1);
+                  g.set_last_arrest_target("");
+              },
+              [&] { p[1]->arrest(*p[2]); }) == 0);
+    CHECK(steady_allocations(
+              [&] {
+                  at_turn(1, 3);
+                  p[3]->unsanction();
+              },
+              [&] { p[1]->sanction(*p[3]); }) == 0);
+    CHECK(steady_allocations(
+              [&] {
+                  if (g.is_coup_pending_on("Player5"))
+                      g.cancel_coup("Player5");
+                  at_turn(1, 7);
+              },
+              [&] { p[1]->coup(*p[5]); }) == 0);
+}
+
+TEST_CASE("Role abilities do not allocate in steady state") {
+    Game g;
+    auto p = seat_players(g);
+
+    CHECK(steady_allocations(
+              [&] {
+                  g.perform_action("tax", "Player1");
+                  p[1]->set_coins(2);
+                  g.clear_used(Game::RoundAbility::UndoTax);
+              },
+              [&] { static_cast<Governor &>(*p[0]).undo_tax(*p[1]); }) == 0);
+    CHECK(steady_allocations(
+              [&] {
+                  g.set_current_turn_index(1);
+                  p[3]->enable_arrest();
+                  g.clear_used(Game::RoundAbility::PeekDisable);
+              },
+              [&] { static_cast<Spy &>(*p[1]).peek_and_disable(*p[3]); }) == 0);
+    CHECK(steady_allocations(
+              [&] {
+                  g.set_current_turn_index(2);
+                  g.perform_action("bribe", "Player1");
+                  g.clear_used(Game::RoundAbility::UndoBribe);
+              },
+              [&] { static_cast<Judge &>(*p[2]).undo_bribe(*p[1]); }) == 0);
+    CHECK(steady_allocations(
+              [&] {
+                  g.set_current_turn_index(3);
+                  p[3]->set_coins(3);
+              },
+              [&] { static_cast<Baron &>(*p[3]).invest(); }) == 0);
+    CHECK(steady_allocations(
+              [&] {
+                  g.remove_player("Player5");
+                  g.add_to_coup("Player1", "Player5");
+                  p[4]->set_coins(5);
+                  g.clear_used(Game::RoundAbility::UndoCoup);
+              },
+              [&] { static_cast<General &>(*p[4]).undo_coup(*p[5]); }) == 0);
+    CHECK(steady_allocations([&] { p[5]->set_coins(3); }, [&] { p[5]->on_turn_start(); }) == 0);
+}
+
+TEST_CASE("Full games do not allocate after the first round") {
+    for (int game = 0; game < 3; ++game) {
+        CAPTURE(game);
+        Game g;
+        auto p = seat_players(g);
+        p[game]->set_coins(game); // vary the course of the game
+
+        int turn = 0;
+        for (; turn < 6; ++turn) // first round: every player acts once
+            scripted_turn(g, p, turn);
+
+        uint64_t allocations = 0;
+        for (; !g.is_game_over() && turn < 1000; ++turn)
+            allocations += count_allocations([&] { scripted_turn(g, p, turn); });
+
+        CHECK(g.is_game_over());
+        CHECK(allocations == 0);
+    }
+}
+
+TEST_CASE("Arena-backed games are set up and torn down without the heap") {
+    const char *roles[] = {"Governor", "Spy", "Judge", "Baron", "General", "Merchant"};
+    GameArena arena;
+    auto play_short_game = [&] {
+        Game g(arena);
+        for (int round = 0; round < 2; ++round) {
+            for (int i = 0; i < 6; ++i)
+                g.add_player("Player" + std::to_string(i), roles[i]);
+            g.get_player_by_name("Player0")->tax();
+            g.reset();
+        }
+    };
+
+    play_short_game(); // warm-up
+    CHECK(count_allocations(play_short_game) == 0);
+    CHECK_FALSE(arena.in_use());
+}
+
+TEST_CASE("Arena-backed players are laid out by seat and reused after reset") {
+    GameArena arena;
+    Game g(arena);
+    CHECK(arena.in_use());
+    CHECK_THROWS_AS(Game{arena}, InvalidActionException);
+
+    const char *first = reinterpret_cast<const char *>(g.add_player("A", "Spy"));
+    const char *second = reinterpret_cast<const char *>(g.add_player("B", "Judge"));
+    CHECK(static_cast<size_t>(second - first) == sizeof(RoleSlot)); // stored by value, side by side
+
+    g.reset();
+    CHECK(reinterpret_cast<const char *>(g.add_player("A", "Spy")) == first);
+}
@@ -0,0 +1,111 @@
+// test_batch.cpp - Batched simulation against the rules engine
+// Anksilae@gmail.com
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "BatchSim.hpp"
+#include "Exceptions.hpp"
+#include <string>
+#include <vector>
+
+using namespace coup;
+
+static const std::vector<std::string> ALL_ROLES = {"Governor", "Spy", "Judge", "Baron", "General", "Merchant"};
+
+// Checks that every game of run() matches play_scalar() on the same seed.
+static void check_matches_engine(const BatchSim &sim, uint32_t first_seed, size_t games) {
+    auto batch = sim.run(first_seed, games);
+    REQUIRE(batch.size() == games);
+    for (size_t i = 0; i < games; ++i) {
+        BatchOutcome scalar = sim.play_scalar(first_seed + static_cast<uint32_t>(i));
+        INFO("game " << i);
+        CHECK(batch[i].winner == scalar.winner);
+        CHECK(batch[i].turns == scalar.turns);
+        CHECK(batch[i].coins == scalar.coins);
+    }
+}
+
+TEST_CASE("batched games match the rules engine") {
+    SUBCASE("one of each role, default policy") {
+        check_matches_engine(BatchSim(ALL_ROLES), 1, 120);
+    }
+    SUBCASE("Merchants and Barons only") {
+        check_matches_engine(BatchSim({"Merchant", "Baron", "Merchant", "Baron"}), 500, 80);
+    }
+    SUBCASE("two players") {
+        check_matches_engine(BatchSim({"Governor", "Merchant"}), 900, 60);
+    }
+    SUBCASE("full table with forced coups") {
+        std::vector<std::string> roles;
+        for (size_t s = 0; s < BatchSim::MAX_SEATS; ++s)
+            roles.push_back(ALL_ROLES[s % ALL_ROLES.size()]);
+        BatchPolicy policy;
+        policy.coup_at = 10;
+        policy.tax_weight = 3;
+        policy.invest_weight = 16;
+        check_matches_engine(BatchSim(roles, policy), 7, 40);
+    }
+    SUBCASE("non-default rules") {
+        RulesConfig rules;
+        rules.gather_income = 2;
+        rules.tax_income = 3;
+        rules.governor_tax = 5;
+        rules.coup_cost = 6;
+        rules.forced_coup_at = 12;
+        rules.invest_cost = 4;
+        rules.invest_return = 9;
+        rules.merchant_bonus_at = 2;
+        rules.merchant_bonus = 2;
+        BatchPolicy policy;
+        policy.coup_at = 9;
+        check_matches_engine(BatchSim(ALL_ROLES, policy, 16, rules), 300, 80);
+    }
+    SUBCASE("games stopped at max_turns") {
+        BatchPolicy policy;
+        policy.max_turns = 13;
+        BatchSim sim(ALL_ROLES, policy);
+        auto outcomes = sim.run(40, 30);
+        for (const auto &o : outcomes) {
+            CHECK(o.winner == -1);
+            CHECK(o.turns == 13);
+        }
+        check_matches_engine(sim, 40, 30);
+    }
+}
+
+TEST_CASE("batch results do not depend on how many games run side by side") {
+    BatchSim narrow(ALL_ROLES, {}, 1);
+    BatchSim wide(ALL_ROLES, {}, 1000);
+    auto a = narrow.run(77, 300);
+    auto b = wide.run(77, 300);
+    REQUIRE(a.size() == b.size());
+    for (size_t i = 0; i < a.size(); ++i)
+        CHECK(a[i] == b[i]);
+
+    // A later slice of the seeds gives the same games
+    auto tail = wide.run(77 + 250, 50);
+    for (size_t i = 0; i < tail.size(); ++i)
+        CHECK(tail[i] == a[250 + i]);
+}
+
+TEST_CASE("batch outcomes are complete games") {
+    BatchSim sim(ALL_ROLES);
+    auto outcomes = sim.run(3, 500);
+    for (const auto &o : outcomes) {
+        REQUIRE(o.winner >= 0);
+        CHECK(o.winner < 6);
+        CHECK(o.turns > 0);
+        for (int c : o.coins)
+            CHECK(c >= 0);
+    }
+    CHECK(sim.run(3, 0).empty());
+}
+
+TEST_CASE("BatchSim rejects bad tables") {
+    CHECK_THROWS_AS(BatchSim({"Governor"}), InvalidActionException);
+    CHECK_THROWS_AS(BatchSim({"Governor", "Jester"}), InvalidActionException);
+    CHECK_THROWS_AS(BatchSim(std::vector<std::string>(BatchSim::MAX_SEATS + 1, "Spy")), InvalidActionException);
+    RulesConfig rules;
+    rules.coup_cost = 11;
+    CHECK_THROWS_AS(BatchSim(ALL_ROLES, {}, 8, rules), InvalidActionException);
+}
@@ -0,0 +1,117 @@
+// test_bot.cpp - Bot policies
+// Anksilae@gmail.com
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "Game.hpp"
+#include "Bot.hpp"
+#include "Baron.hpp"
+#include "Exceptions.hpp"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace coup;
+
+// Plays bots against each other until the game ends; returns the number of turns played.
+static int play_out(Game &g, std::vector<std::unique_ptr<Bot>> &bots, const std::vector<std::string> &names) {
+    int turns = 0;
+    while (!g.is_game_over() && turns < 2000) {
+        std::string current = g.turn();
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == current) {
+                bots[i]->play_turn(g, current);
+                break;
+            }
+        }
+        ++turns;
+    }
+    return turns;
+}
+
+TEST_CASE("Bot candidates follow the basic rules") {
+    Game g;
+    auto a = g.add_player("A", "Baron");
+    g.add_player("B", "Merchant");
+
+    SUBCASE("no coins") {
+        auto moves = Bot::candidates(g, *a);
+        bool has_coup = false, has_arrest = false, has_invest = false;
+        for (const auto &m : moves) {
+            has_coup |= m.type == BotMove::Type::Coup;
+            has_arrest |= m.type == BotMove::Type::Arrest;
+            has_invest |= m.type == BotMove::Type::Invest;
+        }
+        CHECK_FALSE(has_coup);
+        CHECK_FALSE(has_arrest);
+        CHECK_FALSE(has_invest);
+    }
+
+    SUBCASE("forced coup leaves only coups") {
+        a->set_coins(10);
+        auto moves = Bot::candidates(g, *a);
+        REQUIRE(moves.size() == 1);
+        CHECK(moves[0].type == BotMove::Type::Coup);
+        CHECK(moves[0].target == "B");
+        CHECK(moves[0].describe() == "coup B");
+    }
+}
+
+TEST_CASE("Greedy bot coups when it can") {
+    Game g;
+    auto a = g.add_player("A", "Spy");
+    g.add_player("B", "Judge");
+    g.add_player("C", "Governor");
+    g.get_player_by_name("C")->set_coins(5);
+    a->set_coins(7);
+
+    Bot bot(BotStrength::Greedy, 1);
+    BotMove m = bot.choose(g, *a);
+    CHECK(m.type == BotMove::Type::Coup);
+    CHECK(m.target == "C"); // richest opponent
+}
+
+TEST_CASE("Bot play_turn refuses to play out of turn") {
+    Game g;
+    g.add_player("A", "Spy");
+    g.add_player("B", "Judge");
+    Bot bot(BotStrength::Random, 3);
+    CHECK_THROWS_AS(bot.play_turn(g, "B"), NotYourTurnException);
+}
+
+TEST_CASE("Bots of every strength finish full games") {
+    const BotStrength strengths[] = {BotStrength::Random, BotStrength::Greedy, BotStrength::Search};
+    const std::vector<std::string> roles = {"Governor", "Spy", "Judge", "Baron", "General", "Merchant"};
+
+    for (BotStrength strength : strengths) {
+        CAPTURE(to_string(strength));
+        Game g;
+        std::vector<std::unique_ptr<Bot>> bots;
+        std::vector<std::string> names;
+        for (size_t i = 0; i < roles.size(); ++i) {
+            names.push_back("P" + std::to_string(i));
+            g.add_player(names.back(), roles[i]);
+            bots.push_back(std::make_unique<Bot>(strength, static_cast<unsigned>(i + 1), 2));
+        }
+
+        int turns = play_out(g, bots, names);
+        CHECK(g.is_game_over());
+        CHECK(turns < 2000);
+        CHECK(g.players().size() == 1);
+    }
+}
+
+TEST_CASE("Search bot respects its time budget") {
+    Game g;
+    auto a = g.add_player("A", "Baron");
+    g.add_player("B", "General");
+    a->set_coins(4);
+
+    Bot bot(BotStrength::Search, 7, 20);
+    auto start = std::chrono::steady_clock::now();
+    bot.choose(g, *a);
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    CHECK(ms >= 20);
+    CHECK(ms < 1000);
+}
@@ -0,0 +1,183 @@
+// test_driver.cpp - Resumable game tasks and their action sources
+// Anksilae@gmail.com
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "Exceptions.hpp"
+#include "Game.hpp"
+#include "TurnDriver.hpp"
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace coup;
+
+namespace {
+
+const char *const ROLES[] = {"Governor", "Spy", "Baron", "General", "Judge", "Merchant"};
+
+/**
+ * @brief A game of `seats` players with one seeded bot source per seat.
+ */
+struct BotTable {
+    Game game;
+    std::vector<std::unique_ptr<BotSource>> bots;
+    std::vector<ActionSource *> sources;
+
+    BotTable(size_t seats, unsigned seed, WorkerPool *pool = nullptr) {
+        for (size_t s = 0; s < seats; ++s) {
+            game.add_player("P" + std::to_string(s), ROLES[(seed + s) % 6]);
+            bots.push_back(std::make_unique<BotSource>(Bot(BotStrength::Greedy, seed * 31 + s), pool));
+            sources.push_back(bots.back().get());
+        }
+    }
+};
+
+} // namespace
+
+TEST_CASE("TurnAction text form") {
+    CHECK(TurnAction::parse("tax").kind == TurnAction::Kind::Tax);
+    TurnAction coup = TurnAction::parse("coup bob");
+    CHECK(coup.kind == TurnAction::Kind::Coup);
+    CHECK(coup.target == "bob");
+    CHECK(coup.describe() == "coup bob");
+    CHECK(TurnAction::parse("skip").describe() == "skip");
+
+    CHECK_THROWS_AS(TurnAction::parse("coup"), InvalidActionException);
+    CHECK_THROWS_AS(TurnAction::parse("tax bob"), InvalidActionException);
+    CHECK_THROWS_AS(TurnAction::parse("arrest a b"), InvalidActionException);
+    CHECK_THROWS_AS(TurnAction::parse("steal bob"), InvalidActionException);
+
+    CHECK(TurnAction::from(BotMove{BotMove::Type::Arrest, "x"}) == TurnAction{TurnAction::Kind::Arrest, "x"});
+}
+
+TEST_CASE("apply_action goes through the Player API") {
+    Game g;
+    Player *a = g.add_player("A", "Merchant");
+    Player *b = g.add_player("B", "Baron");
+    apply_action(g, *a, TurnAction::parse("tax"));
+    CHECK(a->coins() == 2);
+    CHECK_THROWS_AS(apply_action(g, *b, TurnAction::parse("coup A")), NotEnoughCoinsException);
+    CHECK_THROWS_AS(apply_action(g, *b, TurnAction::parse("arrest nobody")), PlayerNotFoundException);
+    CHECK_THROWS_AS(apply_action(g, *a, TurnAction::parse("invest")), InvalidActionException);
+    b->set_coins(3);
+    apply_action(g, *b, TurnAction::parse("invest"));
+    CHECK(b->coins() == 6);
+}
+
+TEST_CASE("a task plays bots to the end") {
+    BotTable table(4, 7);
+    GameTask task(table.game, table.sources);
+    std::cout.setstate(std::ios::badbit);
+    CHECK(task.resume() == GameTask::Status::Finished);
+    std::cout.clear();
+    CHECK(table.game.is_game_over());
+    CHECK(task.actions() > 0);
+    CHECK(task.error().empty());
+}
+
+TEST_CASE("a manual seat waits for its action") {
+    Game g;
+    g.add_player("Human", "Merchant");
+    Player *other = g.add_player("Other", "Spy");
+    ManualSource human;
+    ReplaySource replay({"gather", "# comment", "", "tax"});
+    GameTask task(g, {&human, &replay});
+
+    CHECK(task.resume() == GameTask::Status::Waiting);
+    CHECK(human.waiting());
+    CHECK(task.resume() == GameTask::Status::Waiting); // nothing changed
+
+    // A rejected action is reported and asked for again
+    human.submit(TurnAction::parse("coup Other"));
+    CHECK(task.resume() == GameTask::Status::Waiting);
+    CHECK_FALSE(human.last_error().empty());
+    CHECK(human.waiting());
+
+    human.submit(TurnAction::parse("tax"));
+    CHECK(task.resume() == GameTask::Status::Waiting); // Other gathered, the human is asked again
+    CHECK(task.actions() == 2);
+    CHECK(other->coins() == 1);
+
+    ManualSource idle;
+    CHECK_THROWS_AS(idle.submit(TurnAction::parse("tax")), InvalidActionException);
+}
+
+TEST_CASE("a replay fails when it is rejected or runs out") {
+    Game g;
+    g.add_player("A", "Merchant");
+    g.add_player("B", "Spy");
+    std::istringstream in("tax\narrest A\n");
+    ReplaySource a = ReplaySource::from_stream(in);
+    ReplaySource b({"coup A"});
+    GameTask task(g, {&a, &b});
+    CHECK(task.resume() == GameTask::Status::Failed);
+    CHECK(task.error().find("coup A") != std::string::npos);
+
+    Game h;
+    h.add_player("A", "Merchant");
+    h.add_player("B", "Spy");
+    ReplaySource short_a({"tax"});
+    ReplaySource short_b({});
+    GameTask ran_out(h, {&short_a, &short_b});
+    CHECK(ran_out.resume() == GameTask::Status::Failed);
+    CHECK(ran_out.error().find("no more actions") != std::string::npos);
+}
+
+TEST_CASE("one executor runs many games fed by a thread pool") {
+    constexpr size_t GAMES = 200;
+    WorkerPool pool(3);
+    std::vector<std::unique_ptr<BotTable>> tables;
+    std::vector<std::unique_ptr<GameTask>> tasks;
+    TurnExecutor executor;
+    for (size_t i = 0; i < GAMES; ++i) {
+        tables.push_back(std::make_unique<BotTable>(2 + i % 5, static_cast<unsigned>(i), &pool));
+        tasks.push_back(std::make_unique<GameTask>(tables.back()->game, tables.back()->sources));
+        executor.spawn(*tasks.back());
+    }
+    CHECK(executor.active() == GAMES);
+
+    std::cout.setstate(std::ios::badbit);
+    executor.run();
+    std::cout.clear();
+    CHECK(executor.active() == 0);
+
+    // Seeded bots play the same games whether they think inline or on the pool
+    for (size_t i = 0; i < GAMES; i += 37) {
+        CHECK(tasks[i]->status() == GameTask::Status::Finished);
+        BotTable inline_table(2 + i % 5, static_cast<unsigned>(i));
+        GameTask inline_task(inline_table.game, inline_table.sources);
+        std::cout.setstate(std::ios::badbit);
+        inline_task.resume();
+        std::cout.clear();
+        CHECK(inline_task.actions() == tasks[i]->actions());
+        CHECK(inline_table.game.is_game_over() == tables[i]->game.is_game_over());
+        if (inline_table.game.is_game_over())
+            CHECK(inline_table.game.winner() == tables[i]->game.winner());
+    }
+}
+
+TEST_CASE("the executor resumes a task when its manual action arrives") {
+    Game g;
+    g.add_player("Human", "Merchant");
+    g.add_player("Bot", "Spy");
+    ManualSource human;
+    BotSource bot(Bot(BotStrength::Random, 3));
+    GameTask task(g, {&human, &bot}, 3);
+    TurnExecutor executor;
+    executor.spawn(task);
+
+    CHECK(executor.run_ready() == 1);
+    CHECK(task.status() == GameTask::Status::Waiting);
+    CHECK(executor.run_ready() == 0); // nothing to do until the action arrives
+
+    human.submit(TurnAction::parse("gather"));
+    CHECK(executor.run_ready() == 1);
+    CHECK(task.actions() == 2);
+    human.submit(TurnAction::parse("gather"));
+    executor.run();
+    CHECK(task.status() == GameTask::Status::Finished);
+    CHECK(task.actions() == 3);
+}
@@ -0,0 +1,160 @@
+// test_engine.cpp - GameEngine, command queue and snapshot buffering
+// Anksilae@gmail.com
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "Game.hpp"
+#include "GameEngine.hpp"
+#include "SpscQueue.hpp"
+#include "TripleBuffer.hpp"
+#include "Exceptions.hpp"
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace coup;
+
+// Waits (bounded) for the next command result from the engine thread.
+static CommandResult wait_result(GameEngine &engine) {
+    CommandResult r;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!engine.poll_result(r)) {
+        REQUIRE(std::chrono::steady_clock::now() < deadline);
+        std::this_thread::yield();
+    }
+    return r;
+}
+
+TEST_CASE("SpscQueue push/pop order and capacity") {
+    SpscQueue<int, 4> q;
+    int out = 0;
+    CHECK(q.empty());
+    CHECK_FALSE(q.try_pop(out));
+
+    for (int i = 1; i <= 4; ++i) {
+        int v = i;
+        CHECK(q.try_push(v));
+    }
+    int extra = 5;
+    CHECK_FALSE(q.try_push(extra));
+
+    for (int i = 1; i <= 4; ++i) {
+        CHECK(q.try_pop(out));
+        CHECK(out == i);
+    }
+    CHECK(q.empty());
+}
+
+TEST_CASE("SpscQueue across threads keeps every item in order") {
+    SpscQueue<int, 8> q;
+    const int n = 10000;
+    std::thread producer([&q] {
+        for (int i = 0; i < n; ++i) {
+            int v = i;
+            while (!q.try_push(v)) std::this_thread::yield();
+        }
+    });
+
+    int expected = 0;
+    int out = 0;
+    while (expected < n) {
+        if (q.try_pop(out)) {
+            REQUIRE(out == expected);
+            ++expected;
+        }
+    }
+    producer.join();
+    CHECK(q.empty());
+}
+
+TEST_CASE("TripleBuffer returns the latest published value") {
+    TripleBuffer<int> buf;
+    buf.back() = 1;
+    buf.publish();
+    CHECK(buf.acquire() == 1);
+    CHECK(buf.acquire() == 1); // unchanged without a new publish
+
+    buf.back() = 2;
+    buf.publish();
+    buf.back() = 3;
+    buf.publish();
+    CHECK(buf.acquire() == 3); // intermediate values may be skipped
+}
+
+TEST_CASE("GameEngine executes commands and publishes snapshots") {
+    Game g;
+    GameEngine engine(g);
+
+    const GameSnapshot &initial = engine.snapshot();
+    CHECK(initial.players.empty());
+    CHECK(initial.current == -1);
+
+    uint64_t a = engine.submit([](Game &game) { game.add_player("Alice", "Governor"); });
+    uint64_t b = engine.submit([](Game &game) { game.add_player("Bob", "Spy"); });
+    CHECK(wait_result(engine).id == a);
+    CommandResult rb = wait_result(engine);
+    CHECK(rb.id == b);
+    CHECK(rb.ok);
+
+    const GameSnapshot &snap = engine.snapshot();
+    REQUIRE(snap.players.size() == 2);
+    CHECK(snap.players[0].name == "Alice");
+    CHECK(snap.players[0].role == "Governor");
+    CHECK(snap.players[1].role == "Spy");
+    CHECK(snap.alive_count() == 2);
+    REQUIRE(snap.current_player() != nullptr);
+    CHECK(snap.current_player()->name == "Alice");
+    CHECK(snap.find("Carol") == nullptr);
+
+    engine.submit([](Game &game) { game.get_player_by_name("Alice")->tax(); });
+    CommandResult tax = wait_result(engine);
+    CHECK(tax.ok);
+    CHECK(tax.message.find("[tax]") != std::string::npos);
+
+    const GameSnapshot &after = engine.snapshot();
+    CHECK(after.version > snap.version);
+    CHECK(after.find("Alice")->coins == 3);
+    CHECK(after.find("Alice")->last_action == "tax");
+    CHECK(after.find("Alice")->can_still_undo);
+    CHECK(after.current_player()->name == "Bob");
+}
+
+TEST_CASE("GameEngine reports failed commands without changing state") {
+    Game g;
+    GameEngine engine(g);
+    engine.submit([](Game &game) {
+        game.add_player("Alice", "Baron");
+        game.add_player("Bob", "Judge");
+    });
+    CHECK(wait_result(engine).ok);
+
+    engine.submit([](Game &game) { game.get_player_by_name("Bob")->gather(); });
+    CommandResult r = wait_result(engine);
+    CHECK_FALSE(r.ok);
+    CHECK(r.message == NotYourTurnException().what());
+
+    const GameSnapshot &snap = engine.snapshot();
+    CHECK(snap.find("Bob")->coins == 0);
+    CHECK(snap.current_player()->name == "Alice");
+}
+
+TEST_CASE("GameEngine snapshot shows winner after game over") {
+    Game g;
+    GameEngine engine(g);
+    engine.submit([](Game &game) {
+        auto a = game.add_player("Alice", "General");
+        auto b = game.add_player("Bob", "Merchant");
+        a->set_coins(7);
+        a->coup(*b);
+    });
+    CHECK(wait_result(engine).ok);
+
+    const GameSnapshot &snap = engine.snapshot();
+    CHECK(snap.game_over);
+    CHECK(snap.winner == "Alice");
+    REQUIRE(snap.coup_pending_list.size() == 1);
+    CHECK(snap.coup_pending_list[0].second == "Bob");
+
+    engine.stop();
+    engine.stop(); // idempotent
+}
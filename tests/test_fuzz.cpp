@@ -0,0 +1,122 @@
+// test_fuzz.cpp - Invariant checks and the action fuzzer's byte encoding
+// Anksilae@gmail.com
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "ActionFuzzer.hpp"
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace coup;
+
+namespace {
+
+/**
+ * @brief Silences the game log for one test case (doctest reports on std::cout).
+ */
+struct QuietLog {
+    QuietLog() { std::cout.setstate(std::ios::badbit); }
+    ~QuietLog() { std::cout.clear(); }
+};
+
+} // namespace
+
+TEST_CASE("a fresh game keeps the invariants") {
+    QuietLog quiet;
+    Game game;
+    game.add_player("a", "Governor");
+    game.add_player("b", "Spy");
+    CHECK(check_invariants(game) == "");
+}
+
+TEST_CASE("a pending coup on a live player is reported") {
+    QuietLog quiet;
+    Game game;
+    game.add_player("a", "General");
+    game.add_player("b", "Judge");
+    game.add_to_coup("a", "b");
+    CHECK(check_invariants(game).find("b, who is alive") != std::string::npos);
+}
+
+TEST_CASE("the first byte picks the players, the next ones their roles") {
+    QuietLog quiet;
+    ActionFuzzer fuzzer;
+    std::string broken;
+    const uint8_t input[] = {1, 0, 2, 3}; // 3 players: Governor, Baron, General
+    FuzzStats stats = fuzzer.run(input, sizeof(input), broken);
+    CHECK(broken == "");
+    CHECK(stats.steps == 0);
+    REQUIRE(fuzzer.game().get_all_players_raw().size() == 3);
+    CHECK(fuzzer.game().get_all_players_raw()[0]->role() == "Governor");
+    CHECK(fuzzer.game().get_all_players_raw()[1]->role() == "Baron");
+    CHECK(fuzzer.game().get_all_players_raw()[2]->role() == "General");
+}
+
+TEST_CASE("steps check() refuses are skipped unless asked for") {
+    ActionFuzzer fuzzer;
+    std::string broken;
+
+    // two players, gather then a coup with 1 coin: refused and not played
+    const uint8_t skipped[] = {0, 0, 1, 0x00, 0x00, 0x06, 0x00};
+    FuzzStats stats = fuzzer.run(skipped, sizeof(skipped), broken);
+    CHECK(broken == "");
+    CHECK(stats.steps == 2);
+    CHECK(stats.rejected == 1);
+    CHECK(fuzzer.game().get_all_players_raw()[1]->is_active());
+
+    // the same coup with bits 5-7 of its target set: played, and it must throw
+    const uint8_t played[] = {0, 0, 1, 0x00, 0x00, 0x06, 0xE0};
+    stats = fuzzer.run(played, sizeof(played), broken);
+    CHECK(broken == "");
+    CHECK(stats.steps == 2);
+    CHECK(stats.rejected == 1);
+}
+
+TEST_CASE("the fuzzer's game does not print its log") {
+    std::ostringstream captured;
+    std::streambuf *previous = std::cout.rdbuf(captured.rdbuf());
+    ActionFuzzer fuzzer;
+    std::string broken;
+    const uint8_t input[] = {0, 0, 1, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00};
+    fuzzer.run(input, sizeof(input), broken);
+    std::cout.rdbuf(previous);
+    CHECK(broken == "");
+    CHECK(captured.str() == "");
+}
+
+TEST_CASE("empty and one-byte inputs decode to games") {
+    QuietLog quiet;
+    ActionFuzzer fuzzer;
+    std::string broken;
+    FuzzStats stats = fuzzer.run(nullptr, 0, broken);
+    CHECK(broken == "");
+    CHECK(stats.steps == 0);
+
+    const uint8_t one[] = {0xff};
+    stats = fuzzer.run(one, sizeof(one), broken);
+    CHECK(broken == "");
+    CHECK(fuzzer.game().get_all_players_raw().size() >= 2);
+}
+
+TEST_CASE("random inputs keep every invariant") {
+    QuietLog quiet;
+    ActionFuzzer fuzzer;
+    std::mt19937 rng(5);
+    std::vector<uint8_t> input;
+    std::string broken;
+    size_t steps = 0, finished = 0;
+    for (int i = 0; i < 2000; ++i) {
+        input.resize(1 + rng() % 512);
+        for (uint8_t &byte : input)
+            byte = static_cast<uint8_t>(rng());
+        FuzzStats stats = fuzzer.run(input.data(), input.size(), broken);
+        REQUIRE_MESSAGE(broken == "", "input " << i);
+        CHECK(stats.rejected <= stats.steps);
+        steps += stats.steps;
+        finished += stats.finished;
+    }
+    CHECK(steps > 0);
+    CHECK(finished > 0);
+}
@@ -54,6 +54,144 @@ TEST_CASE("get_all_players_raw") {
     CHECK(all[0]->get_name() == "A");
 }
 
+TEST_CASE("players created by role stay in place as more are added") {
+    Game g;
+    Player *first = g.add_player("P0", "Governor");
+    auto custom = std::make_shared<DummyPlayer>(g, "Custom");
+    g.add_player(custom);
+    for (size_t i = 1; i + 1 < MAX_PLAYERS; ++i)
+        g.add_player("P" + std::to_string(i), "Merchant");
+
+    const auto &all = g.get_all_players_raw();
+    CHECK(all.size() == MAX_PLAYERS);
+    CHECK(all[0] == first);
+    CHECK(all[1] == custom.get());
+    CHECK(g.get_player_by_name("P0") == first);
+    CHECK(first->role() == "Governor");
+    CHECK(all.back()->role() == "Merchant");
+
+    CHECK_THROWS_AS(g.add_player("Extra", "Spy"), InvalidActionException);
+    CHECK_THROWS_AS(g.add_player(std::make_shared<DummyPlayer>(g, "Extra")), InvalidActionException);
+    CHECK(all.size() == MAX_PLAYERS);
+}
+
+TEST_CASE("names are interned once and bookkeeping is keyed by id") {
+    Game g;
+    CHECK(g.id_of("A") == NO_PLAYER);
+    auto a = g.add_player("A", "Spy");
+    auto b = g.add_player("B", "Judge");
+    CHECK(a->id() != b->id());
+    CHECK(g.id_of("A") == a->id());
+    CHECK(g.name_of(b->id()) == "B");
+
+    g.perform_action("tax", a->id());
+    CHECK(g.last_action_of(a->id()) == "tax");
+    CHECK(g.can_undo_action("A", "tax"));
+    CHECK(g.last_action_of(b->id()).empty());
+
+    g.add_to_coup(a->id(), b->id());
+    CHECK(g.is_coup_pending_on("B"));
+    CHECK(g.get_coup_pending_list().at(0).first == "A");
+}
+
+TEST_CASE("names that are not players are rejected without taking a seat") {
+    Game g;
+    for (size_t i = 0; i + 1 < MAX_PLAYERS; ++i)
+        g.add_player("P" + std::to_string(i), "Spy");
+    CHECK_THROWS_AS(g.add_to_coup("Someone", "P0"), PlayerNotFoundException);
+    CHECK_THROWS_AS(g.add_to_coup("P0", "Someone"), PlayerNotFoundException);
+    CHECK_THROWS_AS(g.set_last_arrest_target("Nobody"), PlayerNotFoundException);
+    CHECK(g.id_of("Someone") == NO_PLAYER);
+    CHECK(g.id_of("Nobody") == NO_PLAYER);
+    CHECK_FALSE(g.is_coup_pending_on("P0"));
+
+    auto last = g.add_player("Last", "Baron");
+    CHECK(last->id() == MAX_PLAYERS - 1);
+    CHECK_THROWS_AS(g.set_last_arrest_target("Nobody"), PlayerNotFoundException);
+    g.set_last_arrest_target("Last");
+    CHECK(g.arrested_same_target("Last"));
+}
+
+TEST_CASE("a target has one pending coup and cancelling it leaves the others") {
+    Game g;
+    auto a = g.add_player("A", "General");
+    auto b = g.add_player("B", "Spy");
+    auto c = g.add_player("C", "Judge");
+    g.add_to_coup(a->id(), b->id());
+    g.add_to_coup(a->id(), c->id());
+    g.add_to_coup(c->id(), b->id()); // replaces A's coup on B
+
+    auto pending = g.get_coup_pending_list();
+    REQUIRE(pending.size() == 2);
+    CHECK(pending[0] == std::make_pair(std::string("C"), std::string("B")));
+    CHECK(pending[1] == std::make_pair(std::string("A"), std::string("C")));
+
+    g.cancel_coup("B");
+    CHECK_FALSE(g.is_coup_pending_on("B"));
+    CHECK(g.is_coup_pending_on("C"));
+    CHECK(g.get_coup_attackers()[c->id()] == a->id());
+}
+
+TEST_CASE("action names are stored inline up to a fixed length") {
+    Game g;
+    g.add_player("A", "Spy");
+    g.perform_action(std::string(ActionName::CAPACITY, 'x'), "A");
+    CHECK(g.can_undo_action("A", std::string(ActionName::CAPACITY, 'x')));
+    CHECK_THROWS_AS(g.perform_action(std::string(ActionName::CAPACITY + 1, 'x'), "A"), InvalidActionException);
+}
+
+TEST_CASE("SeatFlags bit queries") {
+    uint64_t mask = SeatFlags::bit(1) | SeatFlags::bit(4) | SeatFlags::bit(63);
+    CHECK(SeatFlags::count(mask) == 3);
+    CHECK(SeatFlags::first(mask) == 1);
+    CHECK(SeatFlags::next_after(mask, 1) == 4);
+    CHECK(SeatFlags::next_after(mask, 4) == 63);
+    CHECK(SeatFlags::next_after(mask, 63) == 1);
+    CHECK(SeatFlags::next_after(SeatFlags::bit(2), 2) == 2);
+    CHECK(SeatFlags::next_after(0, 0) == -1);
+}
+
+TEST_CASE("player flags live in the game's seat masks") {
+    Game g;
+    auto a = g.add_player("A", "Spy");
+    auto b = g.add_player("B", "Judge");
+    auto c = g.add_player("C", "Baron");
+    CHECK(g.alive_count() == 3);
+    CHECK(g.flags().active == 0b111);
+
+    b->on_sanction();
+    c->disable_arrest();
+    CHECK(g.flags().sanctioned == SeatFlags::bit(b->seat()));
+    CHECK(g.flags().arrest_disabled == SeatFlags::bit(c->seat()));
+
+    g.remove_player("B");
+    CHECK(g.alive_count() == 2);
+    CHECK(g.next_active_seat(a->seat()) == static_cast<int>(c->seat()));
+    CHECK(g.next_active_seat(c->seat()) == static_cast<int>(a->seat()));
+    g.next_turn();
+    CHECK(g.turn() == "C");
+}
+
+TEST_CASE("flags set before a player is added move into its seat") {
+    Game g;
+    g.add_player("A", "Spy");
+    auto p = std::make_shared<DummyPlayer>(g, "B");
+    CHECK(p->seat() == Player::NO_SEAT);
+    p->on_sanction();
+    p->disable_arrest();
+    CHECK(p->is_active());
+    g.add_player(p);
+    CHECK(p->seat() == 1);
+    CHECK(p->is_sanctioned());
+    CHECK(p->is_arrest_disabled());
+    CHECK(g.flags().sanctioned == SeatFlags::bit(1));
+
+    g.reset(); // the game lets go of the player, which keeps its flags
+    CHECK(p->seat() == Player::NO_SEAT);
+    CHECK(p->is_sanctioned());
+    CHECK(p->is_active());
+}
+
 TEST_CASE("get_last_actions") {
     Game g;
     auto p1 = std::make_shared<DummyPlayer>(g, "A");
@@ -296,6 +434,7 @@ TEST_CASE("reset") {
     auto p = std::make_shared<DummyPlayer>(g, "Z");
     g.add_player(p);
     g.block_arrest_for("Z");
+    g.add_player(std::make_shared<DummyPlayer>(g, "Q"));
     g.set_last_arrest_target("Z");
     g.add_to_coup("Z", "Q");
     g.perform_action("tax", "Z");
@@ -330,3 +469,162 @@ TEST_CASE("next_turn resets sanction/arrest") {
     CHECK_FALSE(b->is_sanctioned());
     CHECK_FALSE(b->is_arrest_disabled());
 }
+
+TEST_CASE("RulesConfig names, validation and equality") {
+    RulesConfig rules;
+    CHECK(rules.coup_cost == 7);
+    CHECK(rules.forced_coup_at == 10);
+    CHECK(RulesConfig::fields().size() == 13);
+    for (const auto &name : RulesConfig::fields())
+        CHECK_NOTHROW(rules.get(name));
+
+    rules.set("bribe_cost", 6);
+    CHECK(rules.bribe_cost == 6);
+    CHECK(rules.get("bribe_cost") == 6);
+    CHECK(rules != RulesConfig());
+    CHECK_THROWS_AS(rules.set("no_such_rule", 1), InvalidActionException);
+
+    CHECK_NOTHROW(rules.validate());
+    rules.sanction_cost = -1;
+    CHECK_THROWS_AS(rules.validate(), InvalidActionException);
+    CHECK_THROWS_AS(Game g(rules), InvalidActionException);
+
+    RulesConfig unpayable;
+    unpayable.coup_cost = 12;
+    CHECK_THROWS_AS(unpayable.validate(), InvalidActionException);
+}
+
+TEST_CASE("players pay the costs of the game's rules") {
+    RulesConfig rules;
+    rules.gather_income = 2;
+    rules.tax_income = 4;
+    rules.bribe_cost = 1;
+    rules.sanction_cost = 2;
+    rules.judge_sanction_extra = 3;
+    rules.coup_cost = 5;
+    rules.forced_coup_at = 8;
+    Game g(rules);
+    CHECK(g.rules() == rules);
+
+    Player *a = g.add_player("A", "Spy");
+    Player *b = g.add_player("B", "Judge");
+
+    a->gather();
+    CHECK(a->coins() == 2);
+    b->tax();
+    CHECK(b->coins() == 4);
+
+    a->bribe();
+    CHECK(a->coins() == 1);
+    a->set_coins(4);
+    CHECK_THROWS_AS(a->sanction(*b), NotEnoughCoinsException); // 2 + 3 against a Judge
+    a->set_coins(5);
+    a->sanction(*b);
+    CHECK(a->coins() == 0);
+
+    b->set_coins(8);
+    CHECK_THROWS_AS(b->bribe(), MustCoupWith10CoinsException); // forced from 8 on
+    b->coup(*a);
+    CHECK(b->coins() == 3);
+}
+
+TEST_CASE("reset keeps the game's rules") {
+    RulesConfig rules;
+    rules.coup_cost = 3;
+    Game g(rules);
+    g.add_player("A", "Spy");
+    g.reset();
+    CHECK(g.rules().coup_cost == 3);
+}
+
+namespace {
+constexpr RulesConfig CHEAP_COUP = [] {
+    RulesConfig r;
+    r.coup_cost = 5;
+    r.forced_coup_at = 8;
+    return r;
+}();
+} // namespace
+
+TEST_CASE("FixedRules fold a RulesConfig into constants") {
+    static_assert(StandardRules::coup_cost == 7 && StandardRules::forced_coup_at == 10, "standard coup");
+    static_assert(StandardRules::governor_tax == 3 && StandardRules::bribe_cost == 4, "standard costs");
+    static_assert(FixedRules<CHEAP_COUP>::coup_cost == 5, "custom coup cost");
+    static_assert(FixedRules<CHEAP_COUP>::tax_income == 2, "untouched values keep the defaults");
+    CHECK(StandardRules::config() == RulesConfig());
+    CHECK(FixedRules<CHEAP_COUP>::config() == CHEAP_COUP);
+}
+
+TEST_CASE("games on the standard rules take the specialized path") {
+    Game standard;
+    CHECK(standard.has_standard_rules());
+    CHECK(standard.with_rules([](const auto &rules) { return rules.coup_cost; }) == 7);
+
+    RulesConfig rules;
+    rules.coup_cost = 6;
+    Game custom(rules);
+    CHECK_FALSE(custom.has_standard_rules());
+    CHECK(custom.with_rules([](const auto &rules) { return rules.coup_cost; }) == 6);
+
+    // Both paths play the same actions
+    for (Game *g : {&standard, &custom}) {
+        Player *a = g->add_player("A", "Governor");
+        Player *b = g->add_player("B", "Spy");
+        a->tax();
+        CHECK(a->coins() == 3);
+        b->set_coins(10);
+        CHECK_THROWS_AS(b->gather(), MustCoupWith10CoinsException);
+        b->coup(*a);
+        CHECK(b->coins() == 10 - g->rules().coup_cost);
+        CHECK(g->winner() == "B");
+    }
+}
+
+TEST_CASE("rounds advance when the turn wraps, even with the last seat eliminated") {
+    Game g;
+    for (const char *name : {"A", "B", "C"})
+        g.add_player(std::make_shared<DummyPlayer>(g, name));
+    CHECK(g.round() == 1);
+
+    g.mark_used(Game::RoundAbility::UndoTax);
+    g.next_turn(); // B
+    g.next_turn(); // C
+    CHECK(g.used_this_round(Game::RoundAbility::UndoTax));
+    g.next_turn(); // A: round 2
+    CHECK(g.round() == 2);
+    CHECK_FALSE(g.used_this_round(Game::RoundAbility::UndoTax));
+
+    // With C out, rounds wrap from B back to A
+    g.mark_used(Game::RoundAbility::UndoCoup);
+    g.remove_player("C");
+    g.next_turn(); // B
+    CHECK(g.used_this_round(Game::RoundAbility::UndoCoup));
+    g.next_turn(); // A
+    CHECK(g.round() == 3);
+    CHECK_FALSE(g.used_this_round(Game::RoundAbility::UndoCoup));
+
+    g.mark_used(Game::RoundAbility::PeekDisable);
+    g.clear_used(Game::RoundAbility::PeekDisable);
+    CHECK_FALSE(g.used_this_round(Game::RoundAbility::PeekDisable));
+
+    g.reset();
+    CHECK(g.round() == 1);
+}
+
+TEST_CASE("an action can be undone until its player's next turn") {
+    Game g;
+    for (const char *name : {"A", "B", "C", "D"})
+        g.add_player(std::make_shared<DummyPlayer>(g, name));
+    g.perform_action("tax", "A");
+    g.next_turn(); // B
+    g.remove_player("C");
+    g.next_turn(); // D
+    CHECK(g.can_still_undo("A"));
+    g.next_turn(); // A
+    CHECK_FALSE(g.can_still_undo("A"));
+
+    // Actions in the player's own turn are undoable again
+    g.perform_action("gather", "A");
+    CHECK(g.can_still_undo("A"));
+    CHECK_FALSE(g.can_still_undo("B"));
+}
@@ -0,0 +1,239 @@
+// test_reaction.cpp - Reaction windows for out-of-turn abilities
+// Anksilae@gmail.com
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "Exceptions.hpp"
+#include "Game.hpp"
+#include "ReactionScheduler.hpp"
+#include <memory>
+#include <vector>
+
+using namespace coup;
+using Clock = ReactionScheduler::Clock;
+
+TEST_CASE("a Governor undoes a tax in the reaction window") {
+    Game g;
+    Player *gov = g.add_player("Gov", "Governor");
+    Player *baron = g.add_player("Baron", "Baron");
+    g.add_player("Judge", "Judge");
+    g.next_turn();
+    baron->tax();
+    CHECK(baron->coins() == 2);
+
+    ReactionScheduler reactions;
+    const auto now = Clock::now();
+    uint64_t w = reactions.open(g, baron->id(), now);
+    REQUIRE(w != ReactionScheduler::NO_WINDOW);
+    REQUIRE(reactions.offers(w).size() == 1);
+    CHECK(reactions.offers(w)[0].responder == gov->id());
+    CHECK(reactions.offers(w)[0].kind == ReactionKind::UndoTax);
+    CHECK(reactions.offers(w)[0].target == baron->id());
+    CHECK(reactions.has_open_window(g));
+
+    // Nothing happens until the Governor answers
+    std::vector<ResolvedWindow> resolved;
+    CHECK(reactions.poll(resolved, now) == 0);
+    CHECK(reactions.is_open(w));
+
+    reactions.react(w, gov->id(), ReactionKind::UndoTax);
+    CHECK_THROWS_AS(reactions.react(w, gov->id(), ReactionKind::UndoTax), InvalidActionException);
+    CHECK(reactions.poll(resolved, now) == 1);
+    REQUIRE(resolved[0].outcomes.size() == 1);
+    CHECK(resolved[0].action == "tax");
+    CHECK(resolved[0].outcomes[0].applied);
+    CHECK(baron->coins() == 0);
+    CHECK_FALSE(reactions.is_open(w));
+    CHECK_FALSE(reactions.has_open_window(g));
+    CHECK(reactions.offers(w).empty());
+    CHECK_THROWS_AS(reactions.pass(w, gov->id()), InvalidActionException);
+}
+
+TEST_CASE("unanswered offers pass at the deadline") {
+    Game g;
+    g.add_player("Gov", "Governor");
+    Player *baron = g.add_player("Baron", "Baron");
+    g.next_turn();
+    baron->tax();
+
+    ReactionScheduler reactions(std::chrono::seconds(2));
+    const auto now = Clock::now();
+    uint64_t w = reactions.open(g, baron->id(), now);
+    std::vector<ResolvedWindow> resolved;
+    CHECK(reactions.poll(resolved, now + std::chrono::seconds(1)) == 0);
+    CHECK(reactions.poll(resolved, now + std::chrono::seconds(2)) == 1);
+    CHECK(resolved[0].id == w);
+    CHECK_FALSE(resolved[0].outcomes[0].answered);
+    CHECK_FALSE(resolved[0].outcomes[0].applied);
+    CHECK(baron->coins() == 2);
+}
+
+TEST_CASE("nobody eligible opens no window") {
+    Game g;
+    Player *a = g.add_player("A", "Baron");
+    g.add_player("B", "Merchant");
+    a->gather();
+
+    ReactionScheduler reactions;
+    CHECK(reactions.open(g, a->id()) == ReactionScheduler::NO_WINDOW);
+    CHECK(reactions.open_windows() == 0);
+}
+
+TEST_CASE("bots answer as soon as the window is polled") {
+    Game g;
+    Player *briber = g.add_player("Briber", "Baron");
+    Player *judge = g.add_player("Judge", "Judge");
+    briber->set_coins(4);
+    briber->bribe();
+
+    ReactionScheduler reactions;
+    int asked = 0;
+    reactions.set_bot(g, judge->id(), [&](const Game &, const ReactionOffer &offer) {
+        ++asked;
+        CHECK(offer.kind == ReactionKind::UndoBribe);
+        return offer.target;
+    });
+    reactions.open(g, briber->id());
+
+    std::vector<ResolvedWindow> resolved;
+    CHECK(reactions.poll(resolved) == 1);
+    CHECK(asked == 1);
+    CHECK(resolved[0].outcomes[0].applied);
+    CHECK(g.used_this_round(Game::RoundAbility::UndoBribe));
+    CHECK(g.turn() == "Judge"); // the undone bribe ends the briber's turn
+}
+
+TEST_CASE("windows answered only by bots queue no deadline") {
+    constexpr size_t GAMES = 1000;
+    std::vector<std::unique_ptr<Game>> games;
+    ReactionScheduler reactions(std::chrono::seconds(5));
+    const auto pass = [](const Game &, const ReactionOffer &) { return NO_PLAYER; };
+    const auto now = Clock::now();
+    for (size_t i = 0; i < GAMES; ++i) {
+        games.push_back(std::make_unique<Game>());
+        Game &g = *games.back();
+        Player *gov = g.add_player("Gov", "Governor");
+        Player *taxer = g.add_player("Taxer", "Merchant");
+        reactions.set_bot(g, gov->id(), pass);
+        g.next_turn();
+        taxer->tax();
+        reactions.open(g, taxer->id(), now);
+    }
+    CHECK(reactions.queued_deadlines() == 0);
+    std::vector<ResolvedWindow> resolved;
+    CHECK(reactions.poll(resolved, now) == GAMES);
+    CHECK(reactions.queued_deadlines() == 0);
+
+    // A bot dropped before the first poll leaves its player the regular deadline
+    Game &g = *games[0];
+    Player *taxer = g.get_player_by_name("Taxer");
+    g.next_turn();
+    taxer->tax();
+    reactions.open(g, taxer->id(), now);
+    reactions.set_bot(g, g.id_of("Gov"), nullptr);
+    CHECK(reactions.poll(resolved, now) == 0);
+    CHECK(reactions.queued_deadlines() == 1);
+    CHECK(reactions.poll(resolved, now + std::chrono::seconds(5)) == 1);
+    CHECK_FALSE(resolved.back().outcomes[0].answered);
+}
+
+TEST_CASE("reactions resolve in priority order") {
+    Game g;
+    Player *spy = g.add_player("Spy", "Spy");
+    Player *general = g.add_player("General", "General");
+    Player *attacker = g.add_player("Attacker", "Baron");
+    Player *victim = g.add_player("Victim", "Merchant");
+    g.next_turn();
+    g.next_turn();
+    attacker->set_coins(7);
+    general->set_coins(5);
+    attacker->coup(*victim);
+    CHECK_FALSE(victim->is_active());
+
+    ReactionScheduler reactions;
+    uint64_t w = reactions.open(g, attacker->id());
+    REQUIRE(reactions.offers(w).size() == 2);
+    CHECK(reactions.offers(w)[0].kind == ReactionKind::PeekAndDisable); // seat order after the attacker
+    CHECK(reactions.offers(w)[1].kind == ReactionKind::UndoCoup);
+    CHECK(reactions.offers(w)[1].target == victim->id());
+
+    CHECK_THROWS_AS(reactions.react(w, spy->id(), ReactionKind::PeekAndDisable), InvalidActionException);
+    CHECK_THROWS_AS(reactions.react(w, spy->id(), ReactionKind::UndoTax), InvalidActionException);
+    reactions.react(w, spy->id(), ReactionKind::PeekAndDisable, attacker->id());
+    reactions.react(w, general->id(), ReactionKind::UndoCoup);
+
+    std::vector<ResolvedWindow> resolved;
+    REQUIRE(reactions.poll(resolved) == 1);
+    const auto &outcomes = resolved[0].outcomes;
+    REQUIRE(outcomes.size() == 2);
+    CHECK(outcomes[0].offer.kind == ReactionKind::UndoCoup);
+    CHECK(outcomes[0].applied);
+    CHECK(outcomes[1].offer.kind == ReactionKind::PeekAndDisable);
+    CHECK(outcomes[1].applied);
+    CHECK(victim->is_active());
+    CHECK(general->coins() == 0);
+    CHECK(attacker->is_arrest_disabled());
+}
+
+TEST_CASE("a rejected reaction is reported and the rest still apply") {
+    Game g;
+    Player *gov = g.add_player("Gov", "Governor");
+    Player *taxer = g.add_player("Taxer", "Baron");
+    Player *spy = g.add_player("Spy", "Spy");
+    g.next_turn();
+    taxer->tax();
+    taxer->set_coins(1); // too few coins to give the tax back
+
+    ReactionScheduler reactions;
+    uint64_t w = reactions.open(g, taxer->id());
+    reactions.react(w, gov->id(), ReactionKind::UndoTax);
+    reactions.react(w, spy->id(), ReactionKind::PeekAndDisable, gov->id());
+    std::vector<ResolvedWindow> resolved;
+    REQUIRE(reactions.poll(resolved) == 1);
+    CHECK_FALSE(resolved[0].outcomes[0].applied);
+    CHECK_FALSE(resolved[0].outcomes[0].error.empty());
+    CHECK(resolved[0].outcomes[1].applied);
+    CHECK(gov->is_arrest_disabled());
+}
+
+TEST_CASE("one scheduler keeps many games' windows open") {
+    constexpr size_t GAMES = 1000;
+    std::vector<std::unique_ptr<Game>> games;
+    ReactionScheduler reactions;
+    const auto now = Clock::now();
+    std::vector<uint64_t> windows;
+    for (size_t i = 0; i < GAMES; ++i) {
+        games.push_back(std::make_unique<Game>());
+        Game &g = *games.back();
+        g.add_player("Gov", "Governor");
+        Player *taxer = g.add_player("Taxer", "Spy");
+        g.next_turn();
+        taxer->tax();
+        windows.push_back(reactions.open(g, taxer->id(), now));
+    }
+    CHECK(reactions.open_windows() == GAMES);
+
+    // Every other game answers; the rest run into the deadline
+    for (size_t i = 0; i < GAMES; i += 2)
+        reactions.pass(windows[i], games[i]->id_of("Gov"));
+    std::vector<ResolvedWindow> resolved;
+    CHECK(reactions.poll(resolved, now) == GAMES / 2);
+    CHECK(reactions.open_windows() == GAMES / 2);
+    CHECK(reactions.has_open_window(*games[1]));
+    CHECK_FALSE(reactions.has_open_window(*games[0]));
+
+    reactions.forget(*games[1]);
+    CHECK_FALSE(reactions.is_open(windows[1]));
+    CHECK(reactions.poll(resolved, now + std::chrono::minutes(1)) == GAMES / 2 - 1);
+    CHECK(reactions.open_windows() == 0);
+
+    // Slots are reused without confusing old ids
+    Game &g = *games[0];
+    Player *taxer = g.get_player_by_name("Taxer");
+    g.next_turn();
+    taxer->tax();
+    uint64_t again = reactions.open(g, taxer->id(), now);
+    CHECK(again != windows[0]);
+    CHECK(reactions.is_open(again));
+    CHECK_FALSE(reactions.is_open(windows[0]));
+}
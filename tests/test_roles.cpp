@@ -45,7 +45,7 @@ TEST_CASE("Governor functionality and edge cases") {
     g.next_turn(); // reset undo flag
     gov2->set_coins(1);
     g.perform_action("tax", gov2->get_name());
-    g.undo_tax = true; // simulate already undone
+    g.mark_used(Game::RoundAbility::UndoTax); // simulate already undone
     CHECK_THROWS_AS(gov->undo_tax(*gov2), InvalidActionException);
 }
 TEST_CASE("Governor::undo_tax throws when targeting self") {
@@ -146,7 +146,7 @@ TEST_CASE("General coup block and arrest compensation") {
     g.add_player(gen);
     g.add_player(victim);
 
-    g.add_to_coup("Someone", victim->get_name());
+    g.add_to_coup(gen->get_name(), victim->get_name());
     gen->set_coins(5);
     CHECK_NOTHROW(gen->undo_coup(*victim));
     CHECK_FALSE(g.is_coup_pending_on(victim->get_name()));
@@ -162,12 +162,12 @@ TEST_CASE("General::undo_coup throws if already undone this round") {
     g.add_player(gen);
     g.add_player(victim);
 
-    g.add_to_coup("Someone", victim->get_name());
+    g.add_to_coup(gen->get_name(), victim->get_name());
     gen->set_coins(5);
     CHECK_NOTHROW(gen->undo_coup(*victim));
 
-    g.add_to_coup("Someone", victim->get_name());
-    g.undo_coup = true; // סימולציה של undo קודם
+    g.add_to_coup(gen->get_name(), victim->get_name());
+    g.mark_used(Game::RoundAbility::UndoCoup); // סימולציה של undo קודם
     gen->set_coins(5);
     CHECK_THROWS_AS(gen->undo_coup(*victim), InvalidActionException);
 }
@@ -179,7 +179,7 @@ TEST_CASE("General::undo_coup throws if not enough coins") {
     auto victim = std::make_shared<Spy>(g, "Victim");
     g.add_player(general);
     g.add_player(victim);
-    g.add_to_coup("Someone", victim->get_name());
+    g.add_to_coup(general->get_name(), victim->get_name());
     general->set_coins(4);
     CHECK_THROWS_AS(general->undo_coup(*victim), NotEnoughCoinsException);
 }
@@ -354,3 +354,43 @@ TEST_CASE("Spy::peek_and_disable does not change turn") {
     CHECK(before == after);
 }
 
+
+TEST_CASE("Role abilities use the game's rules") {
+    RulesConfig rules;
+    rules.governor_tax = 5;
+    rules.tax_income = 1;
+    rules.invest_cost = 2;
+    rules.invest_return = 7;
+    rules.general_undo_cost = 1;
+    rules.merchant_bonus_at = 1;
+    rules.merchant_bonus = 2;
+    Game g(rules);
+    auto *gov = static_cast<Governor *>(g.add_player("Gov", "Governor"));
+    auto *baron = static_cast<Baron *>(g.add_player("Baron", "Baron"));
+    auto *general = static_cast<General *>(g.add_player("Gen", "General"));
+    auto *merchant = static_cast<Merchant *>(g.add_player("Merch", "Merchant"));
+
+    gov->tax();
+    CHECK(gov->coins() == 5);
+
+    baron->tax();
+    CHECK(baron->coins() == 1);
+    CHECK_NOTHROW(gov->undo_tax(*baron)); // gives back tax_income
+    CHECK(baron->coins() == 0);
+
+    force_turn(g, "Baron");
+    baron->set_coins(2);
+    baron->invest();
+    CHECK(baron->coins() == 7);
+
+    merchant->set_coins(1);
+    merchant->on_turn_start();
+    CHECK(merchant->coins() == 3);
+
+    general->set_coins(1);
+    g.remove_player("Merch");
+    g.add_to_coup("Gov", "Merch");
+    general->undo_coup(*merchant);
+    CHECK(general->coins() == 0);
+    CHECK(merchant->is_active());
+}
@@ -0,0 +1,125 @@
+// test_script.cpp - Headless games played from the line protocol
+// Anksilae@gmail.com
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "Exceptions.hpp"
+#include "ScriptRunner.hpp"
+#include <iostream>
+#include <sstream>
+
+using namespace coup;
+
+namespace {
+
+/**
+ * @brief Silences the game log for one test case (doctest reports on std::cout).
+ */
+struct QuietLog {
+    QuietLog() { std::cout.setstate(std::ios::badbit); }
+    ~QuietLog() { std::cout.clear(); }
+};
+
+const char *const SHORT_GAME = R"(
+# two players race to a coup
+add a Governor
+add b Merchant
+
+tax a
+gather b
+tax a
+gather b
+expect coins a 6
+tax a
+gather b
+expect turn a
+coup a b
+expect dead b
+expect winner a
+)";
+
+} // namespace
+
+TEST_CASE("a script plays a game to its end") {
+    QuietLog quiet;
+    ScriptRunner runner;
+    ScriptResult r = runner.run_script(SHORT_GAME);
+    CHECK(r.ok());
+    CHECK(r.commands == 13);
+    CHECK(r.winner == "a");
+    CHECK(runner.game().is_game_over());
+}
+
+TEST_CASE("the first rejected command stops a script") {
+    QuietLog quiet;
+    ScriptRunner runner;
+    ScriptResult r = runner.run_script("add a Spy\nadd b Judge\n\ngather b\ngather a\n");
+    CHECK_FALSE(r.ok());
+    CHECK(r.commands == 3);
+    CHECK(r.error_line == 4);
+    CHECK(r.error.find("not your turn") != std::string::npos);
+
+    r = runner.run_script("add a Spy\nadd b Judge\nexpect coins a 3\n");
+    CHECK(r.error == "Invalid action: Expected coins a 3, but a has 0 coins.");
+}
+
+TEST_CASE("malformed commands are rejected") {
+    QuietLog quiet;
+    ScriptRunner runner;
+    runner.execute("add a Baron");
+    runner.execute("add b General");
+    CHECK_THROWS_AS(runner.execute("add c"), InvalidActionException);
+    CHECK_THROWS_AS(runner.execute("add c Jester"), InvalidActionException);
+    CHECK_THROWS_AS(runner.execute("dance a"), InvalidActionException);
+    CHECK_THROWS_AS(runner.execute("coup a"), InvalidActionException);
+    CHECK_THROWS_AS(runner.execute("tax a b"), InvalidActionException);
+    CHECK_THROWS_AS(runner.execute("tax zed"), PlayerNotFoundException);
+    CHECK_THROWS_AS(runner.execute("undo_tax b a"), InvalidActionException); // b is not a Governor
+    CHECK_THROWS_AS(runner.execute("expect mood a"), InvalidActionException);
+    CHECK_THROWS_AS(runner.execute("new game"), InvalidActionException);
+    runner.execute("expect turn a");
+}
+
+TEST_CASE("out-of-turn abilities") {
+    QuietLog quiet;
+    ScriptRunner runner;
+    ScriptResult r = runner.run_script(R"(
+add gov Governor
+add spy Spy
+add judge Judge
+tax gov
+tax spy
+undo_tax gov spy
+expect coins spy 0
+peek spy gov
+gather judge
+arrest gov judge
+)");
+    CHECK(r.error_line == 11);
+    CHECK(r.error.find("blocked from using arrest") != std::string::npos);
+}
+
+TEST_CASE("the stdin protocol answers every command and reads on after errors") {
+    QuietLog quiet;
+    ScriptRunner runner;
+    std::ostringstream replies;
+    runner.set_reply(&replies);
+    std::istringstream in("add a Spy\nadd b Judge\ngather b\ngather a\nshow\n");
+    ScriptResult r = runner.run(in, false);
+    CHECK(r.commands == 5);
+    CHECK(r.errors == 1);
+    CHECK(replies.str() == "ok\nok\nerror: It's not your turn.\nok\n"
+                           "turn b\nplayer a Spy 1 alive\nplayer b Judge 0 alive\nok\n");
+}
+
+TEST_CASE("one runner replays many scripts back-to-back") {
+    QuietLog quiet;
+    ScriptRunner runner;
+    for (int i = 0; i < 200; ++i) {
+        ScriptResult r = runner.run_script(SHORT_GAME);
+        REQUIRE(r.ok());
+        CHECK(r.winner == "a");
+    }
+    runner.execute("new");
+    CHECK(runner.game().get_all_players_raw().empty());
+}
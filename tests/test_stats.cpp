@@ -0,0 +1,180 @@
+// test_stats.cpp - Per-thread game statistics and their dumps
+// Anksilae@gmail.com
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "Exceptions.hpp"
+#include "Game.hpp"
+#include "GameStats.hpp"
+#include "General.hpp"
+#include "Governor.hpp"
+#include "ReactionScheduler.hpp"
+#include "Spy.hpp"
+#include "TurnDriver.hpp"
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace coup;
+
+namespace {
+
+size_t role(const char *name) {
+    return GameStatsSnapshot::role_slot(name);
+}
+
+} // namespace
+
+TEST_CASE("rejections map to the exception hierarchy") {
+    CHECK(classify_rejection(NotYourTurnException()) == Rejection::NotYourTurn);
+    CHECK(classify_rejection(NotEnoughCoinsException(7, 2)) == Rejection::NotEnoughCoins);
+    CHECK(classify_rejection(InvalidActionException("x")) == Rejection::InvalidAction);
+    CHECK(classify_rejection(std::runtime_error("x")) == Rejection::Other);
+    CHECK(stat_action_from_name("Skip Turn") == StatAction::Skip);
+    CHECK(stat_action_from_name("peek_and_disable") == StatAction::PeekAndDisable);
+    CHECK(stat_action_from_name("dance") == StatAction::Count);
+    CHECK(std::string(to_string(Rejection::MustCoup)) == "must_coup");
+}
+
+TEST_CASE("actions are counted by role and outcome") {
+    GameStats::reset();
+    Game g;
+    Player *gov = g.add_player("Gov", "Governor");
+    Player *merchant = g.add_player("Merchant", "Merchant");
+    apply_action(g, *gov, TurnAction::parse("tax"));
+    CHECK_THROWS_AS(apply_action(g, *merchant, TurnAction::parse("coup Gov")), NotEnoughCoinsException);
+    CHECK_THROWS_AS(apply_action(g, *gov, TurnAction::parse("gather")), NotYourTurnException);
+    merchant->gather();
+    CHECK_THROWS_AS(static_cast<Governor *>(gov)->undo_tax(*gov), CannotTargetYourselfException);
+
+    GameStatsSnapshot s = GameStats::snapshot();
+    CHECK(s.actions[size_t(StatAction::Tax)][role("Governor")][size_t(StatOutcome::Ok)] == 1);
+    CHECK(s.actions[size_t(StatAction::Gather)][role("Merchant")][size_t(StatOutcome::Ok)] == 1);
+    CHECK(s.actions[size_t(StatAction::Coup)][role("Merchant")][size_t(StatOutcome::Rejected)] == 1);
+    CHECK(s.rejections[size_t(StatAction::Coup)][size_t(Rejection::NotEnoughCoins)] == 1);
+    CHECK(s.rejections[size_t(StatAction::Gather)][size_t(Rejection::NotYourTurn)] == 1);
+    CHECK(s.count(StatAction::Gather, StatOutcome::Rejected) == 1);
+    CHECK(s.count(StatAction::UndoTax, StatOutcome::Ok) == 0);
+    CHECK(s.actions[size_t(StatAction::UndoTax)][role("Governor")][size_t(StatOutcome::Rejected)] == 1);
+    CHECK(s.rejections[size_t(StatAction::UndoTax)][size_t(Rejection::CannotTargetYourself)] == 1);
+}
+
+TEST_CASE("actions called directly are counted like those of apply_action") {
+    GameStats::reset();
+    Game g;
+    Player *gov = g.add_player("Gov", "Governor");
+    Player *spy = g.add_player("Spy", "Spy");
+    CHECK_THROWS_AS(spy->gather(), NotYourTurnException);
+    gov->tax();
+    CHECK_THROWS_AS(static_cast<Spy *>(spy)->peek_and_disable(*spy), CannotTargetYourselfException);
+    static_cast<Spy *>(spy)->peek_and_disable(*gov);
+    CHECK_THROWS_AS(static_cast<Governor *>(gov)->undo_tax(*spy), UndoNotAllowed);
+
+    GameStatsSnapshot s = GameStats::snapshot();
+    CHECK(s.count(StatAction::Gather, StatOutcome::Rejected) == 1);
+    CHECK(s.count(StatAction::Tax, StatOutcome::Ok) == 1);
+    CHECK(s.count(StatAction::PeekAndDisable, StatOutcome::Ok) == 1);
+    CHECK(s.count(StatAction::PeekAndDisable, StatOutcome::Rejected) == 1);
+    CHECK(s.rejections[size_t(StatAction::PeekAndDisable)][size_t(Rejection::CannotTargetYourself)] == 1);
+    CHECK(s.rejections[size_t(StatAction::UndoTax)][size_t(Rejection::UndoNotAllowed)] == 1);
+}
+
+TEST_CASE("reactions, eliminations and finished games are counted") {
+    GameStats::reset();
+    Game g;
+    Player *gov = g.add_player("Gov", "Governor");
+    Player *a = g.add_player("A", "Baron");
+    Player *b = g.add_player("B", "Spy");
+    g.next_turn();
+    a->tax();
+
+    ReactionScheduler reactions;
+    uint64_t w = reactions.open(g, a->id());
+    reactions.react(w, gov->id(), ReactionKind::UndoTax);
+    reactions.pass(w, b->id());
+    std::vector<ResolvedWindow> resolved;
+    reactions.poll(resolved);
+
+    b->set_coins(9);
+    b->coup(*gov);
+    a->set_coins(7);
+    a->coup(*b);
+
+    GameStatsSnapshot s = GameStats::snapshot();
+    CHECK(s.count(StatAction::UndoTax, StatOutcome::Ok) == 1);
+    CHECK(s.count(StatAction::Coup, StatOutcome::Ok) == 2);
+    CHECK(s.eliminations() == 2);
+    CHECK(s.elimination_coins[0] == 1);   // the Governor had nothing left
+    CHECK(s.elimination_coins[2] == 1);   // B kept 2 after its coup
+    CHECK(s.elimination_coins_sum == 2);
+    CHECK(s.games() == 1);
+    CHECK(s.wins[role("Baron")] == 1);
+    CHECK(s.game_turns[0] == 1); // 4 turns
+    CHECK(s.game_turns_sum == 4);
+
+    // An undone coup eliminates nobody; one left standing counts when its attacker plays again
+    Game h;
+    Player *gen = h.add_player("Gen", "General");
+    Player *c = h.add_player("C", "Judge");
+    Player *d = h.add_player("D", "Merchant");
+    gen->set_coins(12);
+    gen->coup(*c);
+    CHECK(GameStats::snapshot().eliminations() == 2);
+    static_cast<General *>(gen)->undo_coup(*c);
+    d->gather();
+    CHECK(GameStats::snapshot().eliminations() == 2);
+
+    gen->set_coins(7);
+    gen->coup(*c);
+    CHECK(GameStats::snapshot().eliminations() == 2);
+    d->gather();
+    CHECK(GameStats::snapshot().eliminations() == 3);
+}
+
+TEST_CASE("counts of every thread are merged on read") {
+    GameStats::reset();
+    constexpr int THREADS = 4;
+    constexpr int COUNTS = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+        threads.emplace_back([] {
+            for (int i = 0; i < COUNTS; ++i)
+                GameStats::count_action(StatAction::Gather, "Judge", StatOutcome::Ok);
+            GameStats::count_game(5000, "Judge");
+        });
+    for (auto &t : threads)
+        t.join();
+
+    GameStatsSnapshot s = GameStats::snapshot();
+    CHECK(s.actions[size_t(StatAction::Gather)][role("Judge")][0] == THREADS * COUNTS);
+    CHECK(s.game_turns[GameStatsSnapshot::TURN_BUCKETS - 1] == THREADS);
+    GameStats::reset();
+    CHECK(GameStats::snapshot().games() == 0);
+}
+
+TEST_CASE("JSON and Prometheus dumps") {
+    GameStats::reset();
+    GameStats::count_action(StatAction::Tax, "Spy", StatOutcome::Ok);
+    GameStats::count_elimination(3);
+    GameStats::count_game(20, "Spy");
+    GameStatsSnapshot s = GameStats::snapshot();
+
+    std::ostringstream json;
+    s.write_json(json);
+    CHECK(json.str().find("\"tax\":{\"Governor\":{\"ok\":0,\"rejected\":0},\"Spy\":{\"ok\":1,") != std::string::npos);
+    CHECK(json.str().find("\"game_turns\":{\"buckets\":[{\"le\":\"8\",\"count\":0},{\"le\":\"16\",\"count\":0},"
+                          "{\"le\":\"32\",\"count\":1}") != std::string::npos);
+
+    std::ostringstream prom;
+    s.write_prometheus(prom);
+    const std::string text = prom.str();
+    CHECK(text.find("# TYPE coup_actions_total counter\n") != std::string::npos);
+    CHECK(text.find("coup_actions_total{action=\"tax\",role=\"Spy\",outcome=\"ok\"} 1\n") != std::string::npos);
+    CHECK(text.find("coup_elimination_coins_bucket{le=\"2\"} 0\n") != std::string::npos);
+    CHECK(text.find("coup_elimination_coins_bucket{le=\"3\"} 1\n") != std::string::npos);
+    CHECK(text.find("coup_elimination_coins_bucket{le=\"+Inf\"} 1\n") != std::string::npos);
+    CHECK(text.find("coup_game_turns_sum 20\n") != std::string::npos);
+    CHECK(text.find("coup_wins_total{role=\"Spy\"} 1\n") != std::string::npos);
+
+    CHECK_FALSE(GameStats::dump("/nonexistent-dir/stats.json"));
+}
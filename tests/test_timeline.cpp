@@ -0,0 +1,121 @@
+// test_timeline.cpp - Persistent per-turn history of a game
+// Anksilae@gmail.com
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "Game.hpp"
+#include "Timeline.hpp"
+#include "TurnDriver.hpp"
+#include <iostream>
+#include <vector>
+
+using namespace coup;
+
+TEST_CASE("each turn is a new version sharing the unchanged players") {
+    Game g;
+    Player *a = g.add_player("A", "Merchant");
+    g.add_player("B", "Spy");
+    g.add_player("C", "Baron");
+    g.add_player("D", "General");
+
+    Timeline timeline;
+    CHECK(timeline.version_at_turn(0) == Timeline::NO_VERSION);
+    CHECK(timeline.record(g) == 0);
+    a->gather();
+    CHECK(timeline.record(g) == 1);
+    CHECK(timeline.size() == 2);
+
+    CHECK(timeline.at(0).players[0]->coins == 0);
+    CHECK(timeline.at(1).players[0]->coins == 1);
+    CHECK(timeline.at(1).turn == 1);
+    CHECK(timeline.at(1).current == 1);
+    CHECK(timeline.shared_players(0, 1) >= 2); // C and D did not change
+    CHECK(timeline.at(0).players[3] == timeline.at(1).players[3]);
+    CHECK(timeline.at(0).coup_pending_list == timeline.at(1).coup_pending_list);
+}
+
+TEST_CASE("turns map to their newest version") {
+    Game g;
+    Player *a = g.add_player("A", "Merchant");
+    Player *b = g.add_player("B", "Baron");
+    Timeline timeline;
+    timeline.record(g);   // 0: turn 0
+    a->set_coins(4);
+    a->bribe();
+    timeline.record(g);   // 1: still turn 0
+    a->tax();
+    timeline.record(g);   // 2: turn 1 (A's second action ended the turn)
+    b->gather();
+    b->set_coins(3);
+    timeline.record(g);   // 3: turn 2
+
+    CHECK(timeline.first_turn() == 0);
+    CHECK(timeline.last_turn() == 2);
+    CHECK(timeline.version_at_turn(0) == 1);
+    CHECK(timeline.version_at_turn(1) == 2);
+    CHECK(timeline.version_at_turn(2) == 3);
+    CHECK(timeline.version_at_turn(9) == 3);
+    CHECK(timeline.version_at_turn(-1) == Timeline::NO_VERSION);
+
+    GameSnapshot snap;
+    timeline.at(2).materialize(snap);
+    CHECK(snap.turn == 1);
+    CHECK(snap.find("A")->coins == 2);
+    CHECK(snap.current_player()->name == "B");
+    timeline.at(3).materialize(snap);
+    CHECK(snap.find("B")->coins == 3);
+}
+
+TEST_CASE("old versions do not change as the game goes on") {
+    Game g;
+    g.add_player("A", "Governor");
+    g.add_player("B", "Judge");
+    g.add_player("C", "Spy");
+    BotSource a(Bot(BotStrength::Greedy, 1)), b(Bot(BotStrength::Greedy, 2)), c(Bot(BotStrength::Greedy, 3));
+
+    std::cout.setstate(std::ios::badbit);
+    Timeline timeline;
+    std::vector<GameSnapshot> copies;
+    timeline.record(g);
+    copies.emplace_back();
+    GameEngine::capture(g, copies.back());
+    for (int i = 0; i < 200 && !g.is_game_over(); ++i) {
+        GameTask step(g, {&a, &b, &c}, 1);
+        step.resume();
+        timeline.record(g);
+        copies.emplace_back();
+        GameEngine::capture(g, copies.back());
+    }
+    std::cout.clear();
+
+    REQUIRE(timeline.size() == copies.size());
+    GameSnapshot snap;
+    for (size_t v = 0; v < timeline.size(); ++v) {
+        timeline.at(v).materialize(snap);
+        REQUIRE(snap.players.size() == copies[v].players.size());
+        for (size_t s = 0; s < snap.players.size(); ++s) {
+            CHECK(snap.players[s].coins == copies[v].players[s].coins);
+            CHECK(snap.players[s].active == copies[v].players[s].active);
+        }
+        CHECK(snap.current == copies[v].current);
+        CHECK(snap.turn == copies[v].turn);
+    }
+}
+
+TEST_CASE("a reset game starts the timeline over") {
+    Game g;
+    Player *a = g.add_player("A", "Merchant");
+    g.add_player("B", "Baron");
+    Timeline timeline;
+    a->gather();
+    timeline.record(g);
+    CHECK(timeline.first_turn() == 1);
+    CHECK(timeline.version_at_turn(0) == Timeline::NO_VERSION);
+
+    g.reset();
+    g.add_player("X", "Spy");
+    timeline.record(g);
+    CHECK(timeline.size() == 1);
+    CHECK(timeline.first_turn() == 0);
+    CHECK(timeline.at(0).players.size() == 1);
+}
@@ -0,0 +1,217 @@
+// test_tournament.cpp - Ratings and tournaments of bot policies
+// Anksilae@gmail.com
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "Exceptions.hpp"
+#include "Tournament.hpp"
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <vector>
+
+using namespace coup;
+
+namespace {
+
+TournamentConfig two_policies(size_t games, unsigned threads) {
+    TournamentConfig config;
+    config.policies = {PolicySpec::parse("random"), PolicySpec::parse("greedy")};
+    config.games = games;
+    config.threads = threads;
+    return config;
+}
+
+/**
+ * @brief Runs `tournament` and returns its results in delivery order, checking that its
+ * games printed nothing.
+ */
+std::vector<MatchResult> run_quietly(Tournament &tournament) {
+    std::vector<MatchResult> results;
+    std::ostringstream printed;
+    std::streambuf *previous = std::cout.rdbuf(printed.rdbuf());
+    tournament.run([&](const MatchResult &r) { results.push_back(r); });
+    std::cout.rdbuf(previous);
+    CHECK(printed.str() == "");
+    return results;
+}
+
+} // namespace
+
+TEST_CASE("Elo moves ratings toward the result") {
+    EloRatings elo(3);
+    elo.update({0, 1, 2}, {0, 1, 2});
+    CHECK(elo.rating(0) > 1500);
+    CHECK(elo.rating(2) < 1500);
+    CHECK(elo.rating(0) + elo.rating(1) + elo.rating(2) == doctest::Approx(4500));
+    CHECK(elo.comparisons(0) == 2);
+    CHECK(elo.score(0) == 1.0);
+    CHECK(elo.score(1) == 0.5);
+
+    // A tie between equal ratings changes nothing; one competitor's seats never meet
+    EloRatings tied(2);
+    tied.update({0, 1}, {0, 0});
+    CHECK(tied.rating(0) == 1500);
+    tied.update({0, 0}, {0, 1});
+    CHECK(tied.comparisons(0) == 1);
+
+    CHECK_THROWS_AS(elo.update({0, 1}, {0}), InvalidActionException);
+    CHECK_THROWS_AS(elo.update({0, 3}, {0, 1}), InvalidActionException);
+}
+
+TEST_CASE("Elo interval narrows with more games") {
+    EloRatings elo(2);
+    for (int g = 0; g < 10; ++g)
+        elo.update({0, 1}, {g % 3 == 0 ? 1 : 0, g % 3 == 0 ? 0 : 1});
+    const double early = elo.interval(0);
+    for (int g = 0; g < 1000; ++g)
+        elo.update({0, 1}, {g % 3 == 0 ? 1 : 0, g % 3 == 0 ? 0 : 1});
+    CHECK(elo.interval(0) < early / 5);
+    CHECK(elo.rating(0) > elo.rating(1));
+}
+
+TEST_CASE("TrueSkill learns the stronger competitor") {
+    TrueSkillRatings ts(3);
+    const double sigma0 = ts.sigma(0);
+    ts.update({0, 1, 2}, {0, 1, 2});
+    CHECK(ts.mu(0) > 25);
+    CHECK(ts.mu(2) < 25);
+    CHECK(ts.sigma(0) < sigma0);
+
+    for (int g = 0; g < 200; ++g)
+        ts.update({0, 1, 2}, {0, 1, 2});
+    CHECK(ts.conservative(0) > ts.conservative(1));
+    CHECK(ts.conservative(1) > ts.conservative(2));
+    CHECK(ts.sigma(1) < 2.0);
+
+    // Ties carry no update
+    TrueSkillRatings tied(2);
+    tied.update({0, 1}, {0, 0});
+    CHECK(tied.mu(0) == 25);
+
+    // Any number of seats can be rated, more than a game holds included
+    TrueSkillRatings large(12);
+    std::vector<size_t> who(12);
+    std::vector<int> ranks(12);
+    for (size_t s = 0; s < 12; ++s) {
+        who[s] = s;
+        ranks[s] = static_cast<int>(s);
+    }
+    large.update(who, ranks);
+    CHECK(large.mu(0) > 25);
+    CHECK(large.mu(11) < 25);
+}
+
+TEST_CASE("PolicySpec::parse") {
+    PolicySpec greedy = PolicySpec::parse("greedy");
+    CHECK(greedy.name == "greedy");
+    CHECK(greedy.strength == BotStrength::Greedy);
+
+    PolicySpec fast = PolicySpec::parse("fast=search:5");
+    CHECK(fast.name == "fast");
+    CHECK(fast.strength == BotStrength::Search);
+    CHECK(fast.think_budget_ms == 5);
+
+    CHECK_THROWS_AS(PolicySpec::parse("clever"), InvalidActionException);
+    CHECK_THROWS_AS(PolicySpec::parse("greedy:5"), InvalidActionException);
+    CHECK_THROWS_AS(PolicySpec::parse("search:0"), InvalidActionException);
+}
+
+TEST_CASE("tables") {
+    // Multisets of 3 from 3 policies, without the 3 single-policy tables
+    auto rr = Tournament::round_robin_tables(3, 3);
+    CHECK(rr.size() == 10 - 3);
+    std::set<std::vector<size_t>> unique(rr.begin(), rr.end());
+    CHECK(unique.size() == rr.size());
+    CHECK(Tournament::round_robin_tables(2, 2) == std::vector<std::vector<size_t>>{{0, 1}});
+
+    auto swiss = Tournament::swiss_tables({4, 2, 0, 1, 3}, 2);
+    CHECK(swiss == std::vector<std::vector<size_t>>{{4, 2}, {0, 1}, {3, 4}});
+}
+
+TEST_CASE("Tournament rejects bad configurations") {
+    TournamentConfig config = two_policies(10, 1);
+    config.policies.pop_back();
+    CHECK_THROWS_AS(Tournament{config}, InvalidActionException);
+
+    config = two_policies(10, 1);
+    config.policies[1].name = "random";
+    CHECK_THROWS_AS(Tournament{config}, InvalidActionException);
+
+    config = two_policies(10, 1);
+    config.seats = MAX_PLAYERS + 1;
+    CHECK_THROWS_AS(Tournament{config}, InvalidActionException);
+
+    config = two_policies(10, 1);
+    config.rules.coup_cost = 12;
+    CHECK_THROWS_AS(Tournament{config}, InvalidActionException);
+}
+
+TEST_CASE("play_match ranks seats by elimination") {
+    Tournament tournament(two_policies(1, 1));
+    MatchResult r = tournament.play_match({0, 1, 1, 0}, {0, 1, 2, 3}, 42);
+
+    REQUIRE(r.winner >= 0);
+    CHECK(r.seats == 4);
+    CHECK(r.rank[r.winner] == 0);
+    std::set<int> places(r.rank.begin(), r.rank.begin() + 4);
+    CHECK(places == std::set<int>{0, 1, 2, 3});
+    CHECK(r.policy[1] == 1);
+    CHECK(r.role[3] == 3);
+}
+
+TEST_CASE("round-robin results do not depend on the thread count") {
+    Tournament one(two_policies(300, 1));
+    Tournament four(two_policies(300, 4));
+    auto a = run_quietly(one);
+    auto b = run_quietly(four);
+
+    REQUIRE(a.size() == 300);
+    REQUIRE(b.size() == 300);
+    for (size_t g = 0; g < a.size(); ++g) {
+        CHECK(a[g].game == g);
+        CHECK(b[g].game == g);
+        CHECK(a[g].winner == b[g].winner);
+        CHECK(a[g].turns == b[g].turns);
+    }
+    CHECK(one.elo().rating(1) == four.elo().rating(1));
+    CHECK(one.trueskill().mu(0) == four.trueskill().mu(0));
+    CHECK(one.games_played(0) + one.games_played(1) == 300 * 4);
+}
+
+TEST_CASE("every policy plays every role") {
+    Tournament tournament(two_policies(6 * 4 * 3, 2));
+    auto results = run_quietly(tournament);
+    std::set<std::pair<int, int>> seen;
+    for (const auto &r : results)
+        for (size_t s = 0; s < r.seats; ++s)
+            seen.insert({r.policy[s], r.role[s]});
+    CHECK(seen.size() == 2 * 6);
+}
+
+TEST_CASE("greedy outrates random in a Swiss tournament") {
+    TournamentConfig config;
+    config.policies = {PolicySpec::parse("r1=random"), PolicySpec::parse("g1=greedy"),
+                       PolicySpec::parse("r2=random"), PolicySpec::parse("g2=greedy")};
+    config.pairing = Pairing::Swiss;
+    config.swiss_rounds = 4;
+    config.games = 800;
+    config.threads = 3;
+    Tournament tournament(config);
+    auto results = run_quietly(tournament);
+
+    REQUIRE(results.size() == 800);
+    CHECK(results.front().round == 0);
+    CHECK(results.back().round == 3);
+    auto order = tournament.standings();
+    std::set<size_t> top(order.begin(), order.begin() + 2);
+    CHECK(top == std::set<size_t>{1, 3});
+
+    std::ostringstream csv;
+    tournament.write_header(csv);
+    tournament.write_result(csv, results.front());
+    CHECK(csv.str().rfind("game,round,policy0,role0,", 0) == 0);
+    std::ostringstream standings;
+    tournament.write_standings(standings);
+    CHECK(standings.str().find("g1,") != std::string::npos);
+}
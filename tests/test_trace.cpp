@@ -0,0 +1,151 @@
+// test_trace.cpp - Trace spans, their rings and the Chrome trace export
+// Anksilae@gmail.com
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "Game.hpp"
+#include "Player.hpp"
+#include "Trace.hpp"
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace coup;
+
+namespace {
+
+/**
+ * @brief Silences the game log for one test case (doctest reports on std::cout).
+ */
+struct QuietLog {
+    QuietLog() { std::cout.setstate(std::ios::badbit); }
+    ~QuietLog() { std::cout.clear(); }
+};
+
+std::string chrome_json() {
+    std::ostringstream out;
+    Tracer::write_chrome_json(out);
+    return out.str();
+}
+
+size_t occurrences(const std::string &text, const std::string &what) {
+    size_t n = 0;
+    for (size_t at = text.find(what); at != std::string::npos; at = text.find(what, at + 1))
+        ++n;
+    return n;
+}
+
+} // namespace
+
+TEST_CASE("nothing is recorded while tracing is disabled") {
+    QuietLog quiet;
+    Tracer::enable(false);
+    Tracer::clear();
+    Game g;
+    Player *a = g.add_player("A", "Spy");
+    g.add_player("B", "Judge");
+    a->gather();
+    CHECK(Tracer::events() == 0);
+    CHECK(chrome_json().find("\"traceEvents\":[\n]") != std::string::npos);
+}
+
+TEST_CASE("an action records its phases, logging and turn change") {
+    QuietLog quiet;
+    Tracer::clear();
+    Game g;
+    Player *a = g.add_player("A", "Spy");
+    g.add_player("B", "Merchant");
+    Tracer::enable();
+    a->gather();
+    Tracer::enable(false);
+
+    // gather, validate, execute, perform_action, next_turn, on_turn_start
+    CHECK(Tracer::events() == 6);
+    const std::string json = chrome_json();
+    for (const char *name : {"Player::gather", "validate", "execute", "Game::perform_action", "Game::next_turn",
+                             "on_turn_start"})
+        CHECK(json.find(std::string("{\"name\":\"") + name + "\"") != std::string::npos);
+    CHECK(occurrences(json, "\"ph\":\"X\"") == 6);
+
+    // Inner spans end first: the action's own span is written last
+    CHECK(json.rfind("Player::gather") > json.rfind("Game::next_turn"));
+    CHECK(json.rfind("Game::next_turn") > json.rfind("on_turn_start"));
+}
+
+TEST_CASE("rejected actions still close their spans") {
+    QuietLog quiet;
+    Tracer::clear();
+    Game g;
+    g.add_player("A", "Spy");
+    Player *b = g.add_player("B", "Judge");
+    Tracer::enable();
+    CHECK_THROWS(b->tax());
+    Tracer::enable(false);
+    CHECK(Tracer::events() == 2); // Player::tax and validate
+}
+
+TEST_CASE("a ring keeps its newest events") {
+    Tracer::clear();
+    Tracer::enable();
+    static const char *const OLD = "old";
+    static const char *const NEW = "new";
+    for (size_t i = 0; i < 10; ++i)
+        Tracer::record(OLD, i, i + 1);
+    for (size_t i = 0; i < Tracer::RING_EVENTS; ++i)
+        Tracer::record(NEW, 100 + i, 101 + i);
+    Tracer::enable(false);
+    CHECK(Tracer::events() == Tracer::RING_EVENTS);
+    const std::string json = chrome_json();
+    CHECK(json.find("\"name\":\"old\"") == std::string::npos);
+    CHECK(json.find("\"ts\":0.000") != std::string::npos); // times start at the oldest kept event
+}
+
+TEST_CASE("clear() keeps the events recorded after it") {
+    Tracer::clear();
+    static const char *const BEFORE = "before";
+    static const char *const AFTER = "after";
+    for (size_t i = 0; i < 5; ++i)
+        Tracer::record(BEFORE, i, i + 1);
+    Tracer::clear();
+    CHECK(Tracer::events() == 0);
+    Tracer::record(AFTER, 10, 11);
+    Tracer::record(AFTER, 11, 12);
+    CHECK(Tracer::events() == 2);
+    const std::string json = chrome_json();
+    CHECK(json.find("\"name\":\"before\"") == std::string::npos);
+    CHECK(occurrences(json, "\"name\":\"after\"") == 2);
+}
+
+TEST_CASE("the export leaves the stream's format as it was") {
+    std::ostringstream out;
+    out.precision(8);
+    Tracer::write_chrome_json(out);
+    CHECK(out.precision() == 8);
+    CHECK((out.flags() & std::ios::fixed) == 0);
+}
+
+TEST_CASE("every thread writes its own ring") {
+    Tracer::clear();
+    Tracer::enable();
+    constexpr int THREADS = 3;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+        threads.emplace_back([] {
+            for (int i = 0; i < 100; ++i) {
+                COUP_TRACE_SPAN("work");
+            }
+        });
+    for (auto &t : threads)
+        t.join();
+    Tracer::enable(false);
+
+    CHECK(Tracer::events() == THREADS * 100);
+    const std::string json = chrome_json();
+    CHECK(occurrences(json, "\"name\":\"work\"") == THREADS * 100);
+    // The main thread's ring came first; each worker has its own tid
+    for (int tid = 2; tid <= THREADS + 1; ++tid)
+        CHECK(json.find("\"tid\":" + std::to_string(tid) + ",") != std::string::npos);
+    CHECK(Tracer::ticks_per_us() > 0);
+    CHECK_FALSE(Tracer::dump("/nonexistent-dir/trace.json"));
+}
@@ -0,0 +1,137 @@
+// cli_main.cpp - Headless front-end: games played from scripts or stdin
+// Anksilae@gmail.com
+//
+// Usage: ./build/coup_cli [options] [script ...]
+//
+//   (no scripts)       Read commands from stdin and answer each one with "ok", the output
+//                      of a query, or "error: <reason>"; rejected commands are skipped
+//   script ...         Run each script as its own game, back-to-back in one process; the
+//                      first rejected command fails the script
+//   --list <file>      Also run the scripts listed in <file>, one path per line
+//   --repeat <n>       Run the scripts n times (default 1), e.g. for benchmarking
+//   --log              Show the game log on stdout (silenced by default)
+//   --rule <r>=<v>     Play with a RulesConfig value changed (repeatable)
+//
+// The commands are documented in ScriptRunner.hpp. Scripts are read once up front; a
+// failed script is reported on stderr as "file:line: reason", and the run ends with a
+// summary there. The exit status is 1 if any script failed. Example:
+//
+//   printf 'add a Governor\nadd b Spy\ntax a\nshow\n' | ./build/coup_cli
+
+#include "Exceptions.hpp"
+#include "ScriptRunner.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace coup;
+
+struct Options {
+    std::vector<std::string> scripts;
+    size_t repeat = 1;
+    bool log = false;
+    RulesConfig rules;
+};
+
+struct Script {
+    std::string path;
+    std::string text;
+};
+
+[[noreturn]] void usage(const std::string &error) {
+    std::fprintf(stderr, "coup_cli: %s\nUsage: coup_cli [--list file] [--repeat n] [--log] [--rule name=value] "
+                         "[script ...]\n",
+                 error.c_str());
+    std::exit(2);
+}
+
+Options parse_options(int argc, char **argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc)
+                usage(arg + " needs a value");
+            return argv[++i];
+        };
+        try {
+            if (arg == "--repeat") opt.repeat = std::strtoul(next().c_str(), nullptr, 10);
+            else if (arg == "--log") opt.log = true;
+            else if (arg == "--list") {
+                std::string path = next();
+                std::ifstream list(path);
+                if (!list)
+                    usage("cannot read " + path);
+                for (std::string line; std::getline(list, line);)
+                    if (!line.empty())
+                        opt.scripts.push_back(line);
+            } else if (arg == "--rule") {
+                std::string rule = next();
+                size_t eq = rule.find('=');
+                if (eq == std::string::npos)
+                    usage("--rule takes name=value");
+                opt.rules.set(rule.substr(0, eq), std::atoi(rule.c_str() + eq + 1));
+            } else if (arg.rfind("--", 0) == 0) usage("unknown option " + arg);
+            else opt.scripts.push_back(arg);
+        } catch (const InvalidActionException &e) {
+            usage(e.what());
+        }
+    }
+    return opt;
+}
+
+std::vector<Script> read_scripts(const std::vector<std::string> &paths) {
+    std::vector<Script> scripts;
+    scripts.reserve(paths.size());
+    for (const auto &path : paths) {
+        std::ifstream in(path);
+        if (!in)
+            usage("cannot read " + path);
+        std::ostringstream text;
+        text << in.rdbuf();
+        scripts.push_back({path, text.str()});
+    }
+    return scripts;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opt = parse_options(argc, argv);
+    const std::vector<Script> scripts = read_scripts(opt.scripts);
+
+    try {
+        ScriptRunner runner(opt.rules, opt.log ? GameLog::Printed : GameLog::Quiet);
+        if (scripts.empty()) {
+            runner.set_reply(&std::cout);
+            return runner.run(std::cin, false).ok() ? 0 : 1;
+        }
+
+        size_t failed = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t round = 0; round < opt.repeat; ++round) {
+            for (const Script &script : scripts) {
+                ScriptResult result = runner.run_script(script.text);
+                if (!result.ok()) {
+                    ++failed;
+                    std::fprintf(stderr, "%s:%zu: %s\n", script.path.c_str(), result.error_line,
+                                 result.error.c_str());
+                }
+            }
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const size_t runs = scripts.size() * opt.repeat;
+        std::fprintf(stderr, "coup_cli: %zu scripts (%zu failed) in %.3fs (%.0f scripts/s)\n", runs, failed,
+                     seconds, seconds > 0 ? runs / seconds : 0.0);
+        return failed ? 1 : 0;
+    } catch (const CoupException &e) {
+        usage(e.what());
+    }
+}
@@ -0,0 +1,117 @@
+#!/usr/bin/env bash
+# pgo.sh - Profile-guided build of the tools, trained on headless self-play
+# Anksilae@gmail.com
+#
+# Usage: make pgo   (or tools/pgo.sh)
+#
+#   1. Builds the release tools as they are (the baseline).
+#   2. Rebuilds them with -fprofile-generate and plays the training workload: bot
+#      tournaments and scripted games through coup_cli.
+#   3. Rebuilds them with -fprofile-use from that profile.
+#   4. With BOLT=1 and llvm-bolt installed, also lays out the profiled tournament binary
+#      with BOLT, trained on the same workload.
+#
+# The baseline, PGO (and BOLT) binaries are then measured in turns and compared in
+# build/pgo/report.txt. The tools left in build/ are the PGO ones; a plain `make tools`
+# rebuilds them without the profile.
+#
+# Environment: PGO_GAMES (games per measurement, default 20000), PGO_RUNS (measurements
+# per binary, the best is kept, default 3), BOLT=1, MAKE.
+
+set -euo pipefail
+cd "$(dirname "$0")/.."
+
+MAKE=${MAKE:-make}
+GAMES=${PGO_GAMES:-20000}
+RUNS=${PGO_RUNS:-3}
+OUT=build/pgo
+PROFILE=$PWD/$OUT/profile
+DEMO=scripts/demo.coup
+
+TOOLS="build/tournament build/coup_cli"
+GENERATE="-fprofile-generate -fprofile-update=prefer-atomic -fprofile-dir=$PROFILE"
+USE="-fprofile-use -fprofile-partial-training -fprofile-dir=$PROFILE -Wno-missing-profile"
+if [[ "${BOLT:-0}" == 1 ]]; then
+    USE="$USE -Wl,--emit-relocs" # BOLT needs the relocations to move code
+fi
+
+log() { echo "pgo: $*" >&2; }
+
+# Plays the training workload with the tournament and coup_cli binaries given
+train() {
+    local tournament=$1 cli=$2
+    "$tournament" random greedy --games 20000 --seats 4 --threads 1 --seed 11 >/dev/null 2>&1
+    "$tournament" r=random g=greedy g2=greedy --games 10000 --seats 3 --threads 1 --seed 12 >/dev/null 2>&1
+    "$tournament" random greedy s=search:1 --games 300 --seats 3 --threads 1 --seed 13 >/dev/null 2>&1
+    "$cli" "$DEMO" --repeat 20000 >/dev/null 2>&1
+}
+
+# games/s of one measured tournament run
+games_rate() {
+    "$1" random greedy --games "$GAMES" --threads 1 --seed 7 2>&1 >/dev/null | sed -n 's/.*(\([0-9]*\) games\/s.*/\1/p'
+}
+
+# scripts/s of one measured coup_cli run
+scripts_rate() {
+    "$1" "$DEMO" --repeat "$GAMES" 2>&1 >/dev/null | sed -n 's/.*(\([0-9]*\) scripts\/s.*/\1/p'
+}
+
+mkdir -p "$OUT"
+
+log "building the baseline"
+$MAKE $TOOLS PGO_FLAGS=
+cp build/tournament "$OUT/tournament.base"
+cp build/coup_cli "$OUT/coup_cli.base"
+
+log "building the instrumented tools"
+rm -rf "$PROFILE"
+$MAKE $TOOLS PGO_FLAGS="$GENERATE"
+log "training"
+train build/tournament build/coup_cli
+
+log "rebuilding with the profile"
+$MAKE tools PGO_FLAGS="$USE"
+cp build/tournament "$OUT/tournament.pgo"
+cp build/coup_cli "$OUT/coup_cli.pgo"
+
+builds="base pgo"
+if [[ "${BOLT:-0}" == 1 ]]; then
+    if command -v llvm-bolt >/dev/null; then
+        log "laying out the tournament binary with BOLT"
+        rm -f "$OUT/bolt.fdata"
+        llvm-bolt "$OUT/tournament.pgo" -instrument -instrumentation-file="$OUT/bolt.fdata" \
+            -o "$OUT/tournament.inst"
+        train "$OUT/tournament.inst" "$OUT/coup_cli.pgo"
+        llvm-bolt "$OUT/tournament.pgo" -data="$OUT/bolt.fdata" -o "$OUT/tournament.bolt" \
+            -reorder-blocks=ext-tsp -reorder-functions=hfsort -split-functions -split-all-cold -icf=1
+        cp "$OUT/coup_cli.pgo" "$OUT/coup_cli.bolt" # only the tournament binary is laid out
+        builds="$builds bolt"
+    else
+        log "llvm-bolt not found: skipping BOLT"
+    fi
+fi
+
+# The builds take turns, so a slower phase of the machine does not favour one of them
+log "measuring ($RUNS runs of $GAMES games / scripts each)"
+declare -A games scripts
+for _ in $(seq "$RUNS"); do
+    for b in $builds; do
+        g=$(games_rate "$OUT/tournament.$b")
+        s=$(scripts_rate "$OUT/coup_cli.$b")
+        (( g > ${games[$b]:-0} )) && games[$b]=$g
+        (( s > ${scripts[$b]:-0} )) && scripts[$b]=$s
+    done
+done
+
+{
+    echo "Profile-guided build: best of $RUNS runs, $GAMES games (tournament random greedy, 1 thread)"
+    echo "and $GAMES replays of $DEMO (coup_cli)"
+    echo
+    printf "%-8s %12s %8s %12s %8s\n" build games/s change scripts/s change
+    for b in $builds; do
+        printf "%-8s %12s %8s %12s %8s\n" "$b" "${games[$b]}" \
+            "$(awk -v a="${games[base]}" -v b="${games[$b]}" 'BEGIN { printf "%+.1f%%", (b - a) * 100 / a }')" \
+            "${scripts[$b]}" \
+            "$(awk -v a="${scripts[base]}" -v b="${scripts[$b]}" 'BEGIN { printf "%+.1f%%", (b - a) * 100 / a }')"
+    done
+} | tee "$OUT/report.txt"
@@ -0,0 +1,328 @@
+// sweep_main.cpp - Rule-balance sweeps over RulesConfig values
+// Anksilae@gmail.com
+//
+// Usage: ./build/sweep [options] <rule>=<lo>[:<hi>[:<step>]] ...
+//
+//   --games <n>        Games per configuration (default 6000)
+//   --random <n>       Sample n configurations from the ranges instead of the full grid
+//   --seed <n>         Seed of the games and of --random (default 1)
+//   --threads <n>      Worker threads (default: all cores)
+//   --bots <strength>  Play Random or Greedy bots through Game instead of the batched policy
+//   --out <file>       Write the table there instead of stdout
+//
+// Every configuration plays the same seeds, with the six roles rotated over the seats, and
+// gets one CSV row: the swept values, games played, each role's win rate, the share of
+// undecided games and the average game length. Example:
+//
+//   ./build/sweep coup_cost=6:8 governor_tax=2:4 --games 60000
+
+#include "BatchSim.hpp"
+#include "Bot.hpp"
+#include "Exceptions.hpp"
+#include "Game.hpp"
+#include "GameArena.hpp"
+#include "RulesConfig.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace coup;
+
+const std::vector<std::string> ROLES = {"Governor", "Spy", "Judge", "Baron", "General", "Merchant"};
+constexpr size_t CHUNK_GAMES = 6 * 500; ///< Games per work item (a multiple of the six rotations)
+
+/**
+ * @brief One swept rule and the values it takes.
+ */
+struct Dimension {
+    std::string rule;
+    std::vector<int> values;
+};
+
+/**
+ * @brief Totals of the games played for one configuration.
+ */
+struct Tally {
+    uint64_t games = 0;
+    uint64_t undecided = 0;
+    uint64_t turns = 0;
+    std::array<uint64_t, 6> wins{}; ///< By role, in ROLES order
+
+    void add(const Tally &other) {
+        games += other.games;
+        undecided += other.undecided;
+        turns += other.turns;
+        for (size_t r = 0; r < wins.size(); ++r)
+            wins[r] += other.wins[r];
+    }
+};
+
+struct Options {
+    size_t games = 6000;
+    size_t random_points = 0;
+    uint32_t seed = 1;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    bool use_bots = false;
+    BotStrength strength = BotStrength::Random;
+    std::string out_path;
+    std::vector<Dimension> dimensions;
+};
+
+[[noreturn]] void usage(const std::string &error) {
+    std::fprintf(stderr, "sweep: %s\nUsage: sweep [--games n] [--random n] [--seed n] [--threads n] "
+                         "[--bots random|greedy] [--out file] <rule>=<lo>[:<hi>[:<step>]] ...\nRules:",
+                 error.c_str());
+    for (const auto &name : RulesConfig::fields())
+        std::fprintf(stderr, " %s", name.c_str());
+    std::fprintf(stderr, "\n");
+    std::exit(2);
+}
+
+/**
+ * @brief Parses "rule=lo[:hi[:step]]".
+ */
+Dimension parse_dimension(const std::string &arg) {
+    size_t eq = arg.find('=');
+    if (eq == std::string::npos)
+        usage("expected <rule>=<range>, got '" + arg + "'");
+
+    Dimension dim;
+    dim.rule = arg.substr(0, eq);
+    try {
+        RulesConfig().get(dim.rule);
+    } catch (const InvalidActionException &) {
+        usage("unknown rule '" + dim.rule + "'");
+    }
+
+    std::string range = arg.substr(eq + 1);
+    std::vector<int> parts;
+    for (size_t start = 0;;) {
+        size_t colon = range.find(':', start);
+        std::string part = range.substr(start, colon == std::string::npos ? std::string::npos : colon - start);
+        char *end = nullptr;
+        long value = std::strtol(part.c_str(), &end, 10);
+        if (part.empty() || *end != '\0')
+            usage("bad range '" + range + "'");
+        parts.push_back(static_cast<int>(value));
+        if (colon == std::string::npos)
+            break;
+        start = colon + 1;
+    }
+    if (parts.size() == 1)
+        parts.push_back(parts[0]);
+    if (parts.size() == 2)
+        parts.push_back(1);
+    if (parts.size() > 3 || parts[2] <= 0 || parts[1] < parts[0])
+        usage("bad range '" + range + "'");
+
+    for (int v = parts[0]; v <= parts[1]; v += parts[2])
+        dim.values.push_back(v);
+    return dim;
+}
+
+Options parse_options(int argc, char **argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc)
+                usage(arg + " needs a value");
+            return argv[++i];
+        };
+        if (arg == "--games") opt.games = std::strtoul(next().c_str(), nullptr, 10);
+        else if (arg == "--random") opt.random_points = std::strtoul(next().c_str(), nullptr, 10);
+        else if (arg == "--seed") opt.seed = static_cast<uint32_t>(std::strtoul(next().c_str(), nullptr, 10));
+        else if (arg == "--threads") opt.threads = std::max(1ul, std::strtoul(next().c_str(), nullptr, 10));
+        else if (arg == "--out") opt.out_path = next();
+        else if (arg == "--bots") {
+            std::string s = next();
+            if (s == "random") opt.strength = BotStrength::Random;
+            else if (s == "greedy") opt.strength = BotStrength::Greedy;
+            else usage("--bots takes random or greedy");
+            opt.use_bots = true;
+        } else if (arg.rfind("--", 0) == 0) usage("unknown option " + arg);
+        else opt.dimensions.push_back(parse_dimension(arg));
+    }
+    if (opt.games == 0)
+        usage("--games must be positive");
+    return opt;
+}
+
+/**
+ * @brief The configurations to play: the full grid, or random_points samples of it.
+ */
+std::vector<RulesConfig> make_points(const Options &opt) {
+    std::vector<RulesConfig> points;
+    if (opt.random_points > 0) {
+        std::mt19937 rng(opt.seed);
+        for (size_t n = 0; n < opt.random_points; ++n) {
+            RulesConfig rules;
+            for (const auto &dim : opt.dimensions)
+                rules.set(dim.rule, dim.values[std::uniform_int_distribution<size_t>(0, dim.values.size() - 1)(rng)]);
+            points.push_back(rules);
+        }
+        return points;
+    }
+
+    std::vector<size_t> index(opt.dimensions.size(), 0);
+    while (true) {
+        RulesConfig rules;
+        for (size_t d = 0; d < opt.dimensions.size(); ++d)
+            rules.set(opt.dimensions[d].rule, opt.dimensions[d].values[index[d]]);
+        points.push_back(rules);
+
+        size_t d = 0;
+        while (d < index.size() && ++index[d] == opt.dimensions[d].values.size())
+            index[d++] = 0;
+        if (d == index.size())
+            return points;
+    }
+}
+
+/**
+ * @brief Plays `count` batched-policy games from `first_seed`, rotating the roles over the seats.
+ */
+Tally play_batched(const RulesConfig &rules, uint32_t first_seed, size_t count) {
+    Tally tally;
+    for (size_t r = 0; r < ROLES.size(); ++r) {
+        std::vector<std::string> seats;
+        for (size_t s = 0; s < ROLES.size(); ++s)
+            seats.push_back(ROLES[(s + r) % ROLES.size()]);
+        const size_t games = count / ROLES.size() + (r < count % ROLES.size() ? 1 : 0);
+
+        BatchSim sim(seats, BatchPolicy(), 256, rules);
+        for (const auto &o : sim.run(first_seed + static_cast<uint32_t>(r * count), games)) {
+            ++tally.games;
+            tally.turns += o.turns;
+            if (o.winner < 0)
+                ++tally.undecided;
+            else
+                ++tally.wins[(o.winner + r) % ROLES.size()];
+        }
+    }
+    return tally;
+}
+
+/**
+ * @brief Plays `count` games of six bots through Game, rotating the roles over the seats.
+ */
+Tally play_bots(const RulesConfig &rules, BotStrength strength, uint32_t first_seed, size_t count) {
+    const int max_turns = 2000;
+    Tally tally;
+    for (size_t g = 0; g < count; ++g) {
+        const uint32_t seed = first_seed + static_cast<uint32_t>(g);
+        const size_t rotation = g % ROLES.size();
+        Game game(GameArena::this_thread(), rules, GameLog::Quiet);
+        std::vector<Bot> bots;
+        for (size_t s = 0; s < ROLES.size(); ++s) {
+            game.add_player("P" + std::to_string(s), ROLES[(s + rotation) % ROLES.size()]);
+            bots.emplace_back(strength, seed * 6 + static_cast<unsigned>(s));
+        }
+
+        int turns = 0;
+        try {
+            while (!game.is_game_over() && turns < max_turns) {
+                const int seat = game.get_current_turn_index();
+                bots[seat].play_turn(game, game.turn());
+                ++turns;
+            }
+        } catch (const CoupException &) {
+            // No legal move under these rules: counted as undecided
+        }
+
+        ++tally.games;
+        tally.turns += turns;
+        if (game.is_game_over())
+            ++tally.wins[(SeatFlags::first(game.flags().active) + rotation) % ROLES.size()];
+        else
+            ++tally.undecided;
+    }
+    return tally;
+}
+
+void write_table(std::ostream &out, const Options &opt, const std::vector<RulesConfig> &points,
+                 const std::vector<Tally> &tallies) {
+    for (const auto &dim : opt.dimensions)
+        out << dim.rule << ',';
+    out << "games";
+    for (const auto &role : ROLES)
+        out << ',' << role;
+    out << ",undecided,avg_turns\n";
+
+    for (size_t p = 0; p < points.size(); ++p) {
+        const Tally &t = tallies[p];
+        for (const auto &dim : opt.dimensions)
+            out << points[p].get(dim.rule) << ',';
+        out << t.games;
+        if (t.games == 0) {
+            out << ",invalid rules\n";
+            continue;
+        }
+        const double n = static_cast<double>(t.games);
+        for (uint64_t w : t.wins)
+            out << ',' << w / n;
+        out << ',' << t.undecided / n << ',' << t.turns / n << '\n';
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const Options opt = parse_options(argc, argv);
+    const std::vector<RulesConfig> points = make_points(opt);
+
+    // Work items are (point, chunk of games); every point plays the same seeds
+    const size_t chunks = (opt.games + CHUNK_GAMES - 1) / CHUNK_GAMES;
+    std::vector<Tally> tallies(points.size());
+    std::vector<bool> valid(points.size(), true);
+    for (size_t p = 0; p < points.size(); ++p) {
+        try {
+            points[p].validate();
+        } catch (const InvalidActionException &e) {
+            valid[p] = false;
+            std::fprintf(stderr, "sweep: skipping configuration %zu: %s\n", p, e.what());
+        }
+    }
+
+    std::atomic<size_t> next_item{0};
+    std::mutex merge;
+    auto worker = [&] {
+        for (size_t item; (item = next_item.fetch_add(1)) < points.size() * chunks;) {
+            const size_t p = item / chunks;
+            const size_t chunk = item % chunks;
+            if (!valid[p])
+                continue;
+            const size_t count = std::min(CHUNK_GAMES, opt.games - chunk * CHUNK_GAMES);
+            const uint32_t first_seed = opt.seed + static_cast<uint32_t>(chunk * CHUNK_GAMES * 6);
+            Tally t = opt.use_bots ? play_bots(points[p], opt.strength, first_seed, count)
+                                   : play_batched(points[p], first_seed, count);
+            std::lock_guard<std::mutex> lock(merge);
+            tallies[p].add(t);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < opt.threads; ++t)
+        threads.emplace_back(worker);
+    for (auto &t : threads)
+        t.join();
+
+    if (opt.out_path.empty()) {
+        write_table(std::cout, opt, points, tallies);
+    } else {
+        std::ofstream out(opt.out_path);
+        write_table(out, opt, points, tallies);
+    }
+    return 0;
+}
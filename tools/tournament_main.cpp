@@ -0,0 +1,129 @@
+// tournament_main.cpp - Rated tournaments of bot policies
+// Anksilae@gmail.com
+//
+// Usage: ./build/tournament [options] <policy> <policy> ...
+//
+//   --games <n>        Games in the tournament (default 6000)
+//   --seats <n>        Players per game (default 4)
+//   --swiss <rounds>   Swiss rounds instead of a round-robin
+//   --seed <n>         Seed of the games (default 1)
+//   --threads <n>      Worker threads (default: all cores)
+//   --max-turns <n>    Turns after which a game is stopped undecided (default 2000)
+//   --out <file>       Stream one CSV row per game there, in game order
+//   --rule <r>=<v>     Play with a RulesConfig value changed (repeatable)
+//   --stats <file>     Write the game statistics there at the end (Prometheus text for
+//                      .prom / .txt, JSON otherwise)
+//   --trace <file>     Trace the actions and write the spans there as Chrome trace JSON
+//
+// A policy is "[name=]random", "[name=]greedy" or "[name=]search[:ms]". The standings
+// (games, wins, Elo with its 95% interval, TrueSkill mu / sigma / mu - 3 sigma) are
+// written to stdout at the end, best first. Example:
+//
+//   ./build/tournament random greedy fast=search:1 --games 100000 --out games.csv
+
+#include "Exceptions.hpp"
+#include "GameStats.hpp"
+#include "Trace.hpp"
+#include "Tournament.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+using namespace coup;
+
+struct Options {
+    TournamentConfig config;
+    std::string out_path;
+    std::string stats_path;
+    std::string trace_path;
+};
+
+[[noreturn]] void usage(const std::string &error) {
+    std::fprintf(stderr, "tournament: %s\nUsage: tournament [--games n] [--seats n] [--swiss rounds] [--seed n] "
+                         "[--threads n] [--max-turns n] [--out file] [--rule name=value] [--stats file] [--trace file] "
+                         "[name=]random|greedy|search[:ms] ...\n",
+                 error.c_str());
+    std::exit(2);
+}
+
+Options parse_options(int argc, char **argv) {
+    Options opt;
+    opt.config.threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc)
+                usage(arg + " needs a value");
+            return argv[++i];
+        };
+        try {
+            if (arg == "--games") opt.config.games = std::strtoul(next().c_str(), nullptr, 10);
+            else if (arg == "--seats") opt.config.seats = std::strtoul(next().c_str(), nullptr, 10);
+            else if (arg == "--seed") opt.config.seed = static_cast<uint32_t>(std::strtoul(next().c_str(), nullptr, 10));
+            else if (arg == "--threads") opt.config.threads = static_cast<unsigned>(std::strtoul(next().c_str(), nullptr, 10));
+            else if (arg == "--max-turns") opt.config.max_turns = std::atoi(next().c_str());
+            else if (arg == "--out") opt.out_path = next();
+            else if (arg == "--stats") opt.stats_path = next();
+            else if (arg == "--trace") opt.trace_path = next();
+            else if (arg == "--swiss") {
+                opt.config.pairing = Pairing::Swiss;
+                opt.config.swiss_rounds = std::strtoul(next().c_str(), nullptr, 10);
+            } else if (arg == "--rule") {
+                std::string rule = next();
+                size_t eq = rule.find('=');
+                if (eq == std::string::npos)
+                    usage("--rule takes name=value");
+                opt.config.rules.set(rule.substr(0, eq), std::atoi(rule.c_str() + eq + 1));
+            } else if (arg.rfind("--", 0) == 0) usage("unknown option " + arg);
+            else opt.config.policies.push_back(PolicySpec::parse(arg));
+        } catch (const InvalidActionException &e) {
+            usage(e.what());
+        }
+    }
+    return opt;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opt = parse_options(argc, argv);
+    std::ofstream out;
+    if (!opt.out_path.empty()) {
+        out.open(opt.out_path);
+        if (!out)
+            usage("cannot write " + opt.out_path);
+    }
+
+    try {
+        Tournament tournament(opt.config);
+        if (out.is_open())
+            tournament.write_header(out);
+
+        Tracer::enable(!opt.trace_path.empty());
+
+        const auto start = std::chrono::steady_clock::now();
+        tournament.run([&](const MatchResult &result) {
+            if (out.is_open())
+                tournament.write_result(out, result);
+        });
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::fprintf(stderr, "tournament: %zu games in %.2fs (%.0f games/s, %u threads)\n", opt.config.games,
+                     seconds, seconds > 0 ? opt.config.games / seconds : 0.0, tournament.config().threads);
+        tournament.write_standings(std::cout);
+        if (!opt.stats_path.empty() && !GameStats::dump(opt.stats_path))
+            usage("cannot write " + opt.stats_path);
+        if (!opt.trace_path.empty() && !Tracer::dump(opt.trace_path))
+            usage("cannot write " + opt.trace_path);
+    } catch (const CoupException &e) {
+        usage(e.what());
+    }
+    return 0;
+}